@@ -165,6 +165,7 @@ FARPROC dlsym(void *library, const char *function_name)
 #endif
 
 extern "C" void R__SetZipMode(int);
+extern "C" int R__SetZSTDChecksum(int);
 
 static DestroyInterpreter_t *gDestroyInterpreter = nullptr;
 static void *gInterpreterLib = nullptr;
@@ -1961,6 +1962,7 @@ void TROOT::InitSystem()
 
       Int_t zipmode = gEnv->GetValue("Root.CompressionAlgorithm", oldzipmode);
       if (zipmode != 0) R__SetZipMode(zipmode);
+      R__SetZSTDChecksum(gEnv->GetValue("Root.ZSTDChecksum", 0));
 
       const char *sdeb;
       if ((sdeb = gSystem->Getenv("ROOTDEBUG")))
@@ -17,6 +17,7 @@ extern "C" {
 #endif
 void R__zipZSTD(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep);
 void R__unzipZSTD(int *srcsize, unsigned char *src, int *tgtsize, unsigned char *tgt, int *irep);
+int R__SetZSTDChecksum(int enable);
 #ifdef __cplusplus
 }
 #endif
@@ -14,6 +14,7 @@
 
 #include "zdict.h"
 #include <zstd.h>
+#include <atomic>
 #include <memory>
 
 #include <iostream>
@@ -22,6 +23,19 @@ static const int kHeaderSize = 9;
 
 static const size_t errorCodeSmallBuffer = (size_t)-70;
 
+static std::atomic<int> gZSTDChecksum{0};
+
+/* Enable (or disable) a content checksum in the ZSTD frames written from now on,
+ * at the cost of 4 bytes and the hashing per frame. ZSTD_decompressDCtx verifies
+ * it on read, so corrupted records are reported instead of returning wrong data.
+ * Requires ZSTD 1.4.0 or newer; older versions write frames without checksum.
+ * Returns the previous setting.
+ */
+int R__SetZSTDChecksum(int enable)
+{
+    return gZSTDChecksum.exchange(enable != 0);
+}
+
 void R__zipZSTD(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep)
 {
     using Ctx_ptr = std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)>;
@@ -29,10 +43,29 @@ void R__zipZSTD(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, i
 
     *irep = 0;
 
-    size_t retval = ZSTD_compressCCtx(fCtx.get(),
-                                        &tgt[kHeaderSize], static_cast<size_t>(*tgtsize - kHeaderSize),
-                                        src, static_cast<size_t>(*srcsize),
-                                        2*cxlevel);
+    size_t retval;
+#if ZSTD_VERSION_NUMBER >= 10400
+    if (gZSTDChecksum) {
+        // ZSTD_CCtx_setParameter and ZSTD_compress2 are only stable since ZSTD 1.4.0.
+        size_t status = ZSTD_CCtx_setParameter(fCtx.get(), ZSTD_c_compressionLevel, 2*cxlevel);
+        if (!ZSTD_isError(status))
+            status = ZSTD_CCtx_setParameter(fCtx.get(), ZSTD_c_checksumFlag, 1);
+        if (R__unlikely(ZSTD_isError(status))) {
+            std::cerr << "Error in zip ZSTD. Type = " << ZSTD_getErrorName(status) <<
+            " . Code = " << status << std::endl;
+            return;
+        }
+        retval = ZSTD_compress2(fCtx.get(),
+                                &tgt[kHeaderSize], static_cast<size_t>(*tgtsize - kHeaderSize),
+                                src, static_cast<size_t>(*srcsize));
+    } else
+#endif
+    {
+        retval = ZSTD_compressCCtx(fCtx.get(),
+                                   &tgt[kHeaderSize], static_cast<size_t>(*tgtsize - kHeaderSize),
+                                   src, static_cast<size_t>(*srcsize),
+                                   2*cxlevel);
+    }
 
     if (R__unlikely(ZSTD_isError(retval))) {
         if (R__unlikely(retval != errorCodeSmallBuffer)) {
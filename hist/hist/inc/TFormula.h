@@ -104,6 +104,9 @@ private:
    std::string       fGradGenerationInput; //! input query to clad to generate a gradient
    CallFuncSignature fFuncPtr = nullptr; //!  function pointer, owned by the JIT.
    CallFuncSignature fGradFuncPtr = nullptr; //!  function pointer, owned by the JIT.
+   std::string       fClingExpression;    //! C++ expression of the formula, used to generate the batch evaluator
+   std::string       fBatchGenerationInput; //! input passed to Cling to generate the batch evaluator
+   CallFuncSignature fBatchFuncPtr = nullptr; //!  function pointer of the batch evaluator, owned by the JIT.
    void *   fLambdaPtr = nullptr;            //!  pointer to the lambda function
    static bool       fIsCladRuntimeIncluded;
 
@@ -129,6 +132,13 @@ private:
    bool HasGradientGenerationFailed() const {
       return !fGradMethod && !fGradGenerationInput.empty();
    }
+   std::string GetBatchFuncName() const {
+      assert(fClingName.Length() && "TFormula is not initialized yet!");
+      return std::string(fClingName.Data()) + "_batch" + std::to_string(fNdim);
+   }
+   bool HasBatchGenerationFailed() const {
+      return !fBatchFuncPtr && !fBatchGenerationInput.empty();
+   }
 
 protected:
 
@@ -208,6 +218,16 @@ public:
 
    void GradientPar(const Double_t *x, Double_t *result);
 
+   /// \returns true if the gradient with respect to the parameters has been
+   /// generated (see GenerateGradientPar) and GradientPar can be called.
+   bool HasGeneratedGradient() const { return fGradFuncPtr != nullptr; }
+
+   /// Generate a function evaluating the formula on a whole batch of points.
+   /// \returns true if the batch evaluator was generated and is used by EvalParBatch.
+   bool GenerateBatchEvaluator();
+
+   void EvalParBatch(Long64_t n, const Double_t *x, Double_t *result, const Double_t *params = nullptr) const;
+
    // template <class T>
    // T Eval(T x, T y = 0, T z = 0, T t = 0) const;
    template <class T>
@@ -53,6 +53,10 @@ class TCollection;
 class TVirtualFFT;
 class TVirtualHistPainter;
 
+namespace ROOT {
+class TH1ConcurrentFiller;
+}
+
 
 class TH1 : public TNamed, public TAttLine, public TAttFill, public TAttMarker {
 
@@ -82,6 +86,7 @@ public:
    };
 
    friend class TH1Merger;
+   friend class ROOT::TH1ConcurrentFiller;
 
 protected:
     Int_t         fNcells;          ///< number of bins(1D), cells (2D) +U/Overflows
@@ -114,6 +119,7 @@ protected:
     static Bool_t fgAddDirectory;   ///<!flag to add histograms to the directory
     static Bool_t fgStatOverflows;  ///<!flag to use under/overflows in statistics
     static Bool_t fgDefaultSumw2;   ///<!flag to call TH1::Sumw2 automatically at histogram creation time
+    constexpr static Int_t fgFillNChunk = 256; ///<!number of points whose bins are looked up at once by FillN
 
 public:
    static Int_t FitOptionsMake(Option_t *option, Foption_t &Foption);
@@ -0,0 +1,143 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TH1ConcurrentFiller
+#define ROOT_TH1ConcurrentFiller
+
+#include "Rtypes.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+
+class TH1;
+
+namespace ROOT {
+namespace Internal {
+
+/// View a bin of a histogram as an atomic; the storage of the histogram
+/// itself is not changed.
+template <typename T>
+std::atomic<T> &AsAtomic(T &value)
+{
+   static_assert(sizeof(std::atomic<T>) == sizeof(T) && alignof(std::atomic<T>) == alignof(T),
+                 "std::atomic<T> must have the layout of T");
+   return reinterpret_cast<std::atomic<T> &>(value);
+}
+
+/// Atomically add value to target, with relaxed memory ordering.
+template <typename T>
+void AtomicAdd(std::atomic<T> &target, T value)
+{
+   T old = target.load(std::memory_order_relaxed);
+   while (!target.compare_exchange_weak(old, T(old + value), std::memory_order_relaxed)) {
+   }
+}
+
+/// Atomically add w to an integer bin, saturating like TH1C/S/I::AddBinContent.
+template <typename T>
+void AtomicAddSaturated(T &target, Double_t w)
+{
+   constexpr Long64_t kMax = std::numeric_limits<T>::max();
+   auto &bin = AsAtomic(target);
+   T old = bin.load(std::memory_order_relaxed);
+   T desired;
+   do {
+      const Long64_t newval = old + Long64_t(w);
+      desired = T(std::max(-kMax, std::min(kMax, newval)));
+   } while (!bin.compare_exchange_weak(old, desired, std::memory_order_relaxed));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Sums (entries, weights, moments) accumulated by concurrent fills.
+///
+/// Every thread adds to one of a fixed number of shards, each on its own cache
+/// lines, so that threads do not contend on the same counters; Collect() adds
+/// up and resets the shards.
+
+class TConcurrentFillStats {
+public:
+   static constexpr Int_t kNShards = 64;
+
+private:
+   Int_t fNStats;                                   ///< Number of sums
+   Int_t fStride;                                   ///< Distance between shards, a multiple of a cache line
+   std::unique_ptr<std::atomic<Double_t>[]> fSums; ///< kNShards * fStride sums
+
+   static Int_t GetThisShard();
+
+public:
+   explicit TConcurrentFillStats(Int_t nstats);
+
+   /// The sums of the calling thread.
+   std::atomic<Double_t> *GetShard() { return &fSums[GetThisShard() * fStride]; }
+   void Collect(Double_t *sums);
+};
+
+} // namespace Internal
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill a TH1, TH2 or TH3 from many threads at the same time.
+
+class TH1ConcurrentFiller {
+public:
+   enum EStats {
+      kEntries,
+      kSumw,
+      kSumw2,
+      kSumwx,
+      kSumwx2,
+      kSumwy,
+      kSumwy2,
+      kSumwxy,
+      kSumwz,
+      kSumwz2,
+      kSumwxz,
+      kSumwyz,
+      kNStats
+   };
+
+private:
+   using AddBinFunc_t = void (*)(void *content, Int_t bin, Double_t w);
+
+   TH1 *fHist;                            ///< Histogram being filled
+   Int_t fDimension;                      ///< Dimension of fHist
+   void *fContent = nullptr;              ///< Bin contents of fHist; nullptr if the type is not supported
+   AddBinFunc_t fAddBin = nullptr;        ///< Atomic bin increment for the type of fContent
+   Double_t *fSumw2 = nullptr;            ///< Sum of squares of weights of fHist, if stored
+   Bool_t fStatOverflows;                 ///< Whether under/overflows enter the statistics
+   Internal::TConcurrentFillStats fStats; ///< Per-thread statistics, added to fHist by Flush()
+
+   Int_t DoFill(Double_t x, Double_t y, Double_t z, Double_t w);
+
+   TH1ConcurrentFiller(const TH1ConcurrentFiller &) = delete;
+   TH1ConcurrentFiller &operator=(const TH1ConcurrentFiller &) = delete;
+
+public:
+   explicit TH1ConcurrentFiller(TH1 &hist);
+   ~TH1ConcurrentFiller();
+
+   /// Fill a 1-D histogram with weight 1.
+   Int_t Fill(Double_t x) { return DoFill(x, 0., 0., 1.); }
+   /// Fill a 1-D histogram with weight a, or a 2-D histogram at (x, a) with weight 1.
+   Int_t Fill(Double_t x, Double_t a) { return fDimension == 1 ? DoFill(x, 0., 0., a) : DoFill(x, a, 0., 1.); }
+   /// Fill a 2-D histogram with weight a, or a 3-D histogram at (x, y, a) with weight 1.
+   Int_t Fill(Double_t x, Double_t y, Double_t a) { return fDimension == 2 ? DoFill(x, y, 0., a) : DoFill(x, y, a, 1.); }
+   /// Fill a 3-D histogram with weight w.
+   Int_t Fill(Double_t x, Double_t y, Double_t z, Double_t w) { return DoFill(x, y, z, w); }
+
+   void Flush();
+   TH1 *GetHist() const { return fHist; }
+};
+
+} // namespace ROOT
+
+#endif
@@ -28,6 +28,7 @@
 class TProfile;
 
 class TH2 : public TH1 {
+   friend class ROOT::TH1ConcurrentFiller;
 
 protected:
    Double_t     fScalefactor;     //Scale factor
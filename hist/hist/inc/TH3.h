@@ -29,6 +29,7 @@ class TH2D;
 class TProfile2D;
 
 class TH3 : public TH1, public TAtt3D {
+   friend class ROOT::TH1ConcurrentFiller;
 
 protected:
    Double_t     fTsumwy;          //Total Sum of weight*Y
@@ -61,6 +62,8 @@ protected:
    Int_t    Fill(Double_t,const char*,Double_t) {return Fill(0);} //MayNotUse
    Int_t    Fill(const char*,Double_t,Double_t) {return Fill(0);} //MayNotUse
    Int_t    Fill(const char*,const char*,Double_t) {return Fill(0);} //MayNotUse
+   void     FillN(Int_t, const Double_t *, const Double_t *, Int_t) {;} //MayNotUse
+   void     FillN(Int_t, const Double_t *, const Double_t *, const Double_t *, Int_t) {;} //MayNotUse
 
    virtual Double_t Interpolate(Double_t x, Double_t y) const; // May not use
    virtual Double_t Interpolate(Double_t x) const; // MayNotUse
@@ -86,6 +89,7 @@ public:
    virtual Int_t    Fill(Double_t x, const char *namey, const char *namez, Double_t w);
    virtual Int_t    Fill(Double_t x, const char *namey, Double_t z, Double_t w);
    virtual Int_t    Fill(Double_t x, Double_t y, const char *namez, Double_t w);
+   virtual void     FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double_t *z, const Double_t *w, Int_t stride=1);
 
    virtual void     FillRandom(const char *fname, Int_t ntimes=5000);
    virtual void     FillRandom(TH1 *h, Int_t ntimes=5000);
@@ -27,7 +27,13 @@ class TH3D;
 class THnSparse;
 class TF1;
 
+namespace ROOT {
+class THnConcurrentFiller;
+}
+
 class THn: public THnBase {
+   friend class ROOT::THnConcurrentFiller;
+
 private:
    THn(const THn&); // Not implemented
    THn& operator=(const THn&); // Not implemented
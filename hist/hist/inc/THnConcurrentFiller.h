@@ -0,0 +1,48 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_THnConcurrentFiller
+#define ROOT_THnConcurrentFiller
+
+#include "TH1ConcurrentFiller.h"
+
+class THn;
+
+namespace ROOT {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill a THn from many threads at the same time.
+
+class THnConcurrentFiller {
+   using AddBinFunc_t = void (*)(void *content, Long64_t bin, Double_t w);
+
+   THn *fHist;                            ///< Histogram being filled
+   Int_t fNdimensions;                    ///< Dimension of fHist
+   void *fContent = nullptr;              ///< Bin contents of fHist; nullptr if the type is not supported
+   AddBinFunc_t fAddBin = nullptr;        ///< Atomic bin increment for the type of fContent
+   Double_t *fSumw2 = nullptr;            ///< Sum of squares of weights of fHist, if stored
+   Internal::TConcurrentFillStats fStats; ///< Entries, sum of weights (squared), then per dimension sum of w*x and w*x*x
+
+   THnConcurrentFiller(const THnConcurrentFiller &) = delete;
+   THnConcurrentFiller &operator=(const THnConcurrentFiller &) = delete;
+
+public:
+   explicit THnConcurrentFiller(THn &hist);
+   ~THnConcurrentFiller();
+
+   Long64_t Fill(const Double_t *x, Double_t w = 1.);
+
+   void Flush();
+   THn *GetHist() const { return fHist; }
+};
+
+} // namespace ROOT
+
+#endif
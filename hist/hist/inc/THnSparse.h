@@ -21,7 +21,6 @@
 
 
 #include "THnBase.h"
-#include "TExMap.h"
 #include "THnSparse_Internal.h"
 
 // needed only for template instantiations of THnSparseT:
@@ -38,8 +37,7 @@ class THnSparse: public THnBase {
    Int_t      fChunkSize;    // number of entries for each chunk
    Long64_t   fFilledBins;   // number of filled bins
    TObjArray  fBinContent;   // array of THnSparseArrayChunk
-   TExMap     fBins;         //! filled bins
-   TExMap     fBinsContinued;//! filled bins for non-unique hashes, containing pairs of (bin index 0, bin index 1)
+   ROOT::Internal::THnSparseBinMap fBins; //! filled bins, by hash of their compact coordinates
    THnSparseCompactBinCoord *fCompactCoord; //! compact coordinate
 
    THnSparse(const THnSparse&); // Not implemented
@@ -69,6 +67,7 @@ class THnSparse: public THnBase {
       FillBinBase(w);
    }
    void InitStorage(Int_t* nbins, Int_t chunkSize);
+   void AddInternal(const THnBase* h, Double_t c, Bool_t rebinned);
 
  public:
    virtual ~THnSparse();
@@ -99,6 +98,8 @@ class THnSparse: public THnBase {
    Long64_t GetBin(const Double_t* x, Bool_t allocate = kTRUE);
    Long64_t GetBin(const char* name[], Bool_t allocate = kTRUE);
 
+   void FillN(Long64_t n, const Double_t* x, const Double_t* w = 0);
+
    /// Forwards to THnBase::SetBinContent().
    /// Non-virtual, CINT-compatible replacement of a using declaration.
    void SetBinContent(const Int_t* idx, Double_t v) {
@@ -23,6 +23,8 @@
 
 #include "TObject.h"
 
+#include <vector>
+
 class TBrowser;
 class TH1;
 class THnSparse;
@@ -65,5 +67,83 @@ class THnSparseArrayChunk: public TObject {
 
    ClassDef(THnSparseArrayChunk, 1); // chunks of linearized bins
 };
+
+namespace ROOT {
+namespace Internal {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Map from the hash of compact bin coordinates to the linear bin index of
+/// THnSparse.
+///
+/// Open addressing with linear probing over one flat array of (hash, bin)
+/// slots: a lookup reads consecutive slots, usually within one cache line.
+/// Bins with identical hashes (only possible if the compact coordinates do
+/// not fit into 8 bytes) simply occupy further slots of the same probe
+/// sequence; the caller tells matching bins apart. The load factor is kept
+/// at or below 1/2.
+
+class THnSparseBinMap {
+public:
+   struct Slot_t {
+      ULong64_t fHash; ///< Hash of the compact coordinates of fBin
+      Long64_t fBin;   ///< Linear bin index; -1 for an empty slot
+   };
+
+private:
+   std::vector<Slot_t> fSlots; ///< Power-of-two number of slots
+   Long64_t fSize = 0;         ///< Number of filled slots
+   Int_t fShift = 64;          ///< 64 - log2(fSlots.size())
+
+   /// First slot of the probe sequence for hash; Fibonacci hashing spreads
+   /// the (not well distributed) compact coordinates over the table.
+   Long64_t GetFirstSlot(ULong64_t hash) const
+   {
+      return fShift < 64 ? (Long64_t)((hash * 0x9E3779B97F4A7C15ull) >> fShift) : 0;
+   }
+
+   void Rehash(Long64_t nslots);
+
+public:
+   Long64_t GetSize() const { return fSize; }
+   Long64_t GetCapacity() const { return fSlots.size() / 2; }
+
+   /// Hint the CPU to load the first slot for hash; used by batched fills.
+   void Prefetch(ULong64_t hash) const
+   {
+#if defined(__GNUC__) || defined(__clang__)
+      if (!fSlots.empty())
+         __builtin_prefetch(&fSlots[GetFirstSlot(hash)]);
+#else
+      (void)hash;
+#endif
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Return the bin with hash for which matches(bin) is true, or -1. In that
+   /// case slot is set to where such a bin should be inserted with Insert().
+   template <class MATCHES>
+   Long64_t Find(ULong64_t hash, MATCHES &&matches, Long64_t &slot) const
+   {
+      if (fSlots.empty()) {
+         slot = -1;
+         return -1;
+      }
+      const Long64_t mask = fSlots.size() - 1;
+      for (slot = GetFirstSlot(hash);; slot = (slot + 1) & mask) {
+         const Slot_t &s = fSlots[slot];
+         if (s.fBin < 0)
+            return -1;
+         if (s.fHash == hash && matches(s.fBin))
+            return s.fBin;
+      }
+   }
+
+   void Insert(ULong64_t hash, Long64_t bin, Long64_t slot = -1);
+   void Reserve(Long64_t nbins);
+   void Clear();
+};
+
+} // namespace Internal
+} // namespace ROOT
 #endif // ROOT_THnSparse_Internal
 
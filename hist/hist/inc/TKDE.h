@@ -106,6 +106,7 @@ public:
    Double_t operator()(const Double_t* x, const Double_t* p=0) const;  // Needed for creating TF1
 
    Double_t GetValue(Double_t x) const { return (*this)(x); }
+   void GetValues(UInt_t n, const Double_t* x, Double_t* values) const;
    Double_t GetError(Double_t x) const;
 
    Double_t GetBias(Double_t x) const;
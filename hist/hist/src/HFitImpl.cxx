@@ -62,6 +62,8 @@ namespace HFit {
 
    void CheckGraphFitOptions(Foption_t &fitOption);
 
+   void GenerateGradient(TF1 * f1);
+
 
    void GetDrawingRange(TH1 * h1, ROOT::Fit::DataRange & range);
    void GetDrawingRange(TGraph * gr, ROOT::Fit::DataRange & range);
@@ -83,6 +85,15 @@ namespace HFit {
 
 }
 
+void HFit::GenerateGradient(TF1 * f1) {
+   // Generate the gradient of a formula based function with respect to its parameters by
+   // automatic differentiation; TF1::GradientPar then uses it instead of numerical derivatives
+   TFormula * formula = f1->GetFormula();
+   if (!formula || f1->IsLinear() || formula->IsVectorized() || formula->HasGeneratedGradient()) return;
+   if (!formula->GenerateGradientPar() || !formula->HasGeneratedGradient())
+      Info("Fit","cannot generate the gradient of %s, use numerical derivatives",f1->GetName());
+}
+
 int HFit::CheckFitFunction(const TF1 * f1, int dim) {
    // Check validity of fitted function
    if (!f1) {
@@ -232,6 +243,7 @@ TFitResultPtr HFit::Fit(FitObject * h1, TF1 *f1 , Foption_t & fitOption , const
 
    // set the fit function
    // if option grad is specified use gradient
+   if (fitOption.Gradient && !linear) HFit::GenerateGradient(f1);
    if ( (linear || fitOption.Gradient) )
       fitter->SetFunction(ROOT::Math::WrappedMultiTF1(*f1));
 #ifdef R__HAS_VECCORE
@@ -844,6 +856,7 @@ TFitResultPtr ROOT::Fit::UnBinFit(ROOT::Fit::UnBinData * data, TF1 * fitfunc, Fo
    // need to create a wrapper for an automatic  normalized TF1 ???
    if ( fitOption.Gradient ) {
       assert ( (int) dim == fitfunc->GetNdim() );
+      HFit::GenerateGradient(fitfunc);
       fitter->SetFunction(ROOT::Math::WrappedMultiTF1(*fitfunc) );
    }
    else
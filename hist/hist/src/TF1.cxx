@@ -9,6 +9,7 @@
  * For the list of contributors see $ROOTSYS/README/CREDITS.             *
  *************************************************************************/
 
+#include <algorithm>
 #include <iostream>
 #include "strlcpy.h"
 #include "snprintf.h"
@@ -1539,6 +1540,40 @@ Double_t TF1::EvalPar(const Double_t *x, const Double_t *params)
    return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the function on n points at once, with the parameters params
+/// (or the current parameters if params is 0).
+///
+/// The coordinates are stored by variable: x[i + j * n] is coordinate j of
+/// point i, and the value at point i is stored in result[i]. Functions
+/// defined by a formula use TFormula::EvalParBatch, which evaluates all
+/// points in a single compiled loop; other functions call EvalPar for each
+/// point.
+
+void TF1::EvalParBatch(Long64_t n, const Double_t *x, Double_t *result, const Double_t *params)
+{
+   if (n <= 0)
+      return;
+
+   if (fType == EFType::kFormula) {
+      assert(fFormula);
+      fFormula->EvalParBatch(n, x, result, params);
+      if (fNormalized && fNormIntegral != 0) {
+         for (Long64_t i = 0; i < n; ++i)
+            result[i] /= fNormIntegral;
+      }
+      return;
+   }
+
+   std::vector<Double_t> xi(std::max(fNdim, 1));
+   for (Long64_t i = 0; i < n; ++i) {
+      for (Int_t j = 0; j < fNdim; ++j)
+         xi[j] = x[i + j * n];
+      InitArgs(xi.data(), params);
+      result[i] = EvalPar(xi.data(), params);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Execute action corresponding to one event.
 ///
@@ -2444,9 +2479,19 @@ TAxis *TF1::GetZaxis() const
 /// Method is the same as in Derivative() function
 ///
 /// If a parameter is fixed, the gradient on this parameter = 0
+///
+/// The gradient generated by automatic differentiation is used if available,
+/// see GradientPar(const Double_t *, Double_t *, Double_t).
 
 Double_t TF1::GradientPar(Int_t ipar, const Double_t *x, Double_t eps)
 {
+   if (fType == EFType::kFormula && !fNormalized && fFormula->HasGeneratedGradient()) {
+      if (ipar < 0 || ipar >= fNpar)
+         return 0;
+      std::vector<Double_t> grad(fNpar);
+      GradientPar(x, grad.data(), eps);
+      return grad[ipar];
+   }
    return GradientParTempl<Double_t>(ipar, x, eps);
 }
 
@@ -2463,9 +2508,25 @@ Double_t TF1::GradientPar(Int_t ipar, const Double_t *x, Double_t eps)
 /// Method is the same as in Derivative() function
 ///
 /// If a parameter is fixed, the gradient on this parameter = 0
+///
+/// For functions defined by a formula whose gradient has been generated by
+/// automatic differentiation (see TFormula::GenerateGradientPar), the exact
+/// gradient is computed instead, in a single call.
 
 void TF1::GradientPar(const Double_t *x, Double_t *grad, Double_t eps)
 {
+   if (fType == EFType::kFormula && !fNormalized && fFormula->HasGeneratedGradient()) {
+      // the generated gradient adds to grad
+      std::fill(grad, grad + fNpar, 0.);
+      fFormula->GradientPar(x, grad);
+      for (Int_t ipar = 0; ipar < fNpar; ++ipar) {
+         Double_t al, bl;
+         GetParLimits(ipar, al, bl);
+         if (al * bl != 0 && al >= bl)
+            grad[ipar] = 0;
+      }
+      return;
+   }
    GradientParTempl<Double_t>(x, grad, eps);
 }
 
@@ -168,6 +168,16 @@ Double_t TF12::EvalPar(const Double_t *x, const Double_t *params)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate this function at the n points x; see TF1::EvalParBatch.
+
+void TF12::EvalParBatch(Long64_t n, const Double_t *x, Double_t *result, const Double_t *params)
+{
+   for (Long64_t i = 0; i < n; ++i)
+      result[i] = EvalPar(&x[i], params);
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Save primitive as a C++ statement(s) on output stream out
 
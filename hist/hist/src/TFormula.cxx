@@ -21,6 +21,7 @@
 #include "TInterpreterValue.h"
 #include "TFormula.h"
 #include "TRegexp.h"
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <iostream>
@@ -717,6 +718,9 @@ void TFormula::Copy(TObject &obj) const
    fnew.fFuncPtr = fFuncPtr;
    fnew.fGradGenerationInput = fGradGenerationInput;
    fnew.fGradFuncPtr = fGradFuncPtr;
+   fnew.fClingExpression = fClingExpression;
+   fnew.fBatchGenerationInput = fBatchGenerationInput;
+   fnew.fBatchFuncPtr = fBatchFuncPtr;
 
 }
 
@@ -731,7 +735,9 @@ void TFormula::Clear(Option_t * )
    fNumber = 0;
    fFormula = "";
    fClingName = "";
-
+   fClingExpression.clear();
+   fBatchGenerationInput.clear();
+   fBatchFuncPtr = nullptr;
 
    if(fMethod) fMethod->Delete();
    fMethod = nullptr;
@@ -2312,6 +2318,11 @@ void TFormula::ProcessFormula(TString &formula)
          fClingInput = TString::Format("%s %s(%s){ return %s ; }", argType.Data(), fClingName.Data(),
                                        argumentsPrototype.Data(), inputFormula.c_str());
 
+         // the batch evaluator is generated on demand from the same expression
+         fClingExpression = inputFormula;
+         fBatchGenerationInput.clear();
+         fBatchFuncPtr = nullptr;
+
 
          // std::cout << "Input Formula " << inputFormula << " \t vec formula  :  " << inputFormulaVecFlag << std::endl;
          // std::cout << "Cling functions existing " << std::endl;
@@ -3251,6 +3262,117 @@ void TFormula::GradientPar(const Double_t *x, Double_t *result)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Generate the batch evaluator of the formula: a function looping over
+/// n points stored by variable (see EvalParBatch), with the formula
+/// expression inlined in the loop body, so that the compiler can vectorize
+/// the loop. Formulas with identical expressions and the same number of
+/// variables share the same evaluator.
+/// \returns true on success.
+
+bool TFormula::GenerateBatchEvaluator()
+{
+   if (fBatchFuncPtr)
+      return true;
+   if (HasBatchGenerationFailed() || !fClingInitialized || fClingExpression.empty() || fVectorized ||
+       TestBit(TFormula::kLambda))
+      return false;
+
+   R__LOCKGUARD(gROOTMutex);
+
+   // The evaluator reads fNdim coordinates per point, so it depends on the dimension
+   const std::string batchKey = fClingExpression + " (batch, ndim=" + std::to_string(fNdim) + ")";
+   auto funcit = gClingFunctions.find(batchKey);
+   if (funcit != gClingFunctions.end()) {
+      fBatchFuncPtr = (TFormula::CallFuncSignature)funcit->second;
+      return true;
+   }
+
+   const std::string batchFuncName = GetBatchFuncName();
+   std::string vars;
+   for (Int_t j = 0; j < fNdim; ++j)
+      vars += std::string(j ? ", " : "") + "xs[i + " + std::to_string(j) + " * n]";
+   fBatchGenerationInput = "#pragma cling optimize(2)\n"
+                           "void " + batchFuncName + "(Long64_t n, Double_t *xs, Double_t *p, Double_t *result) {\n"
+                           "   (void)xs; (void)p;\n"
+                           "   for (Long64_t i = 0; i < n; ++i) {\n" +
+                           (fNdim > 0 ? "      Double_t x[" + std::to_string(fNdim) + "] = {" + vars + "};\n" : "") +
+                           "      result[i] = " + fClingExpression + ";\n"
+                           "   }\n"
+                           "}";
+
+   if (!functionExists(batchFuncName) && !gInterpreter->Declare(fBatchGenerationInput.c_str()))
+      return false;
+
+   TMethodCall method;
+   method.InitWithPrototype(batchFuncName.c_str(), "Long64_t,Double_t*,Double_t*,Double_t*");
+   if (!method.IsValid()) {
+      Error("GenerateBatchEvaluator", "Can't compile batch evaluator %s", batchFuncName.c_str());
+      return false;
+   }
+   fBatchFuncPtr = prepareFuncPtr(&method);
+   if (!fBatchFuncPtr)
+      return false;
+   gClingFunctions.insert(std::make_pair(batchKey, (void *)fBatchFuncPtr));
+   return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the formula on n points at once, with the given parameters (or
+/// the formula parameters if params is null).
+///
+/// The coordinates are stored by variable: x[i + j * n] is variable j of
+/// point i, and the value of the formula at point i is stored in result[i].
+/// The formula is evaluated by the batch evaluator (see
+/// GenerateBatchEvaluator), generated the first time it is needed; the
+/// vectorized (ROOT::Double_v) evaluation is used for vectorized formulas,
+/// and EvalPar for each point for lambda expressions or if the batch
+/// evaluator cannot be generated.
+
+void TFormula::EvalParBatch(Long64_t n, const Double_t *x, Double_t *result, const Double_t *params) const
+{
+   if (n <= 0)
+      return;
+
+   if (fReadyToExecute && !fClingInitialized && fLazyInitialization) {
+      R__LOCKGUARD(gROOTMutex);
+      const_cast<TFormula *>(this)->ReInitializeEvalMethod();
+   }
+
+   if (fBatchFuncPtr || const_cast<TFormula *>(this)->GenerateBatchEvaluator()) {
+      Double_t *xs = const_cast<Double_t *>(x);
+      Double_t *pars = const_cast<Double_t *>(params ? params : fClingParameters.data());
+      void *args[4] = {&n, &xs, &pars, &result};
+      (*fBatchFuncPtr)(0, 4, args, /*ret*/ nullptr);
+      return;
+   }
+
+#ifdef R__HAS_VECCORE
+   if (fVectorized && fNdim > 0) {
+      const Long64_t vecSize = vecCore::VectorSize<ROOT::Double_v>();
+      std::vector<ROOT::Double_v> xvec(fNdim);
+      for (Long64_t i = 0; i < n; i += vecSize) {
+         // pad the last chunk with its last point
+         const Long64_t m = std::min(vecSize, n - i);
+         for (Int_t j = 0; j < fNdim; ++j)
+            for (Long64_t k = 0; k < vecSize; ++k)
+               vecCore::Set(xvec[j], k, x[i + std::min(k, m - 1) + j * n]);
+         ROOT::Double_v ans = DoEvalVec(xvec.data(), params);
+         for (Long64_t k = 0; k < m; ++k)
+            result[i + k] = vecCore::Get(ans, k);
+      }
+      return;
+   }
+#endif
+
+   std::vector<Double_t> xi(std::max(fNdim, 1));
+   for (Long64_t i = 0; i < n; ++i) {
+      for (Int_t j = 0; j < fNdim; ++j)
+         xi[j] = x[i + j * n];
+      result[i] = EvalPar(xi.data(), params);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 #ifdef R__HAS_VECCORE
 // ROOT::Double_v TFormula::Eval(ROOT::Double_v x, ROOT::Double_v y, ROOT::Double_v z, ROOT::Double_v t) const
@@ -3375,6 +3375,9 @@ Int_t TH1::Fill(const char *namex, Double_t w)
 /// weights is automatically triggered and the sum of the squares of weights is incremented
 /// by \f$ w^2 \f$ in the bin corresponding to x.
 /// if w is NULL each entry is assumed a weight=1
+///
+/// Unless the axis can be extended, the bins are looked up for many values at
+/// once (see TAxis::FindFixBins), which is much faster than repeated calls to Fill.
 
 void TH1::FillN(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stride)
 {
@@ -3404,27 +3407,35 @@ void TH1::FillN(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stride
 
 void TH1::DoFillN(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stride)
 {
-   Int_t bin,i;
+   Int_t bin,i,j;
 
    fEntries += ntimes;
    Double_t ww = 1;
    Int_t nbins   = fXaxis.GetNbins();
+   // Unless the axis can be extended, look up the bins of a whole chunk at once
+   const Bool_t batch = !fXaxis.CanExtend();
+   Int_t bins[fgFillNChunk];
+   const Int_t chunk = fgFillNChunk*stride;
    ntimes *= stride;
-   for (i=0;i<ntimes;i+=stride) {
-      bin =fXaxis.FindBin(x[i]);
-      if (bin <0) continue;
-      if (w) ww = w[i];
-      if (!fSumw2.fN && ww != 1.0 && !TestBit(TH1::kIsNotW))  Sumw2();
-      if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
-      AddBinContent(bin, ww);
-      if (bin == 0 || bin > nbins) {
-         if (!GetStatOverflowsBehaviour()) continue;
-      }
-      Double_t z= ww;
-      fTsumw   += z;
-      fTsumw2  += z*z;
-      fTsumwx  += z*x[i];
-      fTsumwx2 += z*x[i]*x[i];
+   for (Int_t first=0;first<ntimes;first+=chunk) {
+      const Int_t last = TMath::Min(first+chunk, ntimes);
+      if (batch) fXaxis.FindFixBins((last-first)/stride, &x[first], bins, stride);
+      for (i=first,j=0;i<last;i+=stride,++j) {
+         bin = batch ? bins[j] : fXaxis.FindBin(x[i]);
+         if (bin <0) continue;
+         if (w) ww = w[i];
+         if (!fSumw2.fN && ww != 1.0 && !TestBit(TH1::kIsNotW))  Sumw2();
+         if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
+         AddBinContent(bin, ww);
+         if (bin == 0 || bin > nbins) {
+            if (!GetStatOverflowsBehaviour()) continue;
+         }
+         Double_t z= ww;
+         fTsumw   += z;
+         fTsumw2  += z*z;
+         fTsumwx  += z*x[i];
+         fTsumwx2 += z*x[i]*x[i];
+      }
    }
 }
 
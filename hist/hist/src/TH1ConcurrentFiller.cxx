@@ -0,0 +1,236 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/** \class ROOT::TH1ConcurrentFiller
+    \ingroup Hist
+
+Fill a TH1, TH2 or TH3 from many threads at the same time, without
+per-thread copies of the histogram.
+
+Bin contents and sums of squares of weights are updated in place with
+relaxed atomic operations; the global statistics (entries, sums of weights
+and moments) are accumulated per thread and added to the histogram by
+Flush(), which is also called by the destructor. All threads share one
+filler:
+
+~~~{.cpp}
+TH2D h("h", "h", 1000, 0, 1, 1000, 0, 1);
+ROOT::TH1ConcurrentFiller filler(h);
+ROOT::TThreadExecutor pool;
+pool.Foreach([&](int i) { filler.Fill(x[i], y[i], w[i]); }, ROOT::TSeqI(n));
+filler.Flush();
+~~~
+
+Fills behave like TH1::Fill, except that:
+ - axes are never extended: the filler disables TH1::SetCanExtend and
+   values outside of the axes go to the under/overflow bins;
+ - the storage of the sum of squares of weights (TH1::Sumw2) is enabled
+   up front, since it cannot be switched on while threads fill, unless
+   the histogram has the TH1::kIsNotW bit set;
+ - the histogram statistics are only up to date after Flush().
+
+The histogram must not be modified or read by other means while threads
+fill it. Profiles, TH2Poly and TH1K are not supported.
+*/
+
+#include "TH1ConcurrentFiller.h"
+
+#include "TH1.h"
+#include "TH2.h"
+#include "TH2Poly.h"
+#include "TH3.h"
+#include "TH1K.h"
+#include "TProfile.h"
+#include "TProfile2D.h"
+#include "TProfile3D.h"
+#include "TError.h"
+
+namespace {
+
+std::atomic<Int_t> gNextShard{0};
+
+template <typename T>
+void AddBinSaturated(void *content, Int_t bin, Double_t w)
+{
+   ROOT::Internal::AtomicAddSaturated(static_cast<T *>(content)[bin], w);
+}
+
+template <typename T>
+void AddBin(void *content, Int_t bin, Double_t w)
+{
+   ROOT::Internal::AtomicAdd(ROOT::Internal::AsAtomic(static_cast<T *>(content)[bin]), T(w));
+}
+
+} // unnamed namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Allocate kNShards zeroed shards of nstats sums each.
+
+ROOT::Internal::TConcurrentFillStats::TConcurrentFillStats(Int_t nstats)
+   : fNStats(nstats), fStride((nstats + 7) / 8 * 8), fSums(new std::atomic<Double_t>[kNShards * fStride])
+{
+   for (Int_t i = 0; i < kNShards * fStride; ++i)
+      fSums[i].store(0., std::memory_order_relaxed);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Threads are assigned shards round-robin, the first time they fill.
+
+Int_t ROOT::Internal::TConcurrentFillStats::GetThisShard()
+{
+   thread_local const Int_t shard = gNextShard.fetch_add(1, std::memory_order_relaxed) % kNShards;
+   return shard;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Store in sums the totals over all shards, and reset the shards.
+
+void ROOT::Internal::TConcurrentFillStats::Collect(Double_t *sums)
+{
+   std::fill(sums, sums + fNStats, 0.);
+   for (Int_t shard = 0; shard < kNShards; ++shard) {
+      for (Int_t i = 0; i < fNStats; ++i)
+         sums[i] += fSums[shard * fStride + i].exchange(0., std::memory_order_relaxed);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Prepare hist for concurrent filling: empty its buffer, forbid axis
+/// extension and enable the storage of the sum of squares of weights.
+
+ROOT::TH1ConcurrentFiller::TH1ConcurrentFiller(TH1 &hist)
+   : fHist(&hist), fDimension(hist.GetDimension()), fStatOverflows(hist.GetStatOverflowsBehaviour()),
+     fStats(kNStats)
+{
+   if (hist.InheritsFrom(TProfile::Class()) || hist.InheritsFrom(TProfile2D::Class()) ||
+       hist.InheritsFrom(TProfile3D::Class()) || hist.InheritsFrom(TH2Poly::Class()) ||
+       hist.InheritsFrom(TH1K::Class())) {
+      ::Error("TH1ConcurrentFiller", "%s: concurrent filling of %s is not supported", hist.GetName(),
+              hist.ClassName());
+      return;
+   }
+
+   if (hist.fBuffer)
+      hist.BufferEmpty(1);
+   if (hist.SetCanExtend(TH1::kNoAxis) != TH1::kNoAxis)
+      ::Warning("TH1ConcurrentFiller", "%s: axes cannot be extended while filling concurrently", hist.GetName());
+   if (!hist.fSumw2.fN && !hist.TestBit(TH1::kIsNotW))
+      hist.Sumw2();
+
+   // The bin contents may only be reallocated by the calls above.
+   if (TArrayD *arr = dynamic_cast<TArrayD *>(&hist)) {
+      fContent = arr->fArray;
+      fAddBin = &AddBin<Double_t>;
+   } else if (TArrayF *arr = dynamic_cast<TArrayF *>(&hist)) {
+      fContent = arr->fArray;
+      fAddBin = &AddBin<Float_t>;
+   } else if (TArrayI *arr = dynamic_cast<TArrayI *>(&hist)) {
+      fContent = arr->fArray;
+      fAddBin = &AddBinSaturated<Int_t>;
+   } else if (TArrayS *arr = dynamic_cast<TArrayS *>(&hist)) {
+      fContent = arr->fArray;
+      fAddBin = &AddBinSaturated<Short_t>;
+   } else if (TArrayC *arr = dynamic_cast<TArrayC *>(&hist)) {
+      fContent = arr->fArray;
+      fAddBin = &AddBinSaturated<Char_t>;
+   } else {
+      ::Error("TH1ConcurrentFiller", "%s: unknown bin content type of %s", hist.GetName(), hist.ClassName());
+      return;
+   }
+   fSumw2 = hist.fSumw2.fN ? hist.fSumw2.fArray : nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the pending statistics to the histogram.
+
+ROOT::TH1ConcurrentFiller::~TH1ConcurrentFiller()
+{
+   Flush();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill the bin of (x, y, z) with weight w; y and z are ignored for lower
+/// dimensions. Returns the global bin number, or -1 if the bin is not taken
+/// into account by the statistics, as TH1::Fill does.
+
+Int_t ROOT::TH1ConcurrentFiller::DoFill(Double_t x, Double_t y, Double_t z, Double_t w)
+{
+   if (!fContent)
+      return -1;
+
+   TH1 &h = *fHist;
+   const Int_t binx = h.fXaxis.FindFixBin(x);
+   const Int_t biny = fDimension > 1 ? h.fYaxis.FindFixBin(y) : 0;
+   const Int_t binz = fDimension > 2 ? h.fZaxis.FindFixBin(z) : 0;
+   const Int_t bin = h.GetBin(binx, biny, binz);
+
+   if (fSumw2)
+      Internal::AtomicAdd(Internal::AsAtomic(fSumw2[bin]), w * w);
+   fAddBin(fContent, bin, w);
+
+   std::atomic<Double_t> *stats = fStats.GetShard();
+   Internal::AtomicAdd(stats[kEntries], 1.);
+
+   if (!fStatOverflows) {
+      if (binx == 0 || binx > h.fXaxis.GetNbins())
+         return -1;
+      if (fDimension > 1 && (biny == 0 || biny > h.fYaxis.GetNbins()))
+         return -1;
+      if (fDimension > 2 && (binz == 0 || binz > h.fZaxis.GetNbins()))
+         return -1;
+   }
+   Internal::AtomicAdd(stats[kSumw], w);
+   Internal::AtomicAdd(stats[kSumw2], w * w);
+   Internal::AtomicAdd(stats[kSumwx], w * x);
+   Internal::AtomicAdd(stats[kSumwx2], w * x * x);
+   if (fDimension > 1) {
+      Internal::AtomicAdd(stats[kSumwy], w * y);
+      Internal::AtomicAdd(stats[kSumwy2], w * y * y);
+      Internal::AtomicAdd(stats[kSumwxy], w * x * y);
+   }
+   if (fDimension > 2) {
+      Internal::AtomicAdd(stats[kSumwz], w * z);
+      Internal::AtomicAdd(stats[kSumwz2], w * z * z);
+      Internal::AtomicAdd(stats[kSumwxz], w * x * z);
+      Internal::AtomicAdd(stats[kSumwyz], w * y * z);
+   }
+   return bin;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the statistics accumulated by all threads since the last call to the
+/// histogram. Call it once the threads are done filling, before using the
+/// histogram.
+
+void ROOT::TH1ConcurrentFiller::Flush()
+{
+   Double_t s[kNStats];
+   fStats.Collect(s);
+
+   TH1 &h = *fHist;
+   h.fEntries += s[kEntries];
+   h.fTsumw += s[kSumw];
+   h.fTsumw2 += s[kSumw2];
+   h.fTsumwx += s[kSumwx];
+   h.fTsumwx2 += s[kSumwx2];
+   if (TH2 *h2 = dynamic_cast<TH2 *>(fHist)) {
+      h2->fTsumwy += s[kSumwy];
+      h2->fTsumwy2 += s[kSumwy2];
+      h2->fTsumwxy += s[kSumwxy];
+   } else if (TH3 *h3 = dynamic_cast<TH3 *>(fHist)) {
+      h3->fTsumwy += s[kSumwy];
+      h3->fTsumwy2 += s[kSumwy2];
+      h3->fTsumwxy += s[kSumwxy];
+      h3->fTsumwz += s[kSumwz];
+      h3->fTsumwz2 += s[kSumwz2];
+      h3->fTsumwxz += s[kSumwxz];
+      h3->fTsumwyz += s[kSumwyz];
+   }
+}
@@ -554,30 +554,42 @@ void TH2::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double
    }
 
    Double_t ww = 1;
-   for (i=ifirst;i<ntimes;i+=stride) {
-      fEntries++;
-      binx = fXaxis.FindBin(x[i]);
-      biny = fYaxis.FindBin(y[i]);
-      if (binx <0 || biny <0) continue;
-      bin  = biny*(fXaxis.GetNbins()+2) + binx;
-      if (w) ww = w[i];
-      if (!fSumw2.fN && ww != 1.0 && !TestBit(TH1::kIsNotW))  Sumw2();
-      if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
-      AddBinContent(bin,ww);
-      if (binx == 0 || binx > fXaxis.GetNbins()) {
-         if (!GetStatOverflowsBehaviour()) continue;
+   // Unless an axis can be extended, look up the bins of a whole chunk at once
+   const Bool_t batch = !fXaxis.CanExtend() && !fYaxis.CanExtend();
+   Int_t binsx[fgFillNChunk], binsy[fgFillNChunk];
+   const Int_t chunk = fgFillNChunk*stride;
+   for (Int_t first=ifirst;first<ntimes;first+=chunk) {
+      const Int_t last = TMath::Min(first+chunk, ntimes);
+      if (batch) {
+         fXaxis.FindFixBins((last-first)/stride, &x[first], binsx, stride);
+         fYaxis.FindFixBins((last-first)/stride, &y[first], binsy, stride);
       }
-      if (biny == 0 || biny > fYaxis.GetNbins()) {
-         if (!GetStatOverflowsBehaviour()) continue;
+      Int_t j;
+      for (i=first,j=0;i<last;i+=stride,++j) {
+         fEntries++;
+         binx = batch ? binsx[j] : fXaxis.FindBin(x[i]);
+         biny = batch ? binsy[j] : fYaxis.FindBin(y[i]);
+         if (binx <0 || biny <0) continue;
+         bin  = biny*(fXaxis.GetNbins()+2) + binx;
+         if (w) ww = w[i];
+         if (!fSumw2.fN && ww != 1.0 && !TestBit(TH1::kIsNotW))  Sumw2();
+         if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
+         AddBinContent(bin,ww);
+         if (binx == 0 || binx > fXaxis.GetNbins()) {
+            if (!GetStatOverflowsBehaviour()) continue;
+         }
+         if (biny == 0 || biny > fYaxis.GetNbins()) {
+            if (!GetStatOverflowsBehaviour()) continue;
+         }
+         Double_t z= ww; //(ww > 0 ? ww : -ww);
+         fTsumw   += z;
+         fTsumw2  += z*z;
+         fTsumwx  += z*x[i];
+         fTsumwx2 += z*x[i]*x[i];
+         fTsumwy  += z*y[i];
+         fTsumwy2 += z*y[i]*y[i];
+         fTsumwxy += z*x[i]*y[i];
       }
-      Double_t z= ww; //(ww > 0 ? ww : -ww);
-      fTsumw   += z;
-      fTsumw2  += z*z;
-      fTsumwx  += z*x[i];
-      fTsumwx2 += z*x[i]*x[i];
-      fTsumwy  += z*y[i];
-      fTsumwy2 += z*y[i]*y[i];
-      fTsumwxy += z*x[i]*y[i];
    }
 }
 
@@ -383,6 +383,88 @@ Int_t TH3::Fill(Double_t x, Double_t y, Double_t z, Double_t w)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill a 3-D histogram with an array of values and weights.
+///
+///  - ntimes:  number of entries in arrays x, y, z and w (array size must be ntimes*stride)
+///  - x, y, z: arrays of values to be histogrammed
+///  - w:       array of weights
+///  - stride:  step size through arrays x, y, z and w
+///
+///   - If the weight is not equal to 1, the storage of the sum of squares of
+///     weights is automatically triggered and the sum of the squares of weights is incremented
+///     by w[i]^2 in the bin corresponding to x[i],y[i],z[i].
+///   - If w is NULL each entry is assumed a weight=1
+///
+/// Unless an axis can be extended, the bins are looked up for many values at
+/// once (see TAxis::FindFixBins), which is much faster than repeated calls to Fill.
+
+void TH3::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double_t *z, const Double_t *w, Int_t stride)
+{
+   Int_t binx, biny, binz, bin, i, j;
+   ntimes *= stride;
+   Int_t ifirst = 0;
+
+   //If a buffer is activated, fill buffer
+   if (fBuffer) {
+      for (i=0;i<ntimes;i+=stride) {
+         if (!fBuffer) break; // buffer can be deleted in BufferFill when is empty
+         BufferFill(x[i], y[i], z[i], w ? w[i] : 1.);
+      }
+      // fill the remaining entries if the buffer has been deleted
+      if (i < ntimes && fBuffer==0)
+         ifirst = i;
+      else
+         return;
+   }
+
+   Double_t ww = 1;
+   // Unless an axis can be extended, look up the bins of a whole chunk at once
+   const Bool_t batch = !fXaxis.CanExtend() && !fYaxis.CanExtend() && !fZaxis.CanExtend();
+   Int_t binsx[fgFillNChunk], binsy[fgFillNChunk], binsz[fgFillNChunk];
+   const Int_t chunk = fgFillNChunk*stride;
+   for (Int_t first=ifirst;first<ntimes;first+=chunk) {
+      const Int_t last = TMath::Min(first+chunk, ntimes);
+      if (batch) {
+         fXaxis.FindFixBins((last-first)/stride, &x[first], binsx, stride);
+         fYaxis.FindFixBins((last-first)/stride, &y[first], binsy, stride);
+         fZaxis.FindFixBins((last-first)/stride, &z[first], binsz, stride);
+      }
+      for (i=first,j=0;i<last;i+=stride,++j) {
+         fEntries++;
+         binx = batch ? binsx[j] : fXaxis.FindBin(x[i]);
+         biny = batch ? binsy[j] : fYaxis.FindBin(y[i]);
+         binz = batch ? binsz[j] : fZaxis.FindBin(z[i]);
+         if (binx <0 || biny <0 || binz<0) continue;
+         bin  = binx + (fXaxis.GetNbins()+2)*(biny + (fYaxis.GetNbins()+2)*binz);
+         if (w) ww = w[i];
+         if (!fSumw2.fN && ww != 1.0 && !TestBit(TH1::kIsNotW))  Sumw2();
+         if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
+         AddBinContent(bin,ww);
+         if (binx == 0 || binx > fXaxis.GetNbins()) {
+            if (!GetStatOverflowsBehaviour()) continue;
+         }
+         if (biny == 0 || biny > fYaxis.GetNbins()) {
+            if (!GetStatOverflowsBehaviour()) continue;
+         }
+         if (binz == 0 || binz > fZaxis.GetNbins()) {
+            if (!GetStatOverflowsBehaviour()) continue;
+         }
+         fTsumw   += ww;
+         fTsumw2  += ww*ww;
+         fTsumwx  += ww*x[i];
+         fTsumwx2 += ww*x[i]*x[i];
+         fTsumwy  += ww*y[i];
+         fTsumwy2 += ww*y[i]*y[i];
+         fTsumwxy += ww*x[i]*y[i];
+         fTsumwz  += ww*z[i];
+         fTsumwz2 += ww*z[i]*z[i];
+         fTsumwxz += ww*x[i]*z[i];
+         fTsumwyz += ww*y[i]*z[i];
+      }
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Increment cell defined by namex,namey,namez by a weight w
 ///
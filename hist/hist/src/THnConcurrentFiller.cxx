@@ -0,0 +1,131 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/** \class ROOT::THnConcurrentFiller
+    \ingroup Hist
+
+Fill a THn from many threads at the same time, without per-thread copies
+of the histogram; see ROOT::TH1ConcurrentFiller for the details.
+
+Bin contents and sums of squares of weights are updated in place with
+relaxed atomic operations, the statistics are accumulated per thread and
+added to the histogram by Flush(), which is also called by the destructor.
+The storage of bin contents and errors is allocated up front.
+*/
+
+#include "THnConcurrentFiller.h"
+
+#include "THn.h"
+#include "TAxis.h"
+#include "TError.h"
+
+#include <vector>
+
+namespace {
+
+template <typename T>
+void AddBin(void *content, Long64_t bin, Double_t w)
+{
+   ROOT::Internal::AtomicAdd(ROOT::Internal::AsAtomic(static_cast<T *>(content)[bin]), (T)w);
+}
+
+/// Return the (allocated) storage of arr if it holds T, and set addBin to match.
+template <typename T>
+void *GetContent(TNDArray &arr, void (*&addBin)(void *, Long64_t, Double_t))
+{
+   auto typed = dynamic_cast<TNDArrayT<T> *>(&arr);
+   if (!typed)
+      return nullptr;
+   addBin = &AddBin<T>;
+   return &typed->At(ULong64_t(0));
+}
+
+} // unnamed namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Prepare hist for concurrent filling: allocate the bin contents and, if
+/// errors are calculated, the sums of squares of weights.
+
+ROOT::THnConcurrentFiller::THnConcurrentFiller(THn &hist)
+   : fHist(&hist), fNdimensions(hist.GetNdimensions()), fStats(3 + 2 * hist.GetNdimensions())
+{
+   TNDArray &arr = hist.GetArray();
+   if (!(fContent = GetContent<Double_t>(arr, fAddBin)) && !(fContent = GetContent<Float_t>(arr, fAddBin)) &&
+       !(fContent = GetContent<Long64_t>(arr, fAddBin)) && !(fContent = GetContent<Long_t>(arr, fAddBin)) &&
+       !(fContent = GetContent<Int_t>(arr, fAddBin)) && !(fContent = GetContent<Short_t>(arr, fAddBin)) &&
+       !(fContent = GetContent<Char_t>(arr, fAddBin))) {
+      ::Error("THnConcurrentFiller", "%s: unknown bin content type", hist.GetName());
+      return;
+   }
+   if (hist.GetCalculateErrors())
+      fSumw2 = &hist.fSumw2.At(ULong64_t(0));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the pending statistics to the histogram.
+
+ROOT::THnConcurrentFiller::~THnConcurrentFiller()
+{
+   Flush();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill the bin of the point x (an array of GetNdimensions() coordinates)
+/// with weight w, like THnBase::Fill; return the linear bin index.
+
+Long64_t ROOT::THnConcurrentFiller::Fill(const Double_t *x, Double_t w)
+{
+   if (!fContent)
+      return -1;
+
+   // THn::GetBin uses a buffer in the histogram, not usable from many threads
+   thread_local std::vector<Int_t> coord;
+   coord.resize(fNdimensions);
+   for (Int_t d = 0; d < fNdimensions; ++d)
+      coord[d] = fHist->GetAxis(d)->FindFixBin(x[d]);
+   const Long64_t bin = fHist->GetArray().GetBin(coord.data());
+
+   fAddBin(fContent, bin, w);
+   std::atomic<Double_t> *stats = fStats.GetShard();
+   Internal::AtomicAdd(stats[0], 1.);
+   if (fSumw2) {
+      Internal::AtomicAdd(Internal::AsAtomic(fSumw2[bin]), w * w);
+      Internal::AtomicAdd(stats[1], w);
+      Internal::AtomicAdd(stats[2], w * w);
+      for (Int_t d = 0; d < fNdimensions; ++d) {
+         Internal::AtomicAdd(stats[3 + 2 * d], w * x[d]);
+         Internal::AtomicAdd(stats[4 + 2 * d], w * x[d] * x[d]);
+      }
+   }
+   return bin;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the statistics accumulated by all threads since the last call to the
+/// histogram. Call it once the threads are done filling, before using the
+/// histogram.
+
+void ROOT::THnConcurrentFiller::Flush()
+{
+   std::vector<Double_t> s(3 + 2 * fNdimensions);
+   fStats.Collect(s.data());
+
+   THn &h = *fHist;
+   h.fEntries += s[0];
+   if (h.GetCalculateErrors()) {
+      h.fTsumw += s[1];
+      h.fTsumw2 += s[2];
+      for (Int_t d = 0; d < fNdimensions; ++d) {
+         h.fTsumwx[d] += s[3 + 2 * d];
+         h.fTsumwx2[d] += s[4 + 2 * d];
+      }
+   }
+   h.fIntegralStatus = THn::kInvalidInt;
+}
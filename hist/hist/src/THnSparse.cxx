@@ -16,6 +16,9 @@
 #include "TDataMember.h"
 #include "TDataType.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace {
 //______________________________________________________________________________
 //
@@ -318,9 +321,9 @@ ULong64_t THnSparseCoordCompression::GetHashFromBuffer(const Char_t* buf) const
 {
    // Bins are addressed in two different modes, depending
    // on whether the compact bin index fits into a Long64_t or not.
-   // If it does, we can use it as a "perfect hash" for the TExMap.
+   // If it does, we can use it as a "perfect hash" for the bin map.
    // If not we build a hash from the compact bin index, and use that
-   // as the TExMap's hash.
+   // as the bin map's hash.
 
    if (fCoordBufferSize <= 8) {
       // fits into a Long64_t
@@ -329,12 +332,12 @@ ULong64_t THnSparseCoordCompression::GetHashFromBuffer(const Char_t* buf) const
       return hash1;
    }
 
-   // else: doesn't fit into a Long64_t:
-   ULong64_t hash = 5381;
+   // else: doesn't fit into a Long64_t; FNV-1a
+   ULong64_t hash = 14695981039346656037ull;
    const Char_t* str = buf;
    while (str - buf < fCoordBufferSize) {
-      hash *= 5;
-      hash += *(str++);
+      hash ^= (UChar_t) *(str++);
+      hash *= 1099511628211ull;
    }
    return hash;
 }
@@ -489,6 +492,72 @@ void THnSparseArrayChunk::Sumw2()
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Move all bins into a table of nslots slots, a power of two.
+
+void ROOT::Internal::THnSparseBinMap::Rehash(Long64_t nslots)
+{
+   std::vector<Slot_t> old(nslots, Slot_t{0, -1});
+   old.swap(fSlots);
+   fShift = 64;
+   while (nslots > 1) {
+      nslots /= 2;
+      --fShift;
+   }
+   const Long64_t mask = fSlots.size() - 1;
+   for (const Slot_t &s: old) {
+      if (s.fBin < 0)
+         continue;
+      Long64_t slot = GetFirstSlot(s.fHash);
+      while (fSlots[slot].fBin >= 0)
+         slot = (slot + 1) & mask;
+      fSlots[slot] = s;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add bin with hash. If slot is not -1 it must be the one returned by the
+/// last Find() for hash, saving a second probe.
+
+void ROOT::Internal::THnSparseBinMap::Insert(ULong64_t hash, Long64_t bin, Long64_t slot /*= -1*/)
+{
+   if (2 * (fSize + 1) > (Long64_t)fSlots.size()) {
+      Rehash(fSlots.empty() ? 64 : 2 * fSlots.size());
+      slot = -1;
+   }
+   if (slot < 0) {
+      const Long64_t mask = fSlots.size() - 1;
+      slot = GetFirstSlot(hash);
+      while (fSlots[slot].fBin >= 0)
+         slot = (slot + 1) & mask;
+   }
+   fSlots[slot] = Slot_t{hash, bin};
+   ++fSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Grow the table such that nbins bins fit without rehashing.
+
+void ROOT::Internal::THnSparseBinMap::Reserve(Long64_t nbins)
+{
+   Long64_t nslots = 64;
+   while (nslots < 2 * nbins)
+      nslots *= 2;
+   if (nslots > (Long64_t)fSlots.size())
+      Rehash(nslots);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Remove all bins and release the memory.
+
+void ROOT::Internal::THnSparseBinMap::Clear()
+{
+   std::vector<Slot_t>().swap(fSlots);
+   fSize = 0;
+   fShift = 64;
+}
+
+
 /** \class THnSparse
     \ingroup Hist
 
@@ -570,14 +639,17 @@ Translation from an n-dimensional bin coordinate to the linear index within
 the chunks is done by GetBin(). It creates a hash from the compacted bin
 coordinates (the hash of a bin coordinate is the compacted coordinate itself
 if it takes less than 8 bytes, the size of a Long64_t.
-This hash is used to lookup the linear index in the TExMap member fBins;
-the coordinates of the entry fBins points to is compared to the coordinates
-passed to GetBin(). If they do not match, these two coordinates have the same
-hash - which is extremely unlikely but (for the case where the compact bin
-coordinates are larger than 4 bytes) possible. In this case, fBinsContinued
-contains a chain of linear indexes with the same hash. Iterating through this
-chain and comparing each bin coordinates with the one passed to GetBin() will
-retrieve the matching bin.
+This hash is used to lookup the linear index in the open-addressing hash
+table fBins (see ROOT::Internal::THnSparseBinMap), a flat array of
+(hash, linear index) pairs; the coordinates of each entry with a matching hash
+are compared to the coordinates passed to GetBin(). Different coordinates
+can only have the same hash if the compact bin coordinates are larger than
+8 bytes; such entries are stored next to each other in the table.
+
+To fill many entries at once, use FillN(): it looks up the bins of a batch of
+entries together, which hides most of the memory latency of the table.
+Merge() and Add() of THnSparse with identical binning work on the compact
+bin coordinates directly, without converting them to bin indices and back.
 */
 
 
@@ -658,28 +730,14 @@ void THnSparse::FillExMap()
    THnSparseArrayChunk* chunk = 0;
    THnSparseCoordCompression compactCoord(*GetCompactCoord());
    Long64_t idx = 0;
-   if (2 * GetNbins() > fBins.Capacity())
-      fBins.Expand(3 * GetNbins());
+   fBins.Reserve(GetNbins());
    while ((chunk = (THnSparseArrayChunk*) iChunk())) {
       const Int_t chunkSize = chunk->GetEntries();
       Char_t* buf = chunk->fCoordinates;
       const Int_t singleCoordSize = chunk->fSingleCoordinateSize;
       const Char_t* endbuf = buf + singleCoordSize * chunkSize;
-      for (; buf < endbuf; buf += singleCoordSize, ++idx) {
-         Long64_t hash = compactCoord.GetHashFromBuffer(buf);
-         Long64_t linidx = fBins.GetValue(hash);
-         if (linidx) {
-            Long64_t nextidx = linidx;
-            while (nextidx) {
-               // must be a collision, so go to fBinsContinued.
-               linidx = nextidx;
-               nextidx = fBinsContinued.GetValue(linidx);
-            }
-            fBinsContinued.Add(linidx, idx + 1);
-         } else {
-            fBins.Add(hash, idx + 1);
-         }
-      }
+      for (; buf < endbuf; buf += singleCoordSize, ++idx)
+         fBins.Insert(compactCoord.GetHashFromBuffer(buf), idx);
    }
 }
 
@@ -690,9 +748,7 @@ void THnSparse::Reserve(Long64_t nbins) {
    if (!fBins.GetSize() && fBinContent.GetSize()) {
       FillExMap();
    }
-   if (2 * nbins > fBins.Capacity()) {
-      fBins.Expand(3 * nbins);
-   }
+   fBins.Reserve(nbins);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -736,6 +792,86 @@ Long64_t THnSparse::GetBin(const Int_t* coord, Bool_t allocate /*= kTRUE*/)
    return GetBinIndexForCurrentBin(allocate);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill n entries; x holds the n * GetNdimensions() coordinates, entry by
+/// entry, and w the n weights (or is NULL for weights of 1). Equivalent to
+/// calling Fill(x + i * GetNdimensions(), w[i]) for each entry, but the bins
+/// of a batch of entries are computed first and their slots in the bin map
+/// are prefetched before they are looked up.
+
+void THnSparse::FillN(Long64_t n, const Double_t* x, const Double_t* w /*= 0*/)
+{
+   constexpr Int_t kBatch = 64;
+   THnSparseCompactBinCoord* cc = GetCompactCoord();
+   const Int_t bufSize = cc->GetBufferSize();
+   std::vector<Char_t> bufs(kBatch * bufSize + sizeof(Long64_t));
+   ULong64_t hashes[kBatch];
+   Int_t* coord = cc->GetCoord();
+
+   if (fBinContent.GetSize() && !fBins.GetSize())
+      FillExMap();
+
+   for (Long64_t start = 0; start < n; start += kBatch) {
+      const Int_t nbatch = (Int_t) std::min<Long64_t>(kBatch, n - start);
+      const Double_t* xbatch = x + start * fNdimensions;
+      for (Int_t i = 0; i < nbatch; ++i) {
+         for (Int_t d = 0; d < fNdimensions; ++d)
+            coord[d] = GetAxis(d)->FindBin(xbatch[i * fNdimensions + d]);
+         hashes[i] = cc->SetBufferFromCoord(coord, &bufs[i * bufSize]);
+         fBins.Prefetch(hashes[i]);
+      }
+      for (Int_t i = 0; i < nbatch; ++i) {
+         const Double_t wi = w ? w[start + i] : 1.;
+         UpdateXStat(xbatch + i * fNdimensions, wi);
+         cc->SetBuffer(&bufs[i * bufSize]);
+         FillBin(GetBinIndexForCurrentBin(kTRUE), wi);
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add() implementation; for a THnSparse with identical binning the compact
+/// bin coordinates of h are looked up directly, see THnBase::AddInternal().
+
+void THnSparse::AddInternal(const THnBase* h, Double_t c, Bool_t rebinned)
+{
+   const THnSparse* hs = dynamic_cast<const THnSparse*>(h);
+   if (rebinned || !hs || fNdimensions != h->GetNdimensions()
+       || hs->GetCompactCoord()->GetBufferSize() != GetCompactCoord()->GetBufferSize()) {
+      THnBase::AddInternal(h, c, rebinned);
+      return;
+   }
+
+   // Trigger error calculation if h has it
+   if (!GetCalculateErrors() && h->GetCalculateErrors())
+      Sumw2();
+   const Bool_t haveErrors = GetCalculateErrors();
+
+   Reserve(GetNbins() + hs->GetNbins());
+
+   THnSparseCompactBinCoord* cc = GetCompactCoord();
+   const Int_t nchunks = hs->GetNChunks();
+   for (Int_t ichunk = 0; ichunk < nchunks; ++ichunk) {
+      const THnSparseArrayChunk* chunk = hs->GetChunk(ichunk);
+      const Int_t nentries = chunk->GetEntries();
+      for (Int_t i = 0; i < nentries; ++i) {
+         cc->SetBuffer(chunk->fCoordinates + i * chunk->fSingleCoordinateSize);
+         const Long64_t bin = GetBinIndexForCurrentBin(kTRUE);
+         THnSparseArrayChunk* target = GetChunk(bin / fChunkSize);
+         const Int_t targetidx = bin % fChunkSize;
+
+         const Double_t v = chunk->fContent->GetAt(i);
+         if (haveErrors) {
+            const Double_t err2 = chunk->fSumw2 ? chunk->fSumw2->GetAt(i) : v;
+            (*target->fSumw2)[targetidx] += err2 * c * c;
+         }
+         target->fContent->SetAt(target->fContent->GetAt(targetidx) + c * v, targetidx);
+      }
+   }
+
+   SetEntries(GetEntries() + c * h->GetEntries());
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the content of the filled bin number "idx".
 /// If coord is non-null, it will contain the bin's coordinates for each axis
@@ -792,19 +928,13 @@ Long64_t THnSparse::GetBinIndexForCurrentBin(Bool_t allocate)
    ULong64_t hash = cc->GetHash();
    if (fBinContent.GetSize() && !fBins.GetSize())
       FillExMap();
-   Long64_t linidx = (Long64_t) fBins.GetValue(hash);
-   while (linidx) {
-      // fBins stores index + 1!
-      THnSparseArrayChunk* chunk = GetChunk((linidx - 1)/ fChunkSize);
-      if (chunk->Matches((linidx - 1) % fChunkSize, cc->GetBuffer()))
-         return linidx - 1; // we store idx+1, 0 is "TExMap: not found"
-
-      Long64_t nextlinidx = fBinsContinued.GetValue(linidx);
-      if (!nextlinidx) break;
-
-      linidx = nextlinidx;
-   }
-   if (!allocate) return -1;
+   const Char_t* buf = cc->GetBuffer();
+   Long64_t slot = -1;
+   Long64_t linidx = fBins.Find(hash, [this, buf](Long64_t bin) {
+      return GetChunk(bin / fChunkSize)->Matches(bin % fChunkSize, buf);
+   }, slot);
+   if (linidx >= 0 || !allocate)
+      return linidx;
 
    ++fFilledBins;
 
@@ -819,16 +949,7 @@ Long64_t THnSparse::GetBinIndexForCurrentBin(Bool_t allocate)
 
    // store translation between hash and bin
    newidx += (fBinContent.GetEntriesFast() - 1) * fChunkSize;
-   if (!linidx) {
-      // fBins didn't find it
-      if (2 * GetNbins() > fBins.Capacity())
-         fBins.Expand(3 * GetNbins());
-      fBins.Add(hash, newidx + 1);
-   } else {
-      // fBins contains one, but it's the wrong one;
-      // add entry to fBinsContinued.
-      fBinsContinued.Add(linidx, newidx + 1);
-   }
+   fBins.Insert(hash, newidx, slot);
    return newidx;
 }
 
@@ -880,7 +1001,7 @@ Double_t THnSparse::GetSparseFractionMem() const {
 
    Double_t size = 0.;
    size += fBinContent.GetEntries() * (GetChunkSize() * sizePerChunkElement + sizeof(THnSparseArrayChunk));
-   size += + 3 * sizeof(Long64_t) * fBins.GetSize() /* TExMap */;
+   size += 2 * sizeof(ROOT::Internal::THnSparseBinMap::Slot_t) * fBins.GetCapacity() /* fBins */;
 
    Double_t nbinsTotal = 1.;
    for (Int_t d = 0; d < fNdimensions; ++d)
@@ -962,8 +1083,7 @@ void THnSparse::Sumw2()
 void THnSparse::Reset(Option_t *option /*= ""*/)
 {
    fFilledBins = 0;
-   fBins.Delete();
-   fBinsContinued.Clear();
+   fBins.Clear();
    fBinContent.Delete();
    ResetBase(option);
 }
@@ -42,6 +42,12 @@
 #include "TH1.h"
 #include "TVirtualPad.h"
 #include "TKDE.h"
+#include "TROOT.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#endif
 
 
 ClassImp(TKDE);
@@ -50,6 +56,18 @@ class TKDE::TKernel {
    TKDE* fKDE;
    UInt_t fNWeights; // Number of kernel weights (bandwidth as vectorized for binning)
    std::vector<Double_t> fWeights; // Kernel weights (bandwidth)
+   // For the built-in kernels, which vanish outside of [-fSupport, fSupport], the data points
+   // sorted by position, in blocks of kBlockSize points with their largest bandwidth, so that
+   // only the points close to x are visited
+   enum { kBlockSize = 64 };
+   Double_t fSupport;                   // Support of the kernel function, 0 if unknown
+   Double_t fMaxWeight;                 // Largest bandwidth
+   std::vector<Double_t> fSortedData;   // Data points sorted by position
+   std::vector<Double_t> fSortedCounts; // Bin counts (or event weights) divided by the bandwidth
+   std::vector<Double_t> fSortedWeights; // Bandwidths of the sorted data points
+   std::vector<Double_t> fBlockMaxWeight; // Largest bandwidth of each block of sorted data points
+   void SortData();
+   Double_t SumSorted(Double_t x) const;
 public:
    TKernel(Double_t weight, TKDE* kde);
    void ComputeAdaptiveWeights();
@@ -57,8 +75,32 @@ public:
    Double_t GetWeight(Double_t x) const;
    Double_t GetFixedWeight() const;
    const std::vector<Double_t> & GetAdaptiveWeights() const;
+   Bool_t IsThreadSafe() const { return fSupport > 0; }
 };
 
+namespace {
+
+/// Call f(begin, end) on consecutive ranges covering [0, n), on the implicit
+/// multi-threading pool if it is enabled and parallel is true.
+template <class F>
+void ForEachRange(UInt_t n, Bool_t parallel, F f)
+{
+#ifdef R__USE_IMT
+   const UInt_t chunkSize = 256;
+   if (parallel && n > chunkSize && ROOT::IsImplicitMTEnabled()) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach([&](UInt_t chunk) { f(chunk * chunkSize, std::min(n, (chunk + 1) * chunkSize)); },
+                   ROOT::TSeq<UInt_t>(0, (n + chunkSize - 1) / chunkSize));
+      return;
+   }
+#else
+   (void)parallel;
+#endif
+   f(0, n);
+}
+
+} // unnamed namespace
+
 struct TKDE::KernelIntegrand {
    enum EIntegralResult{kNorm, kMu, kSigma2, kUnitIntegration};
    KernelIntegrand(const TKDE* kde, EIntegralResult intRes);
@@ -699,6 +741,23 @@ Double_t TKDE::operator()(Double_t x) const {
    return (*fKernel)(x);
 }
 
+void TKDE::GetValues(UInt_t n, const Double_t* x, Double_t* values) const {
+   // Returns in values the kernel density estimates at the n points x.
+   // With the built-in kernels, the points are evaluated in parallel if
+   // ROOT implicit multi-threading is enabled.
+   if (!fKernel) {
+      (const_cast<TKDE*>(this))->ReInit();
+      if (!fKernel) {
+         std::fill(values, values + n, TMath::QuietNaN());
+         return;
+      }
+   }
+   ForEachRange(n, fKernel->IsThreadSafe(), [&](UInt_t begin, UInt_t end) {
+      for (UInt_t i = begin; i < end; ++i)
+         values[i] = (*fKernel)(x[i]);
+   });
+}
+
 Double_t TKDE::GetMean() const {
    // return the mean of the data
    if (fNewData) (const_cast<TKDE*>(this))->InitFromNewData();
@@ -721,8 +780,74 @@ TKDE::TKernel::TKernel(Double_t weight, TKDE* kde) :
 // Internal class constructor
 fKDE(kde),
 fNWeights(kde->fData.size()),
-fWeights(fNWeights, weight)
-{}
+fWeights(fNWeights, weight),
+fSupport(0.),
+fMaxWeight(0.)
+{
+   SortData();
+}
+
+void TKDE::TKernel::SortData() {
+   // Sorts the data points with their counts and bandwidths for the evaluation of the
+   // built-in kernels, see SumSorted
+   switch (fKDE->fKernelType) {
+      case kGaussian: fSupport = 9.; break; // as in TKDE::GaussianKernel
+      case kEpanechnikov:
+      case kBiweight:
+      case kCosineArch: fSupport = 1.; break;
+      default: fSupport = 0.;
+   }
+   fSortedData.clear();
+   fSortedCounts.clear();
+   fSortedWeights.clear();
+   fBlockMaxWeight.clear();
+   if (fSupport <= 0.) return;
+
+   UInt_t n = fKDE->fData.size();
+   Bool_t useBins = (fKDE->fBinCount.size() == n);
+   std::vector<UInt_t> order(n);
+   std::iota(order.begin(), order.end(), 0);
+   const std::vector<Double_t> &data = fKDE->fData;
+   std::stable_sort(order.begin(), order.end(), [&data](UInt_t i, UInt_t j) { return data[i] < data[j]; });
+   fSortedData.resize(n);
+   fSortedCounts.resize(n);
+   fSortedWeights.resize(n);
+   for (UInt_t i = 0; i < n; ++i) {
+      fSortedData[i] = data[order[i]];
+      fSortedWeights[i] = fWeights[order[i]];
+      fSortedCounts[i] = ((useBins) ? fKDE->fBinCount[order[i]] : 1.0) / fWeights[order[i]];
+   }
+   fBlockMaxWeight.resize((n + kBlockSize - 1) / kBlockSize);
+   for (UInt_t b = 0; b < fBlockMaxWeight.size(); ++b) {
+      auto first = fSortedWeights.begin() + b * kBlockSize;
+      fBlockMaxWeight[b] = *std::max_element(first, first + std::min<UInt_t>(kBlockSize, n - b * kBlockSize));
+   }
+   fMaxWeight = fBlockMaxWeight.empty() ? 0. : *std::max_element(fBlockMaxWeight.begin(), fBlockMaxWeight.end());
+}
+
+Double_t TKDE::TKernel::SumSorted(Double_t x) const {
+   // Returns the sum of the kernels of the data points at x, visiting only the blocks
+   // of sorted data points which can be within the support of their kernel
+   const Double_t reach = fSupport * fMaxWeight;
+   const UInt_t first = std::lower_bound(fSortedData.begin(), fSortedData.end(), x - reach) - fSortedData.begin();
+   const UInt_t last = std::upper_bound(fSortedData.begin(), fSortedData.end(), x + reach) - fSortedData.begin();
+   const ROOT::Math::IBaseFunctionOneDim &kernel = *fKDE->fKernelFunction;
+   Double_t result = 0.;
+   for (UInt_t i = first; i < last;) {
+      const UInt_t end = std::min(last, (i / kBlockSize + 1) * kBlockSize);
+      const Double_t blockReach = fSupport * fBlockMaxWeight[i / kBlockSize];
+      if (fSortedData[i] - x < blockReach && x - fSortedData[end - 1] < blockReach) {
+         for (UInt_t j = i; j < end; ++j) {
+            const Double_t w = fSortedWeights[j];
+            const Double_t u = (x - fSortedData[j]) / w;
+            if (std::abs(u) < fSupport)
+               result += fSortedCounts[j] * kernel(u);
+         }
+      }
+      i = end;
+   }
+   return result;
+}
 
 void TKDE::TKernel::ComputeAdaptiveWeights() {
    // Gets the adaptive weights (bandwidths) for TKernel internal computation
@@ -731,11 +856,19 @@ void TKDE::TKernel::ComputeAdaptiveWeights() {
    unsigned int n = fKDE->fData.size();
    assert( n == weights.size() );
    bool useDataWeights = (fKDE->fBinCount.size() == n); 
+   // the pilot (fixed bandwidth) estimate at all data points, in parallel if possible
+   std::vector<Double_t> pilot(n);
+   ForEachRange(n, IsThreadSafe(), [&](UInt_t begin, UInt_t end) {
+      for (UInt_t i = begin; i < end; ++i) {
+         if (!useDataWeights || fKDE->fBinCount[i] > 0)
+            pilot[i] = (*this)(fKDE->fData[i]);
+      }
+   });
    Double_t f = 0.0;
    for (unsigned int i = 0; i < n; ++i) { 
 //   for (; weight != weights.end(); ++weight, ++data, ++dataW) {
       if (useDataWeights && fKDE->fBinCount[i] <= 0) continue;  // skip negative or null weights
-      f = (*fKDE->fKernel)(fKDE->fData[i]);
+      f = pilot[i];
       if (f <= 0)
          fKDE->Warning("ComputeAdativeWeights","function value is zero or negative for x = %f w = %f",
                        fKDE->fData[i],(useDataWeights) ? fKDE->fBinCount[i] : 1.);
@@ -747,6 +880,7 @@ void TKDE::TKernel::ComputeAdaptiveWeights() {
    fKDE->fAdaptiveBandwidthFactor = fKDE->fUseMirroring ? kAPPROX_GEO_MEAN / fKDE->fSigmaRob : std::sqrt(std::exp(fKDE->fAdaptiveBandwidthFactor / fKDE->fData.size()));
    transform(weights.begin(), weights.end(), fWeights.begin(),
              std::bind(std::multiplies<Double_t>(), std::placeholders::_1, fKDE->fAdaptiveBandwidthFactor));
+   SortData();
    //printf("adaptive bandwidth factor % f weight 0 %f , %f \n",fKDE->fAdaptiveBandwidthFactor, weights[0],fWeights[0] );
 }
 
@@ -870,7 +1004,9 @@ TGraphErrors* TKDE::GetGraphWithErrors(UInt_t npx, double xmin, double xmax) {
    Double_t* ey = new Double_t[n + 1];
    for (UInt_t i = 0; i <= n; ++i) {
       x[i] = xmin + i * (xmax - xmin) / n;
-      y[i] = (*this)(x[i]);
+   }
+   GetValues(n + 1, x, y);
+   for (UInt_t i = 0; i <= n; ++i) {
       ex[i] = 0;
       ey[i] = this->GetError(x[i]);
    }
@@ -937,6 +1073,17 @@ Double_t TKDE::TKernel::operator()(Double_t x) const {
    // case of bins or weighted data 
    Bool_t useBins = (fKDE->fBinCount.size() == n);
    Double_t nSum = (useBins) ? fKDE->fSumOfCounts : fKDE->fNEvents;
+   if (fSupport > 0.) {
+      // built-in kernels are symmetric: the mirrored data points contribute at x
+      // as the data points at the mirror image of x
+      result = SumSorted(x);
+      if (fKDE->fAsymLeft) result -= SumSorted(2. * fKDE->fXMin - x);
+      if (fKDE->fAsymRight) result -= SumSorted(2. * fKDE->fXMax - x);
+      if ( TMath::IsNaN(result) ) {
+         fKDE->Warning("operator()","Result is NaN for  x %f \n",x);
+      }
+      return result / nSum;
+   }
    // double dmin = 1.E10;
    // double xmin,bmin,wmin; 
    for (UInt_t i = 0; i < n; ++i) {
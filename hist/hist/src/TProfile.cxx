@@ -786,28 +786,37 @@ void TProfile::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const D
          return;
    }
 
-   for (i=ifirst;i<ntimes;i+=stride) {
-      if (fYmin != fYmax) {
-         if (y[i] <fYmin || y[i]> fYmax || TMath::IsNaN(y[i])) continue;
-      }
+   // Unless the axis can be extended, look up the bins of a whole chunk at once
+   const Bool_t batch = !fXaxis.CanExtend();
+   Int_t bins[fgFillNChunk];
+   const Int_t chunk = fgFillNChunk*stride;
+   for (Int_t first=ifirst;first<ntimes;first+=chunk) {
+      const Int_t last = TMath::Min(first+chunk, ntimes);
+      if (batch) fXaxis.FindFixBins((last-first)/stride, &x[first], bins, stride);
+      Int_t j;
+      for (i=first,j=0;i<last;i+=stride,++j) {
+         if (fYmin != fYmax) {
+            if (y[i] <fYmin || y[i]> fYmax || TMath::IsNaN(y[i])) continue;
+         }
 
-      Double_t u = (w) ? w[i] : 1; // (w[i] > 0 ? w[i] : -w[i]);
-      fEntries++;
-      bin =fXaxis.FindBin(x[i]);
-      AddBinContent(bin, u*y[i]);
-      fSumw2.fArray[bin] += u*y[i]*y[i];
-      if (!fBinSumw2.fN && u != 1.0 && !TestBit(TH1::kIsNotW))  Sumw2();  // must be called before accumulating the entries
-      if (fBinSumw2.fN)  fBinSumw2.fArray[bin] += u*u;
-      fBinEntries.fArray[bin] += u;
-      if (bin == 0 || bin > fXaxis.GetNbins()) {
-         if (!GetStatOverflowsBehaviour()) continue;
+         Double_t u = (w) ? w[i] : 1; // (w[i] > 0 ? w[i] : -w[i]);
+         fEntries++;
+         bin = batch ? bins[j] : fXaxis.FindBin(x[i]);
+         AddBinContent(bin, u*y[i]);
+         fSumw2.fArray[bin] += u*y[i]*y[i];
+         if (!fBinSumw2.fN && u != 1.0 && !TestBit(TH1::kIsNotW))  Sumw2();  // must be called before accumulating the entries
+         if (fBinSumw2.fN)  fBinSumw2.fArray[bin] += u*u;
+         fBinEntries.fArray[bin] += u;
+         if (bin == 0 || bin > fXaxis.GetNbins()) {
+            if (!GetStatOverflowsBehaviour()) continue;
+         }
+         fTsumw   += u;
+         fTsumw2  += u*u;
+         fTsumwx  += u*x[i];
+         fTsumwx2 += u*x[i]*x[i];
+         fTsumwy  += u*y[i];
+         fTsumwy2 += u*y[i]*y[i];
       }
-      fTsumw   += u;
-      fTsumw2  += u*u;
-      fTsumwx  += u*x[i];
-      fTsumwx2 += u*x[i]*x[i];
-      fTsumwy  += u*y[i];
-      fTsumwy2 += u*y[i]*y[i];
    }
 }
 
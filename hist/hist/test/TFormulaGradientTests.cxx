@@ -21,6 +21,9 @@
 #include <TFormula.h>
 #include <TF1.h>
 #include <TFitResult.h>
+#include <TH1.h>
+
+#include <cmath>
 
 TEST(TFormulaGradientPar, Sanity)
 {
@@ -129,6 +132,49 @@ TEST(TFormulaGradientPar, BreitWignerCrossCheckAccuracyDemo)
    EXPECT_NEAR(0, result_num[2], /*abs_error*/1e-13);
 }
 
+TEST(TFormulaGradientPar, TF1GradientParUsesGenerated)
+{
+   TF1 f1("f1", "[0]*exp(-0.5*((x-[1])/[2])*((x-[1])/[2]))");
+   double p[] = {3, 1, 2};
+   f1.SetParameters(p);
+   f1.FixParameter(1, 1);
+   ASSERT_TRUE(f1.GetFormula()->GenerateGradientPar());
+   ASSERT_TRUE(f1.GetFormula()->HasGeneratedGradient());
+
+   double x[] = {0.5};
+   double grad[3] = {-1, -1, -1};
+   f1.GradientPar(x, grad);
+   const double e = std::exp(-0.5 * 0.0625);
+   EXPECT_NEAR(e, grad[0], 1e-12);
+   // fixed parameter
+   EXPECT_EQ(0, grad[1]);
+   EXPECT_NEAR(3 * e * 0.25 / 8, grad[2], 1e-12);
+   EXPECT_DOUBLE_EQ(grad[2], f1.GradientPar(2, x));
+}
+
+TEST(TFormulaGradientPar, FitWithGradient)
+{
+   TH1D h("h", "h", 50, -5, 5);
+   for (int i = 1; i <= 50; ++i) {
+      const double x = h.GetBinCenter(i);
+      h.SetBinContent(i, 100 * std::exp(-0.5 * (x - 0.3) * (x - 0.3) / 1.44) + 1 + (i % 3));
+      h.SetBinError(i, std::sqrt(h.GetBinContent(i)));
+   }
+
+   TF1 fnum("fnum", "[0]*exp(-0.5*((x-[1])/[2])*((x-[1])/[2]))", -5, 5);
+   TF1 fgrad("fgrad", "[0]*exp(-0.5*((x-[1])/[2])*((x-[1])/[2]))", -5, 5);
+   fnum.SetParameters(80, 0, 1);
+   fgrad.SetParameters(80, 0, 1);
+
+   auto rnum = h.Fit(&fnum, "Q N S");
+   auto rgrad = h.Fit(&fgrad, "Q N S G");
+   ASSERT_EQ(0, rnum->Status());
+   ASSERT_EQ(0, rgrad->Status());
+   EXPECT_TRUE(fgrad.GetFormula()->HasGeneratedGradient());
+   for (int i = 0; i < 3; ++i)
+      EXPECT_NEAR(rnum->Parameter(i), rgrad->Parameter(i), 1e-2 * rnum->ParError(i));
+}
+
 // FIXME: Add more: crystalball, cheb3, bigaus?
 
 // FIXME: Disable because of a known failure in -Druntime_cxxmodules=On.
@@ -1,8 +1,14 @@
 #include "gtest/gtest.h"
 
 #include "THn.h"
+#include "THnSparse.h"
 #include "TH1.h"
 #include "TH2.h"
+#include "TList.h"
+#include "TRandom3.h"
+
+#include <memory>
+#include <vector>
 
 // Filling THn
 TEST(THn, Fill) {
@@ -111,3 +117,83 @@ TEST(THn, Projection) {
    }
 
 }
+
+
+// Compare all bins of two THnSparse, independently of their bin order
+static void ExpectSameBins(const THnSparse &expected, const THnSparse &actual)
+{
+   ASSERT_EQ(expected.GetNbins(), actual.GetNbins());
+   std::vector<Int_t> coord(expected.GetNdimensions());
+   for (Long64_t i = 0; i < expected.GetNbins(); ++i) {
+      Double_t v = expected.GetBinContent(i, coord.data());
+      Long64_t bin = actual.GetBin(coord.data());
+      ASSERT_GE(bin, 0);
+      EXPECT_DOUBLE_EQ(v, actual.GetBinContent(bin));
+      EXPECT_DOUBLE_EQ(expected.GetBinError2(i), actual.GetBinError2(bin));
+   }
+   EXPECT_DOUBLE_EQ(expected.GetEntries(), actual.GetEntries());
+}
+
+// 8 dimensions of 1000 bins: the compact coordinates do not fit into 8 bytes
+static THnSparseD *MakeSparse(const char *name)
+{
+   Int_t bins[8];
+   Double_t xmin[8];
+   Double_t xmax[8];
+   for (Int_t d = 0; d < 8; ++d) {
+      bins[d] = 1000;
+      xmin[d] = -5.;
+      xmax[d] = 5.;
+   }
+   auto h = new THnSparseD(name, name, 8, bins, xmin, xmax, 1024);
+   h->Sumw2();
+   return h;
+}
+
+TEST(THnSparse, FillN) {
+   TRandom3 rnd(42);
+   const Long64_t n = 20000;
+   std::vector<Double_t> x(8 * n), w(n);
+   for (Long64_t i = 0; i < n; ++i) {
+      for (Int_t d = 0; d < 8; ++d)
+         x[8 * i + d] = rnd.Gaus(0., d < 6 ? 0.01 : 2.); // many repeated bins
+      w[i] = rnd.Uniform();
+   }
+
+   std::unique_ptr<THnSparseD> serial(MakeSparse("serial"));
+   std::unique_ptr<THnSparseD> batched(MakeSparse("batched"));
+   for (Long64_t i = 0; i < n; ++i)
+      serial->Fill(&x[8 * i], w[i]);
+   batched->FillN(n, x.data(), w.data());
+
+   ExpectSameBins(*serial, *batched);
+   EXPECT_DOUBLE_EQ(serial->GetSumw(), batched->GetSumw());
+   EXPECT_DOUBLE_EQ(serial->GetSumwx(7), batched->GetSumwx(7));
+}
+
+TEST(THnSparse, Merge) {
+   TRandom3 rnd(7);
+   std::unique_ptr<THnSparseD> all(MakeSparse("all"));
+   std::unique_ptr<THnSparseD> merged(MakeSparse("merged"));
+   TList parts;
+   parts.SetOwner();
+   for (Int_t p = 0; p < 3; ++p) {
+      THnSparseD *part = MakeSparse(Form("part%d", p));
+      Double_t x[8];
+      for (Int_t i = 0; i < 5000; ++i) {
+         for (Int_t d = 0; d < 8; ++d)
+            x[d] = rnd.Gaus(0., d < 6 ? 0.01 : 2.);
+         part->Fill(x, 0.5 + p);
+         all->Fill(x, 0.5 + p);
+      }
+      parts.Add(part);
+   }
+   merged->Merge(&parts);
+   ExpectSameBins(*all, *merged);
+
+   // After a reset, the bin lookup must start from scratch
+   merged->Reset();
+   EXPECT_EQ(0, merged->GetNbins());
+   Int_t coord[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+   EXPECT_EQ(-1, merged->GetBin(coord, kFALSE));
+}
@@ -0,0 +1,120 @@
+#include "TH1ConcurrentFiller.h"
+#include "THnConcurrentFiller.h"
+
+#include "TH1.h"
+#include "TH2.h"
+#include "THn.h"
+#include "TRandom3.h"
+
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+static constexpr int kNThreads = 4;
+static constexpr int kNPerThread = 20000;
+
+TEST(TH1ConcurrentFiller, MatchesSerialFill)
+{
+   TH2D serial("serial", "", 20, -3, 3, 10, -3, 3);
+   TH2D concurrent("concurrent", "", 20, -3, 3, 10, -3, 3);
+   serial.Sumw2();
+
+   std::vector<std::vector<double>> xs(kNThreads), ys(kNThreads), ws(kNThreads);
+   TRandom3 rnd(1);
+   for (int t = 0; t < kNThreads; ++t) {
+      for (int i = 0; i < kNPerThread; ++i) {
+         xs[t].push_back(rnd.Gaus());
+         ys[t].push_back(rnd.Gaus());
+         // dyadic weights, so that the sums do not depend on the order of the additions
+         ws[t].push_back(rnd.Integer(8) * 0.25);
+         serial.Fill(xs[t][i], ys[t][i], ws[t][i]);
+      }
+   }
+
+   {
+      ROOT::TH1ConcurrentFiller filler(concurrent);
+      std::vector<std::thread> threads;
+      for (int t = 0; t < kNThreads; ++t)
+         threads.emplace_back([&, t] {
+            for (int i = 0; i < kNPerThread; ++i)
+               filler.Fill(xs[t][i], ys[t][i], ws[t][i]);
+         });
+      for (auto &thread : threads)
+         thread.join();
+   }
+
+   for (int bin = 0; bin < serial.GetNcells(); ++bin) {
+      EXPECT_EQ(serial.GetBinContent(bin), concurrent.GetBinContent(bin));
+      EXPECT_EQ(serial.GetBinError(bin), concurrent.GetBinError(bin));
+   }
+   EXPECT_EQ(serial.GetEntries(), concurrent.GetEntries());
+   double sSerial[7], sConcurrent[7];
+   serial.GetStats(sSerial);
+   concurrent.GetStats(sConcurrent);
+   for (int i = 0; i < 7; ++i)
+      EXPECT_NEAR(sSerial[i], sConcurrent[i], 1e-9 * std::abs(sSerial[i]));
+}
+
+TEST(TH1ConcurrentFiller, IntegerBins)
+{
+   TH1I h("h", "", 4, 0, 4);
+   {
+      ROOT::TH1ConcurrentFiller filler(h);
+      std::vector<std::thread> threads;
+      for (int t = 0; t < kNThreads; ++t)
+         threads.emplace_back([&] {
+            for (int i = 0; i < kNPerThread; ++i)
+               filler.Fill(i % 4 + 0.5);
+         });
+      for (auto &thread : threads)
+         thread.join();
+   }
+   for (int bin = 1; bin <= 4; ++bin)
+      EXPECT_EQ(kNThreads * kNPerThread / 4, h.GetBinContent(bin));
+   EXPECT_EQ(kNThreads * kNPerThread, h.GetEntries());
+}
+
+TEST(THnConcurrentFiller, MatchesSerialFill)
+{
+   Int_t bins[3] = {10, 5, 8};
+   Double_t min[3] = {-3, -3, -3};
+   Double_t max[3] = {3, 3, 3};
+   THnD serial("serial", "", 3, bins, min, max);
+   THnD concurrent("concurrent", "", 3, bins, min, max);
+   serial.Sumw2();
+   concurrent.Sumw2();
+
+   std::vector<std::vector<double>> xs(kNThreads);
+   TRandom3 rnd(2);
+   for (int t = 0; t < kNThreads; ++t) {
+      for (int i = 0; i < kNPerThread; ++i) {
+         double x[3] = {rnd.Gaus(), rnd.Gaus(), rnd.Gaus()};
+         xs[t].insert(xs[t].end(), x, x + 3);
+         serial.Fill(x, 0.5);
+      }
+   }
+
+   {
+      ROOT::THnConcurrentFiller filler(concurrent);
+      std::vector<std::thread> threads;
+      for (int t = 0; t < kNThreads; ++t)
+         threads.emplace_back([&, t] {
+            for (int i = 0; i < kNPerThread; ++i)
+               filler.Fill(&xs[t][3 * i], 0.5);
+         });
+      for (auto &thread : threads)
+         thread.join();
+   }
+
+   for (Long64_t bin = 0; bin < serial.GetNbins(); ++bin) {
+      EXPECT_EQ(serial.GetBinContent(bin), concurrent.GetBinContent(bin));
+      EXPECT_EQ(serial.GetBinError2(bin), concurrent.GetBinError2(bin));
+   }
+   EXPECT_EQ(serial.GetEntries(), concurrent.GetEntries());
+   EXPECT_EQ(serial.GetSumw(), concurrent.GetSumw());
+   EXPECT_EQ(serial.GetSumw2(), concurrent.GetSumw2());
+   for (int d = 0; d < 3; ++d)
+      EXPECT_NEAR(serial.GetSumwx(d), concurrent.GetSumwx(d), 1e-9 * serial.GetSumw());
+}
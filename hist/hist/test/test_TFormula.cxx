@@ -1,9 +1,64 @@
 #include "gtest/gtest.h"
 
 #include "TFormula.h"
+#include "TF1.h"
+#include "TF2.h"
+
+#include <vector>
 
 // Test that autoloading works (ROOT-9840)
 TEST(TFormula, Interp)
 {
   TFormula f("func", "TGeoBBox::DeclFileLine()");
 }
+
+// Batch evaluation gives the same results as EvalPar, also for a second
+// formula with the same expression sharing the generated evaluator.
+TEST(TFormula, EvalParBatch)
+{
+  TFormula f1("f1", "[0]*exp(-0.5*((x-[1])/[2])^2) + [3]*y");
+  TFormula f2("f2", "[0]*exp(-0.5*((x-[1])/[2])^2) + [3]*y");
+  const double params[] = {2., 0.5, 1.5, -0.25};
+  f1.SetParameters(params);
+
+  const Long64_t n = 37;
+  std::vector<double> x(2 * n), result1(n), result2(n);
+  for (Long64_t i = 0; i < n; ++i) {
+    x[i] = -3. + 0.2 * i;
+    x[i + n] = 0.1 * i;
+  }
+  f1.EvalParBatch(n, x.data(), result1.data());
+  f2.EvalParBatch(n, x.data(), result2.data(), params);
+  for (Long64_t i = 0; i < n; ++i) {
+    const double xi[] = {x[i], x[i + n]};
+    EXPECT_DOUBLE_EQ(f1.EvalPar(xi), result1[i]);
+    EXPECT_DOUBLE_EQ(f1.EvalPar(xi), result2[i]);
+  }
+}
+
+// Functions of different dimension with the same expression need their own
+// batch evaluators, since the coordinates of a point are read per dimension.
+TEST(TFormula, EvalParBatchDimensions)
+{
+  TF2 f2("batchDim2", "[0]*x + [1]", -10, 10, -10, 10);
+  TF1 f1("batchDim1", "[0]*x + [1]", -10, 10);
+  const double params[] = {1.5, -0.5};
+  f1.SetParameters(params);
+  f2.SetParameters(params);
+
+  const Long64_t n = 21;
+  std::vector<double> x(2 * n), result1(n), result2(n);
+  for (Long64_t i = 0; i < n; ++i) {
+    x[i] = -5. + 0.5 * i;
+    x[i + n] = 100. + i;
+  }
+  f2.EvalParBatch(n, x.data(), result2.data());
+  // f1 only gets the first n coordinates
+  std::vector<double> x1(x.begin(), x.begin() + n);
+  f1.EvalParBatch(n, x1.data(), result1.data());
+  for (Long64_t i = 0; i < n; ++i) {
+    const double xi[] = {x[i], x[i + n]};
+    EXPECT_DOUBLE_EQ(f1.EvalPar(xi), result1[i]);
+    EXPECT_DOUBLE_EQ(f2.EvalPar(xi), result2[i]);
+  }
+}
@@ -2,6 +2,12 @@
 
 #include "TH1.h"
 #include "TH1F.h"
+#include "TH2D.h"
+#include "TH3D.h"
+#include "TRandom3.h"
+
+#include <cmath>
+#include <vector>
 
 // StatOverflows TH1
 TEST(TH1, StatOverflows)
@@ -30,3 +36,50 @@ TEST(TH1, StatOverflows)
    EXPECT_EQ(TH1::EStatOverflows::kConsider, h1.GetStatOverflows());
    EXPECT_EQ(TH1::EStatOverflows::kNeutral,  h2.GetStatOverflows());
 }
+
+// FillN with batch bin lookup gives the same result as repeated calls to Fill
+TEST(TH1, FillNMatchesFill)
+{
+   const Int_t n = 1000;
+   TRandom3 rng(1);
+   std::vector<Double_t> x(3 * n), w(3 * n);
+   for (auto &v : x)
+      v = rng.Uniform(-1, 11);
+   for (auto &v : w)
+      v = rng.Uniform(0.5, 2);
+   x[0] = NAN;
+   x[3] = 0;
+   x[6] = 10;
+
+   const Double_t edges[] = {0, 0.5, 1, 2, 3.5, 5, 8, 10};
+   TH1D fixed("fixed", "", 20, 0, 10), fixedN("fixedN", "", 20, 0, 10);
+   TH1D var("var", "", 7, edges), varN("varN", "", 7, edges);
+   for (Int_t i = 0; i < n; ++i) {
+      fixed.Fill(x[3 * i], w[3 * i]);
+      var.Fill(x[3 * i], w[3 * i]);
+   }
+   fixedN.FillN(n, x.data(), w.data(), 3);
+   varN.FillN(n, x.data(), w.data(), 3);
+   for (Int_t bin = 0; bin <= 21; ++bin) {
+      EXPECT_DOUBLE_EQ(fixed.GetBinContent(bin), fixedN.GetBinContent(bin));
+      EXPECT_DOUBLE_EQ(fixed.GetBinError(bin), fixedN.GetBinError(bin));
+   }
+   for (Int_t bin = 0; bin <= 8; ++bin)
+      EXPECT_DOUBLE_EQ(var.GetBinContent(bin), varN.GetBinContent(bin));
+   EXPECT_DOUBLE_EQ(fixed.GetMean(), fixedN.GetMean());
+   EXPECT_DOUBLE_EQ(var.GetEntries(), varN.GetEntries());
+
+   TH2D h2("h2", "", 10, 0, 10, 7, edges), h2N("h2N", "", 10, 0, 10, 7, edges);
+   TH3D h3("h3", "", 7, edges, 7, edges, 7, edges), h3N("h3N", "", 7, edges, 7, edges, 7, edges);
+   for (Int_t i = 0; i < n; ++i) {
+      h2.Fill(x[3 * i], x[3 * i + 1], w[3 * i]);
+      h3.Fill(x[3 * i], x[3 * i + 1], x[3 * i + 2], w[3 * i]);
+   }
+   h2N.FillN(n, &x[0], &x[1], w.data(), 3);
+   h3N.FillN(n, &x[0], &x[1], &x[2], w.data(), 3);
+   for (Int_t bin = 0; bin < h2.GetNcells(); ++bin)
+      EXPECT_DOUBLE_EQ(h2.GetBinContent(bin), h2N.GetBinContent(bin));
+   for (Int_t bin = 0; bin < h3.GetNcells(); ++bin)
+      EXPECT_DOUBLE_EQ(h3.GetBinContent(bin), h3N.GetBinContent(bin));
+   EXPECT_DOUBLE_EQ(h3.GetMean(3), h3N.GetMean(3));
+}
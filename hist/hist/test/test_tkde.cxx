@@ -8,6 +8,7 @@
 #include "TVirtualPad.h"
 #include "TF1.h"
 #include "TH1.h"
+#include "TMath.h"
 
 struct  TestKDE  {
 
@@ -209,3 +210,47 @@ TEST(TKDE, tkde_io_binned)
    }
 }
 
+
+/// Evaluation tests
+/// Compare the estimates with the kernel sum over all the events, and the
+/// values at many points with the single point evaluation
+TEST(TKDE, tkde_values)
+{
+   const int n = 5000;
+   std::vector<double> v(n);
+   for (auto &x : v)
+      x = gRandom->Gaus(10, 3);
+
+   for (TString mirror : {"noMirror", "MirrorAsymLeft"}) {
+      TKDE kde(n, v.data(), 0., 20., "KernelType:Gaussian;Iteration:Fixed;Binning:Unbinned;Mirror:" + mirror, 1);
+      const double h = kde.GetFixedWeight();
+      auto kernel = [h](double u) { return TMath::Gaus(u, 0, h, true); };
+
+      std::vector<double> xtest, values(101);
+      for (int i = 0; i <= 100; ++i)
+         xtest.push_back(0.2 * i);
+      kde.GetValues(xtest.size(), xtest.data(), values.data());
+
+      for (size_t i = 0; i < xtest.size(); ++i) {
+         double expected = 0;
+         for (double x : v) {
+            expected += kernel(xtest[i] - x);
+            if (mirror == "MirrorAsymLeft")
+               expected -= kernel(xtest[i] + x);
+         }
+         expected /= n;
+         EXPECT_NEAR(kde(xtest[i]), expected, 1.E-12 + 1.E-9 * expected) << mirror << " at x = " << xtest[i];
+         EXPECT_DOUBLE_EQ(values[i], kde(xtest[i]));
+      }
+   }
+
+   // adaptive and binned estimates
+   TKDE adaptive(n, v.data(), 0., 20., "KernelType:Epanechnikov;Iteration:Adaptive;Binning:ForcedBinning", 1);
+   std::vector<double> xtest{1., 5., 9.5, 10., 12.3, 19.};
+   std::vector<double> values(xtest.size());
+   adaptive.GetValues(xtest.size(), xtest.data(), values.data());
+   for (size_t i = 0; i < xtest.size(); ++i) {
+      EXPECT_DOUBLE_EQ(values[i], adaptive(xtest[i]));
+      EXPECT_GT(values[i], 0.);
+   }
+}
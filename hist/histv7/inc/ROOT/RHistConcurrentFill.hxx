@@ -17,9 +17,22 @@
 #define ROOT7_RHistConcurrentFill
 
 #include "ROOT/RSpan.hxx"
+#include "ROOT/RHist.hxx"
 #include "ROOT/RHistBufferedFill.hxx"
 
+#include "RConfigure.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#include "TROOT.h"
+#endif
+
+#include <algorithm>
+#include <memory>
 #include <mutex>
+#include <thread>
+#include <vector>
 
 namespace ROOT {
 namespace Experimental {
@@ -106,6 +119,349 @@ public:
    }
 };
 
+
+template <class HIST>
+class RHistPerThreadFillManager;
+
+/**
+ \class RHistPerThreadFiller
+ Fills a partial histogram private to this filler, owned by the
+ RHistPerThreadFillManager that created it. Must only be used by one thread at
+ a time; it can be moved, but not copied. On destruction, the partial
+ histogram is handed back to the manager for the next filler.
+ **/
+
+template <class HIST>
+class RHistPerThreadFiller {
+   RHistPerThreadFillManager<HIST> *fManager; ///< The manager; nullptr if moved from.
+   HIST *fPartial;                            ///< The partial histogram, owned by the manager.
+
+public:
+   using CoordArray_t = typename HIST::CoordArray_t;
+   using Weight_t = typename HIST::Weight_t;
+
+   RHistPerThreadFiller(RHistPerThreadFillManager<HIST> &manager, HIST &partial)
+      : fManager(&manager), fPartial(&partial)
+   {
+   }
+   RHistPerThreadFiller(const RHistPerThreadFiller &) = delete;
+   RHistPerThreadFiller(RHistPerThreadFiller &&other): fManager(other.fManager), fPartial(other.fPartial)
+   {
+      other.fManager = nullptr;
+   }
+   RHistPerThreadFiller &operator=(const RHistPerThreadFiller &) = delete;
+   RHistPerThreadFiller &operator=(RHistPerThreadFiller &&other)
+   {
+      if (this != &other) {
+         if (fManager)
+            fManager->Release(*fPartial);
+         fManager = other.fManager;
+         fPartial = other.fPartial;
+         other.fManager = nullptr;
+      }
+      return *this;
+   }
+   ~RHistPerThreadFiller()
+   {
+      if (fManager)
+         fManager->Release(*fPartial);
+   }
+
+   /// Thread-specific HIST::Fill().
+   void Fill(const CoordArray_t &x, Weight_t weight = 1.) { fPartial->Fill(x, weight); }
+
+   /// Thread-specific HIST::FillN().
+   void FillN(const std::span<const CoordArray_t> xN, const std::span<const Weight_t> weightN)
+   {
+      fPartial->FillN(xN, weightN);
+   }
+
+   /// Thread-specific HIST::FillN().
+   void FillN(const std::span<const CoordArray_t> xN) { fPartial->FillN(xN); }
+
+   static constexpr int GetNDim() { return HIST::GetNDim(); }
+};
+
+/**
+ \class RHistPerThreadFillManager
+ Fills a histogram from many threads without any synchronization while filling.
+
+ Each RHistPerThreadFiller handed out by MakeFiller() fills its own partial
+ histogram, with the axes of the managed histogram. When a filler is
+ destroyed, its partial histogram (with its content) is reused by the next
+ filler, so the number of partial histograms is the largest number of fillers
+ alive at the same time, typically the number of threads, also for callers
+ creating one filler per task. Flush() adds the partial histograms pairwise in
+ a tree, with the additions of each level running on the implicit
+ multi-threading pool if enabled, adds the result to the managed histogram and
+ clears the partial histograms. It is called by the destructor; fillers must
+ not outlive the manager.
+
+ Fillers must not fill while Flush() runs. See RHistShardedFillManager for
+ histograms with very many bins.
+ **/
+
+template <class HIST>
+class RHistPerThreadFillManager {
+   friend class RHistPerThreadFiller<HIST>;
+
+public:
+   using Hist_t = HIST;
+   using CoordArray_t = typename HIST::CoordArray_t;
+   using Weight_t = typename HIST::Weight_t;
+
+private:
+   HIST &fHist;
+   std::vector<std::unique_ptr<HIST>> fPartials; ///< All partial histograms.
+   std::vector<HIST *> fFree;                    ///< Partial histograms not used by a filler.
+   std::mutex fMutex;                            ///< Protects fPartials and fFree.
+
+   /// Set all bins and statistics of `hist` to zero.
+   static void Clear(HIST &hist)
+   {
+      auto &impl = *hist.GetImpl();
+      impl.GetStat() = typename HIST::ImplBase_t::Stat_t(impl.GetNBinsNoOver(), impl.GetNOverflowBins());
+   }
+
+   /// Called by a filler on destruction: make its partial histogram available to the next filler.
+   void Release(HIST &partial)
+   {
+      std::lock_guard<std::mutex> lockGuard(fMutex);
+      fFree.push_back(&partial);
+   }
+
+public:
+   RHistPerThreadFillManager(HIST &hist): fHist(hist) {}
+   ~RHistPerThreadFillManager() { Flush(); }
+
+   /// Create a filler, with a partial histogram released by an earlier filler or a new one.
+   RHistPerThreadFiller<HIST> MakeFiller()
+   {
+      {
+         std::lock_guard<std::mutex> lockGuard(fMutex);
+         if (!fFree.empty()) {
+            HIST *partial = fFree.back();
+            fFree.pop_back();
+            return RHistPerThreadFiller<HIST>{*this, *partial};
+         }
+      }
+      std::unique_ptr<HIST> partial(new HIST(fHist));
+      Clear(*partial);
+      HIST &ref = *partial;
+      std::lock_guard<std::mutex> lockGuard(fMutex);
+      fPartials.emplace_back(std::move(partial));
+      return RHistPerThreadFiller<HIST>{*this, ref};
+   }
+
+   /// Number of partial histograms created so far.
+   size_t GetNPartials()
+   {
+      std::lock_guard<std::mutex> lockGuard(fMutex);
+      return fPartials.size();
+   }
+
+   /// Add all partial histograms to the managed histogram, and clear them.
+   void Flush()
+   {
+      std::lock_guard<std::mutex> lockGuard(fMutex);
+      const size_t n = fPartials.size();
+      for (size_t stride = 1; stride < n; stride *= 2) {
+         // Additions of this level, on disjoint pairs of partial histograms.
+         const size_t nAdds = (n - stride + 2 * stride - 1) / (2 * stride);
+         auto addPair = [this, stride](unsigned int k) {
+            Add(*fPartials[2 * stride * k], *fPartials[2 * stride * k + stride]);
+         };
+#ifdef R__USE_IMT
+         if (nAdds > 1 && ROOT::IsImplicitMTEnabled()) {
+            ROOT::TThreadExecutor pool;
+            pool.Foreach(addPair, ROOT::TSeqU(nAdds));
+            continue;
+         }
+#endif
+         for (size_t k = 0; k < nAdds; ++k)
+            addPair(k);
+      }
+      if (n)
+         Add(fHist, *fPartials[0]);
+      for (auto &partial: fPartials)
+         Clear(*partial);
+   }
+};
+
+template <class HIST, int SIZE>
+class RHistShardedFillManager;
+
+/**
+ \class RHistShardedFiller
+ Buffers a thread's Fill calls per bin range, and submits each buffer to the
+ shard of the RHistShardedFillManager that owns the bin range. Must only be
+ used by one thread at a time; it can be moved, but not copied.
+ **/
+
+template <class HIST, int SIZE>
+class RHistShardedFiller {
+public:
+   using CoordArray_t = typename HIST::CoordArray_t;
+   using Weight_t = typename HIST::Weight_t;
+   using Manager_t = RHistShardedFillManager<HIST, SIZE>;
+   using Entry_t = typename Manager_t::Entry_t;
+
+private:
+   Manager_t *fManager;                       ///< The manager; nullptr if moved from.
+   std::vector<std::vector<Entry_t>> fBuffers; ///< Pending entries, per shard.
+
+public:
+   explicit RHistShardedFiller(Manager_t &manager): fManager(&manager), fBuffers(manager.GetNShards()) {}
+   RHistShardedFiller(const RHistShardedFiller &) = delete;
+   RHistShardedFiller(RHistShardedFiller &&other): fManager(other.fManager), fBuffers(std::move(other.fBuffers))
+   {
+      other.fManager = nullptr;
+   }
+   RHistShardedFiller &operator=(const RHistShardedFiller &) = delete;
+   ~RHistShardedFiller()
+   {
+      if (fManager)
+         Flush();
+   }
+
+   /// Thread-specific HIST::Fill().
+   void Fill(const CoordArray_t &x, Weight_t weight = 1.)
+   {
+      const int bin = fManager->GetHist().GetImpl()->GetBinIndex(x);
+      const int shard = fManager->GetShardIndex(bin);
+      auto &buffer = fBuffers[shard];
+      buffer.push_back(Entry_t{x, bin, weight});
+      // Only wait for a busy shard if this thread has buffered a lot for it.
+      if (buffer.size() >= SIZE)
+         fManager->FillShard(shard, buffer, buffer.size() >= 4 * SIZE);
+   }
+
+   /// Thread-specific HIST::FillN().
+   void FillN(const std::span<const CoordArray_t> xN, const std::span<const Weight_t> weightN)
+   {
+      for (size_t i = 0; i < xN.size(); ++i)
+         Fill(xN[i], weightN[i]);
+   }
+
+   /// Thread-specific HIST::FillN().
+   void FillN(const std::span<const CoordArray_t> xN)
+   {
+      for (auto &&x: xN)
+         Fill(x);
+   }
+
+   /// Submit all buffered entries to the shards.
+   void Flush()
+   {
+      for (size_t shard = 0; shard < fBuffers.size(); ++shard)
+         fManager->FillShard(shard, fBuffers[shard], true);
+   }
+
+   static constexpr int GetNDim() { return HIST::GetNDim(); }
+};
+
+/**
+ \class RHistShardedFillManager
+ Fills a histogram with very many bins from many threads.
+
+ The regular bins are split into consecutive ranges, one per shard; the first
+ shard also holds the under- and overflow bins. Each shard has its own partial
+ statistics for its bins and its own lock, so the total memory is that of one
+ more histogram, independently of the number of threads. The
+ RHistShardedFiller objects handed out by MakeFiller() buffer SIZE entries per
+ shard and apply them to the shard, skipping shards that another thread is
+ filling unless they have buffered much more. Flush() adds the shards to the
+ managed histogram; call it (or destroy the manager) once the fillers have
+ been flushed or destroyed.
+
+ Axes must not grow while filling.
+ **/
+
+template <class HIST, int SIZE = 1024>
+class RHistShardedFillManager {
+   friend class RHistShardedFiller<HIST, SIZE>;
+
+public:
+   using Hist_t = HIST;
+   using CoordArray_t = typename HIST::CoordArray_t;
+   using Weight_t = typename HIST::Weight_t;
+   using Stat_t = typename HIST::ImplBase_t::Stat_t;
+
+   /// A buffered fill.
+   struct Entry_t {
+      CoordArray_t fX;
+      int fBin;
+      Weight_t fWeight;
+   };
+
+private:
+   /// Statistics of a range of bins.
+   struct alignas(64) RShard {
+      std::mutex fMutex; ///< Taken while filling fStat.
+      int fFirstBin;     ///< First regular bin of the range.
+      Stat_t fStat;      ///< Statistics of the range.
+   };
+
+   HIST &fHist;
+   int fNBinsPerShard;                         ///< Number of regular bins per shard, but the last.
+   std::vector<std::unique_ptr<RShard>> fShards;
+
+   /// Index of the shard holding `bin`.
+   int GetShardIndex(int bin) const { return bin < 0 ? 0 : (bin - 1) / fNBinsPerShard; }
+
+   /// Apply `entries` to `shard` and clear them; if `wait` is false and
+   /// another thread is filling the shard, keep them instead.
+   void FillShard(int shard, std::vector<Entry_t> &entries, bool wait)
+   {
+      if (entries.empty())
+         return;
+      RShard &s = *fShards[shard];
+      std::unique_lock<std::mutex> lock(s.fMutex, std::try_to_lock);
+      if (!lock.owns_lock()) {
+         if (!wait)
+            return;
+         lock.lock();
+      }
+      const int offset = s.fFirstBin - 1;
+      for (const Entry_t &e: entries)
+         s.fStat.Fill(e.fX, e.fBin < 0 ? e.fBin : e.fBin - offset, e.fWeight);
+      entries.clear();
+   }
+
+public:
+   /// Split the bins of `hist` into (at most) `nShards` shards.
+   RHistShardedFillManager(HIST &hist, int nShards = std::max(1u, std::thread::hardware_concurrency())): fHist(hist)
+   {
+      const auto &impl = *hist.GetImpl();
+      const int nBins = impl.GetNBinsNoOver();
+      fNBinsPerShard = std::max(1, (nBins + nShards - 1) / nShards);
+      for (int first = 1; first == 1 || first <= nBins; first += fNBinsPerShard) {
+         std::unique_ptr<RShard> shard(new RShard);
+         shard->fFirstBin = first;
+         shard->fStat = Stat_t(std::max(0, std::min(fNBinsPerShard, nBins - first + 1)),
+                               first == 1 ? impl.GetNOverflowBins() : 0);
+         fShards.emplace_back(std::move(shard));
+      }
+   }
+   ~RHistShardedFillManager() { Flush(); }
+
+   RHistShardedFiller<HIST, SIZE> MakeFiller() { return RHistShardedFiller<HIST, SIZE>{*this}; }
+
+   HIST &GetHist() const { return fHist; }
+   int GetNShards() const { return fShards.size(); }
+
+   /// Add all shards to the managed histogram, and clear them.
+   void Flush()
+   {
+      auto &stat = fHist.GetImpl()->GetStat();
+      for (auto &shard: fShards) {
+         std::lock_guard<std::mutex> lockGuard(shard->fMutex);
+         stat.AddBinRange(shard->fStat, shard->fFirstBin);
+         shard->fStat = Stat_t(shard->fStat.sizeNoOver(), shard->fStat.sizeUnderOver());
+      }
+   }
+};
+
 } // namespace Experimental
 } // namespace ROOT
 
@@ -161,6 +161,21 @@ public:
       for (size_t b = 0; b < fOverflowBinContent.size(); ++b)
          fOverflowBinContent[b] += other.fOverflowBinContent[b];
    }
+
+   /// Merge with other RHistStatContent that only holds the regular bins
+   /// starting at `firstBin`, and either all or none of the under- and
+   /// overflow bins.
+   void AddBinRange(const RHistStatContent& other, size_t firstBin) {
+      assert(firstBin >= 1 && firstBin - 1 + other.fBinContent.size() <= fBinContent.size()
+               && "other does not hold a range of this' bins!");
+      assert((other.fOverflowBinContent.empty() || other.fOverflowBinContent.size() == fOverflowBinContent.size())
+               && "other does not hold a range of this' bins!");
+      fEntries += other.fEntries;
+      for (size_t b = 0; b < other.fBinContent.size(); ++b)
+         fBinContent[firstBin - 1 + b] += other.fBinContent[b];
+      for (size_t b = 0; b < other.fOverflowBinContent.size(); ++b)
+         fOverflowBinContent[b] += other.fOverflowBinContent[b];
+   }
 };
 
 /**
@@ -205,6 +220,9 @@ public:
    void Add(const RHistStatTotalSumOfWeights& other) {
       fSumWeights += other.fSumWeights;
    }
+
+   /// Merge with other RHistStatTotalSumOfWeights data of a range of bins.
+   void AddBinRange(const RHistStatTotalSumOfWeights& other, size_t /*firstBin*/) { Add(other); }
 };
 
 /**
@@ -249,6 +267,9 @@ public:
    void Add(const RHistStatTotalSumOfSquaredWeights& other) {
       fSumWeights2 += other.fSumWeights2;
    }
+
+   /// Merge with other RHistStatTotalSumOfSquaredWeights data of a range of bins.
+   void AddBinRange(const RHistStatTotalSumOfSquaredWeights& other, size_t /*firstBin*/) { Add(other); }
 };
 
 /**
@@ -369,6 +390,21 @@ public:
       for (size_t b = 0; b < fOverflowSumWeightsSquared.size(); ++b)
          fOverflowSumWeightsSquared[b] += other.fOverflowSumWeightsSquared[b];
    }
+
+   /// Merge with other `RHistStatUncertainty` data that only holds the regular
+   /// bins starting at `firstBin`, and either all or none of the under- and
+   /// overflow bins.
+   void AddBinRange(const RHistStatUncertainty& other, size_t firstBin) {
+      assert(firstBin >= 1 && firstBin - 1 + other.fSumWeightsSquared.size() <= fSumWeightsSquared.size()
+               && "other does not hold a range of this' bins!");
+      assert((other.fOverflowSumWeightsSquared.empty()
+              || other.fOverflowSumWeightsSquared.size() == fOverflowSumWeightsSquared.size())
+               && "other does not hold a range of this' bins!");
+      for (size_t b = 0; b < other.fSumWeightsSquared.size(); ++b)
+         fSumWeightsSquared[firstBin - 1 + b] += other.fSumWeightsSquared[b];
+      for (size_t b = 0; b < other.fOverflowSumWeightsSquared.size(); ++b)
+         fOverflowSumWeightsSquared[b] += other.fOverflowSumWeightsSquared[b];
+   }
 };
 
 /** \class RHistDataMomentUncert
@@ -397,8 +433,8 @@ public:
    using BinStat_t = RBinStat;
 
 private:
-   std::array<Weight_t, DIMENSIONS> fMomentXW;
-   std::array<Weight_t, DIMENSIONS> fMomentX2W;
+   std::array<Weight_t, DIMENSIONS> fMomentXW{};
+   std::array<Weight_t, DIMENSIONS> fMomentX2W{};
    // FIXME: Add sum(w.x.y)-style stats.
 
 public:
@@ -424,6 +460,9 @@ public:
          fMomentX2W[d] += other.fMomentX2W[d];
       }
    }
+
+   /// Merge with other RHistDataMomentUncert data of a range of bins.
+   void AddBinRange(const RHistDataMomentUncert& other, size_t /*firstBin*/) { Add(other); }
 };
 
 /** \class RHistStatRuntime
@@ -576,6 +615,20 @@ public:
       (void)trigger_base_add{(STAT<DIMENSIONS, PRECISION>::Add(other), 0)...};
    }
 
+   /// Integrate statistical data recorded for a range of bins into the current
+   /// data.
+   ///
+   /// `other` holds the regular bins `firstBin`, `firstBin + 1`, ... of this
+   /// binning configuration, and either all or none of its under- and
+   /// overflow bins. As for `Add()`, its statistics must be a superset of the
+   /// ones recorded by the active `RHistData` instance.
+   template <typename OtherData>
+   void AddBinRange(const OtherData &other, size_t firstBin)
+   {
+      using trigger_base_add = int[];
+      (void)trigger_base_add{(STAT<DIMENSIONS, PRECISION>::AddBinRange(other, firstBin), 0)...};
+   }
+
    /// Whether this provides storage for uncertainties, or whether uncertainties
    /// are determined as poisson uncertainty of the content.
    static constexpr bool HasBinUncertainty()
@@ -0,0 +1,101 @@
+/// \file concurrentfillspeedtest.cxx
+///
+/// Per-thread fill throughput of the concurrent fill managers, for 1, 2, 4, ...
+/// threads. Build and run with
+///
+///     g++ -o concurrentfillspeedtest concurrentfillspeedtest.cxx `root-config --cflags --libs` -O3
+///     ./concurrentfillspeedtest [fills per thread] [max threads] [bins per axis]
+///
+/// \warning This is part of the ROOT 7 prototype! It will change without notice. It might trigger earthquakes. Feedback
+/// is welcome!
+
+#include "ROOT/RHist.hxx"
+#include "ROOT/RHistConcurrentFill.hxx"
+
+#include "TRandom3.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ROOT;
+
+using Hist_t = Experimental::RH2D;
+using Point_t = Hist_t::CoordArray_t;
+
+/// Fill `input` from `nThreads` threads, each with its own filler from
+/// `fillMgr.MakeFiller()`; return the millions of fills per second and thread,
+/// including the final Flush().
+template <class MANAGER>
+double RunThreads(MANAGER &fillMgr, const std::vector<Point_t> &input, int nThreads)
+{
+   auto start = std::chrono::high_resolution_clock::now();
+   std::vector<std::thread> threads;
+   for (int t = 0; t < nThreads; ++t) {
+      threads.emplace_back(
+         [&input](decltype(fillMgr.MakeFiller()) filler) {
+            for (auto &x : input)
+               filler.Fill(x);
+         },
+         fillMgr.MakeFiller());
+   }
+   for (auto &thr : threads)
+      thr.join();
+   fillMgr.Flush();
+   std::chrono::duration<double> seconds = std::chrono::high_resolution_clock::now() - start;
+   return input.size() / 1e6 / seconds.count();
+}
+
+int main(int argc, char **argv)
+{
+   size_t nFills = argc > 1 ? atof(argv[1]) : 1e7;
+   int maxThreads = argc > 2 ? atoi(argv[2]) : 64;
+   int nBins = argc > 3 ? atoi(argv[3]) : 1000;
+
+   std::vector<Point_t> input(nFills);
+   TRandom3 r(42);
+   for (auto &x : input)
+      x = Point_t(r.Rndm(), r.Rndm());
+
+   std::cout << nFills << " fills per thread, " << nBins << " x " << nBins << " bins\n"
+             << "threads \tmutex (1024) \tper-thread \tsharded (1024)\t[millions of fills per second and thread]\n";
+   for (int nThreads = 1; nThreads <= maxThreads; nThreads *= 2) {
+      // Every run fills a fresh histogram.
+      double locked = 0.;
+      {
+         Hist_t hist({nBins, 0., 1.}, {nBins, 0., 1.});
+         Experimental::RHistConcurrentFillManager<Hist_t> fillMgr(hist);
+         auto start = std::chrono::high_resolution_clock::now();
+         std::vector<std::thread> threads;
+         for (int t = 0; t < nThreads; ++t) {
+            threads.emplace_back(
+               [&input](Experimental::RHistConcurrentFiller<Hist_t, 1024> filler) {
+                  for (auto &x : input)
+                     filler.Fill(x);
+               },
+               fillMgr.MakeFiller());
+         }
+         for (auto &thr : threads)
+            thr.join();
+         std::chrono::duration<double> seconds = std::chrono::high_resolution_clock::now() - start;
+         locked = input.size() / 1e6 / seconds.count();
+      }
+      double perThread = 0.;
+      {
+         Hist_t hist({nBins, 0., 1.}, {nBins, 0., 1.});
+         Experimental::RHistPerThreadFillManager<Hist_t> perThreadMgr(hist);
+         perThread = RunThreads(perThreadMgr, input, nThreads);
+      }
+      double sharded = 0.;
+      {
+         Hist_t hist({nBins, 0., 1.}, {nBins, 0., 1.});
+         Experimental::RHistShardedFillManager<Hist_t> shardedMgr(hist, nThreads);
+         sharded = RunThreads(shardedMgr, input, nThreads);
+      }
+
+      std::cout << nThreads << "\t\t" << locked << "\t\t" << perThread << "\t\t" << sharded << '\n';
+   }
+}
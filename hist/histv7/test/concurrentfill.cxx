@@ -143,3 +143,86 @@ TEST(ConcurrentFillTest, FillFlush)
    EXPECT_EQ(0, (int)Filler_1.GetCoords().size());
    EXPECT_EQ(0, (int)Filler_2.GetCoords().size());
 }
+
+// Fill `hist` from `nThreads` threads, each with its own filler of `fillMgr`.
+template <class MANAGER>
+void concurrentHistFillWithManager(MANAGER &fillMgr, int nThreads)
+{
+   std::vector<std::thread> threads;
+   for (int t = 0; t < nThreads; ++t) {
+      threads.emplace_back([](decltype(fillMgr.MakeFiller()) filler) {
+         for (int i = 0; i < 3000; ++i)
+            filler.Fill({(double)i / 3000, (double)i / 300}, (float)(i % 7));
+      }, fillMgr.MakeFiller());
+   }
+   for (auto &thr : threads)
+      thr.join();
+}
+
+// Compare all bins, including under- and overflow, of two histograms.
+void expectSameBins(const Experimental::RH2D &expected, const Experimental::RH2D &actual)
+{
+   EXPECT_EQ(expected.GetEntries(), actual.GetEntries());
+   const auto &expImpl = *expected.GetImpl();
+   const auto &actImpl = *actual.GetImpl();
+   for (int bin = 1; bin <= expImpl.GetNBinsNoOver(); ++bin)
+      EXPECT_DOUBLE_EQ(expImpl.GetBinContent(bin), actImpl.GetBinContent(bin));
+   for (int bin = 1; bin <= expImpl.GetNOverflowBins(); ++bin)
+      EXPECT_DOUBLE_EQ(expImpl.GetBinContent(-bin), actImpl.GetBinContent(-bin));
+}
+
+// Serial reference for concurrentHistFillWithManager()
+void serialHistFill(Experimental::RH2D &hist, int nThreads)
+{
+   for (int t = 0; t < nThreads; ++t)
+      for (int i = 0; i < 3000; ++i)
+         hist.Fill({(double)i / 3000, (double)i / 300}, (float)(i % 7));
+}
+
+TEST(ConcurrentFillTest, PerThreadFillManager)
+{
+   Experimental::RH2D expected{{100, 0., 1.}, {{0., 1., 2., 3., 8.}}};
+   Experimental::RH2D hist{{100, 0., 1.}, {{0., 1., 2., 3., 8.}}};
+   // An odd number of fillers, to test the reduction tree.
+   serialHistFill(expected, 5);
+   {
+      Experimental::RHistPerThreadFillManager<Experimental::RH2D> fillMgr(hist);
+      concurrentHistFillWithManager(fillMgr, 5);
+      fillMgr.Flush();
+      expectSameBins(expected, hist);
+
+      // The partial histograms are cleared by Flush().
+      serialHistFill(expected, 3);
+      concurrentHistFillWithManager(fillMgr, 3);
+   }
+   expectSameBins(expected, hist);
+}
+
+TEST(ConcurrentFillTest, PerThreadFillManagerReusesPartials)
+{
+   Experimental::RH2D expected{{100, 0., 1.}, {{0., 1., 2., 3., 8.}}};
+   Experimental::RH2D hist{{100, 0., 1.}, {{0., 1., 2., 3., 8.}}};
+   serialHistFill(expected, 12);
+   {
+      Experimental::RHistPerThreadFillManager<Experimental::RH2D> fillMgr(hist);
+      // Many short-lived fillers, two at a time, as created by tasks.
+      for (int task = 0; task < 6; ++task)
+         concurrentHistFillWithManager(fillMgr, 2);
+      EXPECT_EQ(2u, fillMgr.GetNPartials());
+   }
+   expectSameBins(expected, hist);
+}
+
+TEST(ConcurrentFillTest, ShardedFillManager)
+{
+   Experimental::RH2D expected{{100, 0., 1.}, {{0., 1., 2., 3., 8.}}};
+   Experimental::RH2D hist{{100, 0., 1.}, {{0., 1., 2., 3., 8.}}};
+   serialHistFill(expected, 4);
+   {
+      // Shards that do not divide the number of bins evenly.
+      Experimental::RHistShardedFillManager<Experimental::RH2D, 16> fillMgr(hist, 7);
+      EXPECT_EQ(7, fillMgr.GetNShards());
+      concurrentHistFillWithManager(fillMgr, 4);
+   }
+   expectSameBins(expected, hist);
+}
@@ -15,10 +15,10 @@
 #include "TFileMerger.h"
 #include "TMemFile.h"
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <mutex>
-#include <queue>
 
 namespace ROOT {
 namespace Experimental {
@@ -36,6 +36,13 @@ class TBufferMergerFile;
  * socket, TBufferMerger uses threads that each write to a
  * TBufferMergerFile, which in turn push data into a queue
  * managed by the TBufferMerger.
+ *
+ * The queue is lock-free: worker threads only ever push onto it,
+ * and whichever thread performs the merge takes all pending buffers
+ * at once, so writers never block on each other or on the merge.
+ * Buffers are handed to the merger without further copies, and trees
+ * are merged with the fast method (compressed baskets are copied as
+ * is) whenever the compression settings match those of the output.
  */
 
 class TBufferMerger {
@@ -105,17 +112,23 @@ private:
    /** TBufferMerger has no copy operator */
    TBufferMerger &operator=(const TBufferMerger &);
 
+   /** Node of the lock-free queue of buffers waiting to be merged */
+   struct QueueNode {
+      TBufferFile *fBuffer; //< Buffer pushed by a TBufferMergerFile
+      QueueNode *fNext;     //< Previously pushed node
+   };
+
    void Init(std::unique_ptr<TFile>);
 
    void Merge();
    void Push(TBufferFile *buffer);
 
    size_t fAutoSave{0};                                          //< AutoSave only every fAutoSave bytes
-   size_t fBuffered{0};                                          //< Number of bytes currently buffered
+   std::atomic<size_t> fBuffered{0};                             //< Number of bytes currently buffered
+   std::atomic<size_t> fQueueSize{0};                            //< Number of buffers currently in the queue
    TFileMerger fMerger{false, false};                            //< TFileMerger used to merge all buffers
    std::mutex fMergeMutex;                                       //< Mutex used to lock fMerger
-   std::mutex fQueueMutex;                                       //< Mutex used to lock fQueue
-   std::queue<TBufferFile *> fQueue;                             //< Queue to which data is pushed and merged
+   std::atomic<QueueNode *> fQueue{nullptr};                     //< Lock-free LIFO list to which data is pushed
    std::vector<std::weak_ptr<TBufferMergerFile>> fAttachedFiles; //< Attached files
 };
 
@@ -283,6 +283,7 @@ public:
    virtual void        ShowStreamerInfo();
            Int_t       Sizeof() const override;
            void        SumBuffer(Int_t bufsize);
+   virtual Int_t       Verify(Option_t *opt = "", Int_t *nunchecked = nullptr);
    virtual Bool_t      WriteBuffer(const char *buf, Int_t len);
            Int_t       Write(const char *name=nullptr, Int_t opt=0, Int_t bufsiz=0) override;
            Int_t       Write(const char *name=nullptr, Int_t opt=0, Int_t bufsiz=0) const override;
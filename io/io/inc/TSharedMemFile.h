@@ -0,0 +1,44 @@
+// @(#)root/io:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TSharedMemFile
+#define ROOT_TSharedMemFile
+
+#include "TMemFile.h"
+
+class TSharedMemFile : public TMemFile {
+private:
+   struct RMapping {
+      void    *fAddress{nullptr};
+      Long64_t fSize{0};
+   };
+
+   void    *fMapAddress{nullptr}; ///<! Start of the read-only mapping of the segment
+   Long64_t fMapSize{0};          ///<! Size of the mapping
+
+   static TString  GetSegmentName(const char *url);
+   static RMapping MapSegment(const char *url, Option_t *option);
+
+   TSharedMemFile(const char *url, const RMapping &mapping);
+   TSharedMemFile(const TSharedMemFile &) = delete;
+   TSharedMemFile &operator=(const TSharedMemFile &) = delete;
+
+public:
+   TSharedMemFile(const char *url, Option_t *option = "", const char *ftitle = "",
+                  Int_t compress = ROOT::RCompressionSetting::EDefaults::kUseCompiledDefault);
+   virtual ~TSharedMemFile();
+
+   static Bool_t Publish(const TMemFile &file, const char *name);
+   static Bool_t Unlink(const char *name);
+
+   ClassDefOverride(TSharedMemFile, 0) // A read-only ROOT file mapped from a shared-memory segment
+};
+
+#endif
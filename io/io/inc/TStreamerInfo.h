@@ -117,6 +117,7 @@ private:
    TStreamerInfoActions::TActionSequence *fWriteText;             ///<! List of text write action resulting for the compilation, used for JSON.
 
    static std::atomic<Int_t>             fgCount;     ///<Number of TStreamerInfo instances
+   static std::atomic<Bool_t>            fgJitActions; ///<True if the object-wise read actions are to be jitted
 
    template <typename T> static T GetTypedValueAux(Int_t type, void *ladd, int k, Int_t len);
    static void       PrintValueAux(char *ladd, Int_t atype, TStreamerElement * aElement, Int_t aleng, Int_t *count);
@@ -282,6 +283,8 @@ public:
    virtual TClassStreamer *GenExplicitClassStreamer( const ::ROOT::Detail::TCollectionProxyInfo &info, TClass *cl );
 
    static TStreamerElement   *GetCurrentElement();
+   static Bool_t       GetJitActions();
+   static Bool_t       SetJitActions(Bool_t enable = kTRUE);
 
 public:
    // For access by the StreamerInfoActions.
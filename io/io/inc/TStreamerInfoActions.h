@@ -174,6 +174,7 @@ namespace TStreamerInfoActions {
    public:
       struct SequencePtr;
       using SequenceGetter_t = SequencePtr(*)(TStreamerInfo *info, TVirtualCollectionProxy *collectionProxy, TClass *originalClass);
+      using JittedReadAction_t = Int_t (*)(TBuffer &buf, void *obj, const TActionSequence &sequence);
 
       TActionSequence(TVirtualStreamerInfo *info, UInt_t maxdata) : fStreamerInfo(info), fLoopConfig(0) { fActions.reserve(maxdata); };
       ~TActionSequence() {
@@ -191,9 +192,11 @@ namespace TStreamerInfoActions {
       TVirtualStreamerInfo *fStreamerInfo; ///< StreamerInfo used to derive these actions.
       TLoopConfiguration   *fLoopConfig;   ///< If this is a bundle of memberwise streaming action, this configures the looping
       ActionContainer_t     fActions;
+      JittedReadAction_t    fJitted = nullptr; ///<! Straight-line equivalent of fActions generated by the interpreter, if any.
 
       void AddToOffset(Int_t delta);
       void SetMissing();
+      Bool_t JitReadActions();
 
       TActionSequence *CreateCopy();
       static TActionSequence *CreateReadMemberWiseActions(TVirtualStreamerInfo *info, TVirtualCollectionProxy &proxy);
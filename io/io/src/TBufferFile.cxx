@@ -44,6 +44,14 @@ The concrete implementation of TBuffer for writing/reading to/from a ROOT file o
 #include "Bswapcpy.h"
 #endif
 
+#if defined(R__BYTESWAP) && defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && \
+    !defined(__INTEL_COMPILER)
+#define R__BSWAP_SIMD
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+
 
 const UInt_t kNewClassTag       = 0xFFFFFFFF;
 const UInt_t kClassMask         = 0x80000000;  // OR the class index with this
@@ -68,6 +76,188 @@ static inline bool Class_Has_StreamerInfo(const TClass* cl)
    return cl->GetStreamerInfos()->GetLast()>1;
 }
 
+#ifdef R__BYTESWAP
+
+namespace {
+
+template <int Size> struct ByteSwapWord;
+template <> struct ByteSwapWord<2> { using Type = UShort_t; };
+template <> struct ByteSwapWord<4> { using Type = UInt_t; };
+template <> struct ByteSwapWord<8> { using Type = ULong64_t; };
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy n elements of Size bytes from `from` to `to`, reversing the byte order
+/// of each of them, one element at a time.
+
+template <int Size>
+inline void ByteSwapCopyScalar(char *to, const char *from, Long64_t n)
+{
+   using Word_t = typename ByteSwapWord<Size>::Type;
+   for (Long64_t i = 0; i < n; ++i) {
+      Word_t x;
+      memcpy(&x, from + i * Size, Size);
+      x = host2net(x);
+      memcpy(to + i * Size, &x, Size);
+   }
+}
+
+#ifdef R__BSWAP_SIMD
+
+////////////////////////////////////////////////////////////////////////////////
+/// Byte shuffle mask reversing each Size-byte element of a 16-byte vector.
+
+template <int Size>
+inline __m128i ByteSwapMask()
+{
+   alignas(16) char mask[16];
+   for (int i = 0; i < 16; ++i)
+      mask[i] = (i / Size) * Size + (Size - 1 - i % Size);
+   return _mm_load_si128((const __m128i *)mask);
+}
+
+template <int Size>
+__attribute__((target("ssse3"))) void ByteSwapCopySSSE3(char *to, const char *from, Long64_t n)
+{
+   const __m128i mask = ByteSwapMask<Size>();
+   const Long64_t nbytes = n * Size;
+   Long64_t i = 0;
+   for (; i + 16 <= nbytes; i += 16) {
+      __m128i v = _mm_loadu_si128((const __m128i *)(from + i));
+      _mm_storeu_si128((__m128i *)(to + i), _mm_shuffle_epi8(v, mask));
+   }
+   ByteSwapCopyScalar<Size>(to + i, from + i, (nbytes - i) / Size);
+}
+
+template <int Size>
+__attribute__((target("avx2"))) void ByteSwapCopyAVX2(char *to, const char *from, Long64_t n)
+{
+   // vpshufb shuffles within each 128-bit lane, so the same mask is used for both.
+   const __m256i mask = _mm256_broadcastsi128_si256(ByteSwapMask<Size>());
+   const Long64_t nbytes = n * Size;
+   Long64_t i = 0;
+   for (; i + 32 <= nbytes; i += 32) {
+      __m256i v = _mm256_loadu_si256((const __m256i *)(from + i));
+      _mm256_storeu_si256((__m256i *)(to + i), _mm256_shuffle_epi8(v, mask));
+   }
+   ByteSwapCopyScalar<Size>(to + i, from + i, (nbytes - i) / Size);
+}
+
+enum class EByteSwapISA { kScalar, kSSSE3, kAVX2 };
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the best instruction set available on the running CPU.
+
+EByteSwapISA GetByteSwapISA()
+{
+   static const EByteSwapISA isa = []() {
+      __builtin_cpu_init();
+      if (__builtin_cpu_supports("avx2"))
+         return EByteSwapISA::kAVX2;
+      if (__builtin_cpu_supports("ssse3"))
+         return EByteSwapISA::kSSSE3;
+      return EByteSwapISA::kScalar;
+   }();
+   return isa;
+}
+
+#endif // R__BSWAP_SIMD
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy n elements of Size bytes from `from` to `to`, reversing the byte order
+/// of each of them. This is the array version of tobuf()/frombuf(): it uses
+/// AVX2 or SSSE3 byte shuffles, selected at runtime, when available.
+
+template <int Size>
+void ByteSwapCopy(char *to, const char *from, Long64_t n)
+{
+#ifdef R__BSWAP_SIMD
+   // Short arrays are not worth the dispatch.
+   if (n * Size >= 32) {
+      switch (GetByteSwapISA()) {
+         case EByteSwapISA::kAVX2: ByteSwapCopyAVX2<Size>(to, from, n); return;
+         case EByteSwapISA::kSSSE3: ByteSwapCopySSSE3<Size>(to, from, n); return;
+         case EByteSwapISA::kScalar: break;
+      }
+   }
+#endif
+   ByteSwapCopyScalar<Size>(to, from, n);
+}
+
+} // anonymous namespace
+
+#endif // R__BYTESWAP
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read n 4-byte words from the buffer into `to`, converting from network byte order.
+
+inline void FromBufWords(char *&buf, void *to, Int_t n)
+{
+#ifdef R__BYTESWAP
+   ByteSwapCopy<4>((char *)to, buf, n);
+#else
+   memcpy(to, buf, 4 * (size_t)n);
+#endif
+   buf += 4 * (size_t)n;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Unpack n floating point values stored as integers in the [minvalue, minvalue + 2^32/factor]
+/// range, see TBufferFile::WriteFloat16 and TBufferFile::WriteDouble32.
+/// The values are converted by chunks, so that both the byte swapping and the
+/// conversion loops can be vectorized.
+
+template <typename T>
+inline void FromBufWithFactor(char *&buf, T *ptr, Int_t n, Double_t factor, Double_t minvalue)
+{
+   constexpr Int_t kChunkSize = 256;
+   UInt_t aint[kChunkSize];
+   for (Int_t first = 0; first < n; first += kChunkSize) {
+      const Int_t len = std::min(kChunkSize, n - first);
+      FromBufWords(buf, aint, len);
+      for (Int_t j = 0; j < len; j++)
+         ptr[first + j] = (T)(aint[j] / factor + minvalue);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Convert n floats from the buffer into doubles, see TBufferFile::WriteDouble32.
+
+inline void FromBufFloatAsDouble(char *&buf, Double_t *d, Int_t n)
+{
+   constexpr Int_t kChunkSize = 256;
+   Float_t afloat[kChunkSize];
+   for (Int_t first = 0; first < n; first += kChunkSize) {
+      const Int_t len = std::min(kChunkSize, n - first);
+      FromBufWords(buf, afloat, len);
+      for (Int_t j = 0; j < len; j++)
+         d[first + j] = (Double_t)afloat[j];
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read a float stored as exponent and truncated mantissa, see TBufferFile::WriteFloat16.
+
+inline Float_t FromBufTruncatedFloat(char *&buf, Int_t nbits)
+{
+   union {
+      Float_t fFloatValue;
+      Int_t   fIntValue;
+   };
+   UChar_t  theExp;
+   UShort_t theMan;
+   frombuf(buf, &theExp);
+   frombuf(buf, &theMan);
+   fIntValue = theExp;
+   fIntValue <<= 23;
+   fIntValue |= (theMan & ((1<<(nbits+1))-1)) <<(23-nbits);
+   if (1<<(nbits+1) & theMan) fFloatValue = -fFloatValue;
+   return fFloatValue;
+}
+
+} // anonymous namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Create an I/O buffer object. Mode should be either TBuffer::kRead or
 /// TBuffer::kWrite. By default the I/O buffer has a size of
@@ -765,8 +955,8 @@ Int_t TBufferFile::ReadArray(Short_t *&h)
    bswapcpy16(h, fBufCur, n);
    fBufCur += l;
 # else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &h[i]);
+   ByteSwapCopy<sizeof(h[0])>((char *)h, fBufCur, n);
+   fBufCur += l;
 # endif
 #else
    memcpy(h, fBufCur, l);
@@ -798,8 +988,8 @@ Int_t TBufferFile::ReadArray(Int_t *&ii)
    bswapcpy32(ii, fBufCur, n);
    fBufCur += l;
 # else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ii[i]);
+   ByteSwapCopy<sizeof(ii[0])>((char *)ii, fBufCur, n);
+   fBufCur += l;
 # endif
 #else
    memcpy(ii, fBufCur, l);
@@ -853,8 +1043,8 @@ Int_t TBufferFile::ReadArray(Long64_t *&ll)
    if (!ll) ll = new Long64_t[n];
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ll[i]);
+   ByteSwapCopy<sizeof(ll[0])>((char *)ll, fBufCur, n);
+   fBufCur += l;
 #else
    memcpy(ll, fBufCur, l);
    fBufCur += l;
@@ -885,8 +1075,8 @@ Int_t TBufferFile::ReadArray(Float_t *&f)
    bswapcpy32(f, fBufCur, n);
    fBufCur += l;
 # else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &f[i]);
+   ByteSwapCopy<sizeof(f[0])>((char *)f, fBufCur, n);
+   fBufCur += l;
 # endif
 #else
    memcpy(f, fBufCur, l);
@@ -914,8 +1104,8 @@ Int_t TBufferFile::ReadArray(Double_t *&d)
    if (!d) d = new Double_t[n];
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &d[i]);
+   ByteSwapCopy<sizeof(d[0])>((char *)d, fBufCur, n);
+   fBufCur += l;
 #else
    memcpy(d, fBufCur, l);
    fBufCur += l;
@@ -1038,8 +1228,8 @@ Int_t TBufferFile::ReadStaticArray(Short_t *h)
    bswapcpy16(h, fBufCur, n);
    fBufCur += l;
 # else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &h[i]);
+   ByteSwapCopy<sizeof(h[0])>((char *)h, fBufCur, n);
+   fBufCur += l;
 # endif
 #else
    memcpy(h, fBufCur, l);
@@ -1070,8 +1260,8 @@ Int_t TBufferFile::ReadStaticArray(Int_t *ii)
    bswapcpy32(ii, fBufCur, n);
    fBufCur += sizeof(Int_t)*n;
 # else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ii[i]);
+   ByteSwapCopy<sizeof(ii[0])>((char *)ii, fBufCur, n);
+   fBufCur += l;
 # endif
 #else
    memcpy(ii, fBufCur, l);
@@ -1123,8 +1313,8 @@ Int_t TBufferFile::ReadStaticArray(Long64_t *ll)
    if (!ll) return 0;
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ll[i]);
+   ByteSwapCopy<sizeof(ll[0])>((char *)ll, fBufCur, n);
+   fBufCur += l;
 #else
    memcpy(ll, fBufCur, l);
    fBufCur += l;
@@ -1154,8 +1344,8 @@ Int_t TBufferFile::ReadStaticArray(Float_t *f)
    bswapcpy32(f, fBufCur, n);
    fBufCur += sizeof(Float_t)*n;
 # else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &f[i]);
+   ByteSwapCopy<sizeof(f[0])>((char *)f, fBufCur, n);
+   fBufCur += l;
 # endif
 #else
    memcpy(f, fBufCur, l);
@@ -1182,8 +1372,8 @@ Int_t TBufferFile::ReadStaticArray(Double_t *d)
    if (!d) return 0;
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &d[i]);
+   ByteSwapCopy<sizeof(d[0])>((char *)d, fBufCur, n);
+   fBufCur += l;
 #else
    memcpy(d, fBufCur, l);
    fBufCur += l;
@@ -1304,8 +1494,8 @@ void TBufferFile::ReadFastArray(Short_t *h, Int_t n)
    bswapcpy16(h, fBufCur, n);
    fBufCur += sizeof(Short_t)*n;
 # else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &h[i]);
+   ByteSwapCopy<sizeof(h[0])>((char *)h, fBufCur, n);
+   fBufCur += l;
 # endif
 #else
    memcpy(h, fBufCur, l);
@@ -1326,8 +1516,8 @@ void TBufferFile::ReadFastArray(Int_t *ii, Int_t n)
    bswapcpy32(ii, fBufCur, n);
    fBufCur += sizeof(Int_t)*n;
 # else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ii[i]);
+   ByteSwapCopy<sizeof(ii[0])>((char *)ii, fBufCur, n);
+   fBufCur += l;
 # endif
 #else
    memcpy(ii, fBufCur, l);
@@ -1360,8 +1550,8 @@ void TBufferFile::ReadFastArray(Long64_t *ll, Int_t n)
    if (l <= 0 || l > fBufSize) return;
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ll[i]);
+   ByteSwapCopy<sizeof(ll[0])>((char *)ll, fBufCur, n);
+   fBufCur += l;
 #else
    memcpy(ll, fBufCur, l);
    fBufCur += l;
@@ -1381,8 +1571,8 @@ void TBufferFile::ReadFastArray(Float_t *f, Int_t n)
    bswapcpy32(f, fBufCur, n);
    fBufCur += sizeof(Float_t)*n;
 # else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &f[i]);
+   ByteSwapCopy<sizeof(f[0])>((char *)f, fBufCur, n);
+   fBufCur += l;
 # endif
 #else
    memcpy(f, fBufCur, l);
@@ -1399,8 +1589,8 @@ void TBufferFile::ReadFastArray(Double_t *d, Int_t n)
    if (l <= 0 || l > fBufSize) return;
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &d[i]);
+   ByteSwapCopy<sizeof(d[0])>((char *)d, fBufCur, n);
+   fBufCur += l;
 #else
    memcpy(d, fBufCur, l);
    fBufCur += l;
@@ -1417,33 +1607,15 @@ void TBufferFile::ReadFastArrayFloat16(Float_t *f, Int_t n, TStreamerElement *el
 
    if (ele && ele->GetFactor() != 0) {
       //a range was specified. We read an integer and convert it back to a float
-      Double_t xmin = ele->GetXmin();
-      Double_t factor = ele->GetFactor();
-      for (int j=0;j < n; j++) {
-         UInt_t aint; *this >> aint; f[j] = (Float_t)(aint/factor + xmin);
-      }
+      FromBufWithFactor(fBufCur, f, n, ele->GetFactor(), ele->GetXmin());
    } else {
-      Int_t i;
       Int_t nbits = 0;
       if (ele) nbits = (Int_t)ele->GetXmin();
       if (!nbits) nbits = 12;
       //we read the exponent and the truncated mantissa of the float
       //and rebuild the new float.
-      union {
-         Float_t fFloatValue;
-         Int_t   fIntValue;
-      };
-      UChar_t  theExp;
-      UShort_t theMan;
-      for (i = 0; i < n; i++) {
-         *this >> theExp;
-         *this >> theMan;
-         fIntValue = theExp;
-         fIntValue <<= 23;
-         fIntValue |= (theMan & ((1<<(nbits+1))-1)) <<(23-nbits);
-         if(1<<(nbits+1) & theMan) fFloatValue = -fFloatValue;
-         f[i] = fFloatValue;
-      }
+      for (Int_t i = 0; i < n; i++)
+         f[i] = FromBufTruncatedFloat(fBufCur, nbits);
    }
 }
 
@@ -1456,9 +1628,7 @@ void TBufferFile::ReadFastArrayWithFactor(Float_t *ptr, Int_t n, Double_t factor
    if (n <= 0 || 3*n > fBufSize) return;
 
    //a range was specified. We read an integer and convert it back to a float
-   for (int j=0;j < n; j++) {
-      UInt_t aint; *this >> aint; ptr[j] = (Float_t)(aint/factor + minvalue);
-   }
+   FromBufWithFactor(fBufCur, ptr, n, factor, minvalue);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1472,21 +1642,8 @@ void TBufferFile::ReadFastArrayWithNbits(Float_t *ptr, Int_t n, Int_t nbits)
    if (!nbits) nbits = 12;
    //we read the exponent and the truncated mantissa of the float
    //and rebuild the new float.
-   union {
-      Float_t fFloatValue;
-      Int_t   fIntValue;
-   };
-   UChar_t  theExp;
-   UShort_t theMan;
-   for (Int_t i = 0; i < n; i++) {
-      *this >> theExp;
-      *this >> theMan;
-      fIntValue = theExp;
-      fIntValue <<= 23;
-      fIntValue |= (theMan & ((1<<(nbits+1))-1)) <<(23-nbits);
-      if(1<<(nbits+1) & theMan) fFloatValue = -fFloatValue;
-      ptr[i] = fFloatValue;
-   }
+   for (Int_t i = 0; i < n; i++)
+      ptr[i] = FromBufTruncatedFloat(fBufCur, nbits);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1499,40 +1656,18 @@ void TBufferFile::ReadFastArrayDouble32(Double_t *d, Int_t n, TStreamerElement *
 
    if (ele && ele->GetFactor() != 0) {
       //a range was specified. We read an integer and convert it back to a double.
-      Double_t xmin = ele->GetXmin();
-      Double_t factor = ele->GetFactor();
-      for (int j=0;j < n; j++) {
-         UInt_t aint; *this >> aint; d[j] = (Double_t)(aint/factor + xmin);
-      }
+      FromBufWithFactor(fBufCur, d, n, ele->GetFactor(), ele->GetXmin());
    } else {
-      Int_t i;
       Int_t nbits = 0;
       if (ele) nbits = (Int_t)ele->GetXmin();
       if (!nbits) {
          //we read a float and convert it to double
-         Float_t afloat;
-         for (i = 0; i < n; i++) {
-            *this >> afloat;
-            d[i] = (Double_t)afloat;
-         }
+         FromBufFloatAsDouble(fBufCur, d, n);
       } else {
          //we read the exponent and the truncated mantissa of the float
          //and rebuild the double.
-         union {
-            Float_t fFloatValue;
-            Int_t   fIntValue;
-         };
-         UChar_t  theExp;
-         UShort_t theMan;
-         for (i = 0; i < n; i++) {
-            *this >> theExp;
-            *this >> theMan;
-            fIntValue = theExp;
-            fIntValue <<= 23;
-            fIntValue |= (theMan & ((1<<(nbits+1))-1)) <<(23-nbits);
-            if (1<<(nbits+1) & theMan) fFloatValue = -fFloatValue;
-            d[i] = (Double_t)fFloatValue;
-         }
+         for (Int_t i = 0; i < n; i++)
+            d[i] = (Double_t)FromBufTruncatedFloat(fBufCur, nbits);
       }
    }
 }
@@ -1546,9 +1681,7 @@ void TBufferFile::ReadFastArrayWithFactor(Double_t *d, Int_t n, Double_t factor,
    if (n <= 0 || 3*n > fBufSize) return;
 
    //a range was specified. We read an integer and convert it back to a double.
-   for (int j=0;j < n; j++) {
-      UInt_t aint; *this >> aint; d[j] = (Double_t)(aint/factor + minvalue);
-   }
+   FromBufWithFactor(fBufCur, d, n, factor, minvalue);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1561,29 +1694,12 @@ void TBufferFile::ReadFastArrayWithNbits(Double_t *d, Int_t n, Int_t nbits)
 
    if (!nbits) {
       //we read a float and convert it to double
-      Float_t afloat;
-      for (Int_t i = 0; i < n; i++) {
-         *this >> afloat;
-         d[i] = (Double_t)afloat;
-      }
+      FromBufFloatAsDouble(fBufCur, d, n);
    } else {
       //we read the exponent and the truncated mantissa of the float
       //and rebuild the double.
-      union {
-         Float_t fFloatValue;
-         Int_t   fIntValue;
-      };
-      UChar_t  theExp;
-      UShort_t theMan;
-      for (Int_t i = 0; i < n; i++) {
-         *this >> theExp;
-         *this >> theMan;
-         fIntValue = theExp;
-         fIntValue <<= 23;
-         fIntValue |= (theMan & ((1<<(nbits+1))-1)) <<(23-nbits);
-         if (1<<(nbits+1) & theMan) fFloatValue = -fFloatValue;
-         d[i] = (Double_t)fFloatValue;
-      }
+      for (Int_t i = 0; i < n; i++)
+         d[i] = (Double_t)FromBufTruncatedFloat(fBufCur, nbits);
    }
 }
 
@@ -1737,8 +1853,8 @@ void TBufferFile::WriteArray(const Short_t *h, Int_t n)
    bswapcpy16(fBufCur, h, n);
    fBufCur += l;
 # else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, h[i]);
+   ByteSwapCopy<sizeof(h[0])>(fBufCur, (const char *)h, n);
+   fBufCur += l;
 # endif
 #else
    memcpy(fBufCur, h, l);
@@ -1767,8 +1883,8 @@ void TBufferFile::WriteArray(const Int_t *ii, Int_t n)
    bswapcpy32(fBufCur, ii, n);
    fBufCur += l;
 # else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, ii[i]);
+   ByteSwapCopy<sizeof(ii[0])>(fBufCur, (const char *)ii, n);
+   fBufCur += l;
 # endif
 #else
    memcpy(fBufCur, ii, l);
@@ -1831,8 +1947,8 @@ void TBufferFile::WriteArray(const Long64_t *ll, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, ll[i]);
+   ByteSwapCopy<sizeof(ll[0])>(fBufCur, (const char *)ll, n);
+   fBufCur += l;
 #else
    memcpy(fBufCur, ll, l);
    fBufCur += l;
@@ -1860,8 +1976,8 @@ void TBufferFile::WriteArray(const Float_t *f, Int_t n)
    bswapcpy32(fBufCur, f, n);
    fBufCur += l;
 # else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, f[i]);
+   ByteSwapCopy<sizeof(f[0])>(fBufCur, (const char *)f, n);
+   fBufCur += l;
 # endif
 #else
    memcpy(fBufCur, f, l);
@@ -1886,8 +2002,8 @@ void TBufferFile::WriteArray(const Double_t *d, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, d[i]);
+   ByteSwapCopy<sizeof(d[0])>(fBufCur, (const char *)d, n);
+   fBufCur += l;
 #else
    memcpy(fBufCur, d, l);
    fBufCur += l;
@@ -2003,8 +2119,8 @@ void TBufferFile::WriteFastArray(const Short_t *h, Int_t n)
    bswapcpy16(fBufCur, h, n);
    fBufCur += l;
 # else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, h[i]);
+   ByteSwapCopy<sizeof(h[0])>(fBufCur, (const char *)h, n);
+   fBufCur += l;
 # endif
 #else
    memcpy(fBufCur, h, l);
@@ -2027,8 +2143,8 @@ void TBufferFile::WriteFastArray(const Int_t *ii, Int_t n)
    bswapcpy32(fBufCur, ii, n);
    fBufCur += l;
 # else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, ii[i]);
+   ByteSwapCopy<sizeof(ii[0])>(fBufCur, (const char *)ii, n);
+   fBufCur += l;
 # endif
 #else
    memcpy(fBufCur, ii, l);
@@ -2075,8 +2191,8 @@ void TBufferFile::WriteFastArray(const Long64_t *ll, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, ll[i]);
+   ByteSwapCopy<sizeof(ll[0])>(fBufCur, (const char *)ll, n);
+   fBufCur += l;
 #else
    memcpy(fBufCur, ll, l);
    fBufCur += l;
@@ -2098,8 +2214,8 @@ void TBufferFile::WriteFastArray(const Float_t *f, Int_t n)
    bswapcpy32(fBufCur, f, n);
    fBufCur += l;
 # else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, f[i]);
+   ByteSwapCopy<sizeof(f[0])>(fBufCur, (const char *)f, n);
+   fBufCur += l;
 # endif
 #else
    memcpy(fBufCur, f, l);
@@ -2118,8 +2234,8 @@ void TBufferFile::WriteFastArray(const Double_t *d, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, d[i]);
+   ByteSwapCopy<sizeof(d[0])>(fBufCur, (const char *)d, n);
+   fBufCur += l;
 #else
    memcpy(fBufCur, d, l);
    fBufCur += l;
@@ -3554,6 +3670,8 @@ Int_t TBufferFile::ApplySequence(const TStreamerInfoActions::TActionSequence &se
          (*iter)(*this,obj);
       }
 
+   } else if (sequence.fJitted) {
+      return sequence.fJitted(*this, obj, sequence);
    } else {
       //loop on all active members
       TStreamerInfoActions::ActionContainer_t::const_iterator end = sequence.fActions.end();
@@ -47,7 +47,7 @@ TBufferMerger::~TBufferMerger()
    for (const auto &f : fAttachedFiles)
       if (!f.expired()) Fatal("TBufferMerger", " TBufferMergerFiles must be destroyed before the server");
 
-   if (!fQueue.empty())
+   if (fQueue.load())
       Merge();
 }
 
@@ -62,18 +62,24 @@ std::shared_ptr<TBufferMergerFile> TBufferMerger::GetFile()
 
 size_t TBufferMerger::GetQueueSize() const
 {
-   return fQueue.size();
+   return fQueueSize.load(std::memory_order_relaxed);
 }
 
 void TBufferMerger::Push(TBufferFile *buffer)
 {
-   {
-      std::lock_guard<std::mutex> lock(fQueueMutex);
-      fBuffered += buffer->BufferSize();
-      fQueue.push(buffer);
-   }
-
-   if (fBuffered > fAutoSave)
+   // Account for the buffer before publishing it, so that a concurrent
+   // Merge() can never subtract more than what has been added.
+   size_t size = buffer->BufferSize();
+   fQueueSize.fetch_add(1, std::memory_order_relaxed);
+   size_t buffered = fBuffered.fetch_add(size, std::memory_order_relaxed) + size;
+
+   // Producers only ever prepend to the list and the consumer detaches the
+   // whole list at once, so a single compare-and-swap loop is all we need.
+   auto node = new QueueNode{buffer, fQueue.load(std::memory_order_relaxed)};
+   while (!fQueue.compare_exchange_weak(node->fNext, node, std::memory_order_release, std::memory_order_relaxed))
+      ;
+
+   if (buffered > fAutoSave)
       Merge();
 }
 
@@ -101,17 +107,27 @@ void TBufferMerger::SetMergeOptions(const TString& options)
 void TBufferMerger::Merge()
 {
    if (fMergeMutex.try_lock()) {
-      std::queue<TBufferFile *> queue;
-      {
-         std::lock_guard<std::mutex> q(fQueueMutex);
-         std::swap(queue, fQueue);
-         fBuffered = 0;
+      QueueNode *head = fQueue.exchange(nullptr, std::memory_order_acquire);
+
+      // The list holds the most recent buffer first, reverse it to merge in push order.
+      QueueNode *list = nullptr;
+      size_t count = 0, size = 0;
+      while (head) {
+         QueueNode *next = head->fNext;
+         head->fNext = list;
+         list = head;
+         head = next;
+         ++count;
+         size += list->fBuffer->BufferSize();
       }
+      fQueueSize.fetch_sub(count, std::memory_order_relaxed);
+      fBuffered.fetch_sub(size, std::memory_order_relaxed);
 
-      while (!queue.empty()) {
-         std::unique_ptr<TBufferFile> buffer{queue.front()};
+      while (list) {
+         std::unique_ptr<QueueNode> node{list};
+         std::unique_ptr<TBufferFile> buffer{node->fBuffer};
          fMerger.AddAdoptFile(new TMemFile(fMerger.GetOutputFileName(), std::move(buffer)));
-         queue.pop();
+         list = node->fNext;
       }
 
       fMerger.PartialMerge();
@@ -92,6 +92,7 @@ The structure of a directory is shown in TDirectoryFile::TDirectoryFile
 
 #include "Bytes.h"
 #include "Compression.h"
+#include "RZip.h"
 #include "RConfigure.h"
 #include "Strlen.h"
 #include "strlcpy.h"
@@ -113,6 +114,7 @@ The structure of a directory is shown in TDirectoryFile::TDirectoryFile
 #include "TPluginManager.h"
 #include "TProcessUUID.h"
 #include "TRegexp.h"
+#include "TSharedMemFile.h"
 #include "TPRegexp.h"
 #include "TROOT.h"
 #include "TStreamerInfo.h"
@@ -129,9 +131,11 @@ The structure of a directory is shown in TDirectoryFile::TDirectoryFile
 #include "TObjString.h"
 #include "TStopwatch.h"
 #include "compiledata.h"
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <set>
+#include <vector>
 #include "TSchemaRule.h"
 #include "TSchemaRuleSet.h"
 #include "TThreadSlots.h"
@@ -1557,6 +1561,129 @@ void TFile::Map(Option_t *opt)
       Printf("At:%-*lld  N=%-8d K=    O=          %-14s", nDigits+1, idcur,1,"END");
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Verify the integrity of all records (keys and baskets) of the file.
+///
+/// The file is walked record by record, as in TFile::Map. The payload of every
+/// compressed record is read and decompressed; the checksums stored by the
+/// compression algorithms (zlib, LZMA, LZ4, and ZSTD if written with
+/// `Root.ZSTDChecksum` enabled) are verified in the process, without streaming
+/// any object. Records written with the legacy ROOT algorithm, ZSTD records
+/// without checksum and uncompressed records carry no checksum: they are only
+/// checked for a valid record header and decompressed size, and are counted as
+/// unchecked rather than verified.
+///
+/// If opt contains "v" every corrupted and every unchecked record is reported.
+/// If nunchecked is given, it is set to the number of unchecked records.
+/// Returns the number of corrupted records, or -1 if the file could not be
+/// walked to its end.
+
+Int_t TFile::Verify(Option_t *opt, Int_t *nunchecked)
+{
+   TString options(opt);
+   options.ToLower();
+   const bool verbose = options.Contains("v");
+
+   if (!IsOpen() || IsRaw())
+      return -1;
+
+   if (nunchecked)
+      *nunchecked = 0;
+
+   // nbytes (4), version (2), objlen (4), datime (4) and keylen (2) of the record
+   constexpr Int_t kRecordHeader = 16;
+   char header[kRecordHeader];
+   std::vector<char> compressed;
+   std::vector<unsigned char> uncompressed;
+   Int_t nbad = 0;
+   Int_t nnochecksum = 0;
+   Long64_t idcur = fBEGIN;
+
+   while (idcur < fEND) {
+      const Int_t nread = std::min<Long64_t>(kRecordHeader, fEND - idcur);
+      if (nread < kRecordHeader || ReadBuffer(header, idcur, nread)) {
+         Error("Verify", "%s: failed to read the record header at %lld.", GetName(), idcur);
+         return -1;
+      }
+
+      char *buffer = header;
+      Int_t nbytes, objlen;
+      Version_t versionkey;
+      UInt_t datime;
+      Short_t keylen;
+      frombuf(buffer, &nbytes);
+      if (nbytes < 0) {
+         // A gap left by a deleted record.
+         idcur -= nbytes;
+         continue;
+      }
+      frombuf(buffer, &versionkey);
+      frombuf(buffer, &objlen);
+      frombuf(buffer, &datime);
+      frombuf(buffer, &keylen);
+      if (nbytes == 0 || keylen <= 0 || keylen > nbytes || objlen < nbytes - keylen || idcur + nbytes > fEND) {
+         Error("Verify", "%s: invalid record header at %lld (N=%d K=%d O=%d), stopping.", GetName(), idcur, nbytes,
+               keylen, objlen);
+         return -1;
+      }
+
+      bool checked = false;
+      if (objlen != nbytes - keylen) {
+         checked = true;
+         const Int_t nzipped = nbytes - keylen;
+         compressed.resize(nzipped);
+         uncompressed.resize(objlen);
+         bool ok = !ReadBuffer(compressed.data(), idcur + keylen, nzipped);
+         auto bufcur = reinterpret_cast<unsigned char *>(compressed.data());
+         Int_t nleft = nzipped;
+         Int_t noutot = 0;
+         while (ok && noutot < objlen) {
+            // Every compressed block starts with a 9 byte envelope.
+            Int_t nin, nbuf, nout = 0;
+            if (nleft < 9 || R__unzip_header(&nin, bufcur, &nbuf) != 0 || nin > nleft || nbuf > objlen - noutot) {
+               ok = false;
+               break;
+            }
+            // The legacy algorithm has no checksum. A ZSTD frame has one if the content
+            // checksum flag of its frame header descriptor, after the magic number, is set.
+            if (bufcur[0] == 'C' && bufcur[1] == 'S') {
+               checked = false;
+            } else if (bufcur[0] == 'Z' && bufcur[1] == 'S') {
+               const unsigned char *frame = bufcur + 9;
+               if (nin < 9 + 5 || frame[0] != 0x28 || frame[1] != 0xb5 || frame[2] != 0x2f || frame[3] != 0xfd ||
+                   !(frame[4] & 0x04))
+                  checked = false;
+            }
+            R__unzip(&nin, bufcur, &nbuf, uncompressed.data() + noutot, &nout);
+            if (nout != nbuf) {
+               ok = false;
+               break;
+            }
+            noutot += nout;
+            bufcur += nin;
+            nleft -= nin;
+         }
+         if (!ok) {
+            ++nbad;
+            if (verbose)
+               Error("Verify", "%s: corrupted record at %lld (N=%d O=%d).", GetName(), idcur, nbytes, objlen);
+            idcur += nbytes;
+            continue;
+         }
+      }
+      if (!checked) {
+         ++nnochecksum;
+         if (verbose)
+            Info("Verify", "%s: record at %lld (N=%d O=%d) has no checksum, unchecked.", GetName(), idcur, nbytes,
+                 objlen);
+      }
+      idcur += nbytes;
+   }
+   if (nunchecked)
+      *nunchecked = nnochecksum;
+   return nbad;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Paint all objects in the file.
 
@@ -4043,6 +4170,15 @@ TFile *TFile::Open(const char *url, Option_t *options, const char *ftitle,
 
       IncrementFileCounter();
 
+      // Shared-memory segments published by TSharedMemFile::Publish
+      if (n.BeginsWith("shm:", TString::kIgnoreCase)) {
+         type = kDefault;
+         f = new TSharedMemFile(n, option, ftitle, compress);
+         if (f->IsZombie())
+            SafeDelete(f);
+         continue;
+      }
+
       // change names to be recognized by the plugin manager
       // e.g. /protocol/path/to/file.root -> protocol:/path/to/file.root
       TUrl urlname(n, kTRUE);
@@ -0,0 +1,192 @@
+// @(#)root/io:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/**
+\class TSharedMemFile TSharedMemFile.cxx
+\ingroup IO
+
+A read-only TMemFile whose content lives in a named shared-memory segment.
+
+One process fills a TMemFile and publishes it with TSharedMemFile::Publish();
+any number of other processes (for instance the workers of a
+ROOT::TProcessExecutor) then open the segment by name, either directly or via
+TFile::Open("shm:///name"). The segment is mapped read-only and the file is
+read in place: all readers share the same physical pages, the content is
+neither copied nor re-read from disk.
+
+~~~{.cpp}
+{
+   TMemFile calib("calib.root", "RECREATE");
+   // ... write objects and trees ...
+   calib.Write();
+   TSharedMemFile::Publish(calib, "calib");
+}
+// In any process on the same host:
+std::unique_ptr<TFile> f(TFile::Open("shm:///calib"));
+// Once no new reader needs it:
+TSharedMemFile::Unlink("calib");
+~~~
+
+Readers that already mapped the segment keep it alive after Unlink().
+*/
+
+#include "TSharedMemFile.h"
+#include "TError.h"
+
+#ifndef R__WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+ClassImp(TSharedMemFile);
+
+////////////////////////////////////////////////////////////////////////////////
+/// Open the shared-memory segment identified by url, which is either the
+/// plain segment name or "shm:///name". Only the "READ" option is supported.
+
+TSharedMemFile::TSharedMemFile(const char *url, Option_t *option, const char * /*ftitle*/, Int_t /*compress*/)
+   : TSharedMemFile(url, MapSegment(url, option))
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Wrap an existing mapping; becomes a zombie if the mapping is empty.
+
+TSharedMemFile::TSharedMemFile(const char *url, const RMapping &mapping)
+   : TMemFile(url, ZeroCopyView_t(static_cast<const char *>(mapping.fAddress), mapping.fSize)),
+     fMapAddress(mapping.fAddress), fMapSize(mapping.fSize)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Close the file, then release the mapping.
+
+TSharedMemFile::~TSharedMemFile()
+{
+   // The mapping must outlive Close(), which may still read from the file.
+   Close();
+#ifndef R__WIN32
+   if (fMapAddress)
+      munmap(fMapAddress, fMapSize);
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the name of the shared-memory segment for url, i.e. "/name" for
+/// "shm:///name", "shm:name" or "name"; URL options are dropped.
+
+TString TSharedMemFile::GetSegmentName(const char *url)
+{
+   TString name(url);
+   if (name.BeginsWith("shm:", TString::kIgnoreCase))
+      name.Remove(0, 4);
+   Ssiz_t opts = name.First('?');
+   if (opts != kNPOS)
+      name.Remove(opts);
+   name = name.Strip(TString::kBoth, '/');
+   name.Prepend('/');
+   return name;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Map the segment for url read-only; returns an empty mapping on failure.
+
+TSharedMemFile::RMapping TSharedMemFile::MapSegment(const char *url, Option_t *option)
+{
+   RMapping mapping;
+   TString opt(option);
+   opt.ToUpper();
+   if (!opt.IsNull() && opt != "READ") {
+      ::Error("TSharedMemFile::TSharedMemFile", "%s: only the READ option is supported", url);
+      return mapping;
+   }
+#ifdef R__WIN32
+   ::Error("TSharedMemFile::TSharedMemFile", "shared-memory files are not supported on Windows");
+#else
+   const TString segment = GetSegmentName(url);
+   int fd = shm_open(segment.Data(), O_RDONLY, 0);
+   if (fd < 0) {
+      ::SysError("TSharedMemFile::TSharedMemFile", "cannot open shared-memory segment %s", segment.Data());
+      return mapping;
+   }
+   struct stat st;
+   if (fstat(fd, &st) == 0 && st.st_size > 0) {
+      void *addr = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+      if (addr != MAP_FAILED) {
+         mapping.fAddress = addr;
+         mapping.fSize = st.st_size;
+      } else {
+         ::SysError("TSharedMemFile::TSharedMemFile", "cannot map shared-memory segment %s", segment.Data());
+      }
+   } else {
+      ::Error("TSharedMemFile::TSharedMemFile", "shared-memory segment %s is empty", segment.Data());
+   }
+   close(fd);
+#endif
+   return mapping;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy the content of file into a new shared-memory segment called name.
+/// The file must have been written (TFile::Write) beforehand. Fails if a
+/// segment with that name already exists.
+///
+/// Returns kTRUE on success.
+
+Bool_t TSharedMemFile::Publish(const TMemFile &file, const char *name)
+{
+#ifdef R__WIN32
+   ::Error("TSharedMemFile::Publish", "shared-memory files are not supported on Windows");
+   return kFALSE;
+#else
+   const TString segment = GetSegmentName(name);
+   const Long64_t size = file.GetSize();
+   int fd = shm_open(segment.Data(), O_CREAT | O_EXCL | O_RDWR, 0644);
+   if (fd < 0) {
+      ::SysError("TSharedMemFile::Publish", "cannot create shared-memory segment %s", segment.Data());
+      return kFALSE;
+   }
+   void *addr = MAP_FAILED;
+   if (ftruncate(fd, size) == 0)
+      addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+   close(fd);
+   if (addr == MAP_FAILED) {
+      ::SysError("TSharedMemFile::Publish", "cannot size or map shared-memory segment %s", segment.Data());
+      shm_unlink(segment.Data());
+      return kFALSE;
+   }
+   const Long64_t copied = file.CopyTo(addr, size);
+   munmap(addr, size);
+   if (copied != size) {
+      ::Error("TSharedMemFile::Publish", "copied %lld out of %lld bytes to %s", copied, size, segment.Data());
+      shm_unlink(segment.Data());
+      return kFALSE;
+   }
+   return kTRUE;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Remove the name of a segment created by Publish(). Processes that already
+/// opened it keep reading it; the memory is released once they are all done.
+///
+/// Returns kTRUE on success.
+
+Bool_t TSharedMemFile::Unlink(const char *name)
+{
+#ifdef R__WIN32
+   (void)name;
+   return kFALSE;
+#else
+   return shm_unlink(GetSegmentName(name).Data()) == 0;
+#endif
+}
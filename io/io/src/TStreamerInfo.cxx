@@ -79,6 +79,7 @@ element type.
 #include <array>
 
 std::atomic<Int_t> TStreamerInfo::fgCount{0};
+std::atomic<Bool_t> TStreamerInfo::fgJitActions{kFALSE};
 
 const Int_t kMaxLen = 1024;
 
@@ -2544,6 +2545,28 @@ void TStreamerInfo::BuildOld()
    Compile();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return whether the object-wise read actions of the TStreamerInfos compiled
+/// from now on are replaced by interpreter-generated streamers.
+
+Bool_t TStreamerInfo::GetJitActions()
+{
+   return fgJitActions;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Enable (or disable) the generation, via the interpreter, of straight-line
+/// streamers for the object-wise read actions (see TActionSequence::JitReadActions).
+/// This is only done for the TStreamerInfos describing the in-memory layout of
+/// a compiled class, i.e. when no schema evolution is involved, and only affects
+/// the TStreamerInfos compiled after the call.  The default is disabled.
+/// This function returns the previous value of fgJitActions.
+
+Bool_t TStreamerInfo::SetJitActions(Bool_t enable)
+{
+   return fgJitActions.exchange(enable);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// If opt contains 'built', reset this StreamerInfo as if Build or BuildOld
 /// was never called on it (useful to force their re-running).
@@ -2566,7 +2589,10 @@ void TStreamerInfo::Clear(Option_t *option)
       ResetIsCompiled();
       ResetBit(kBuildOldUsed);
 
-      if (fReadObjectWise) fReadObjectWise->fActions.clear();
+      if (fReadObjectWise) {
+         fReadObjectWise->fActions.clear();
+         fReadObjectWise->fJitted = nullptr;
+      }
       if (fReadMemberWise) fReadMemberWise->fActions.clear();
       if (fReadMemberWiseVecPtr) fReadMemberWiseVecPtr->fActions.clear();
       if (fReadText) fReadText->fActions.clear();
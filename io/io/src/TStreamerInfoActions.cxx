@@ -25,6 +25,9 @@
 #include "TProcessID.h"
 #include "TFile.h"
 
+#include <string>
+#include <unordered_map>
+
 static const Int_t kRegrouped = TStreamerInfo::kOffsetL;
 
 // More possible optimizations:
@@ -3006,7 +3009,10 @@ void TStreamerInfo::Compile()
    Int_t ndata = fElements->GetEntries();
 
 
-   if (fReadObjectWise) fReadObjectWise->fActions.clear();
+   if (fReadObjectWise) {
+      fReadObjectWise->fActions.clear();
+      fReadObjectWise->fJitted = nullptr;
+   }
    else fReadObjectWise = new TStreamerInfoActions::TActionSequence(this,ndata);
 
    if (fWriteObjectWise) fWriteObjectWise->fActions.clear();
@@ -3205,6 +3211,14 @@ void TStreamerInfo::Compile()
    }
    ComputeSize();
 
+   if (GetJitActions() && fClass && fClass->IsLoaded() && !fClass->GetCollectionProxy()
+       && fClassVersion == fClass->GetClassVersion() && fCheckSum == fClass->GetCheckSum()) {
+      // The on-file layout is the in-memory one (no schema evolution), so the object-wise
+      // read actions can be replaced by a straight-line streamer.  In all the other cases
+      // the interpreted actions are used.
+      fReadObjectWise->JitReadActions();
+   }
+
    fOptimized = isOptimized;
    SetIsCompiled();
 
@@ -4171,6 +4185,9 @@ void TStreamerInfoActions::TActionSequence::AddToOffset(Int_t delta)
    // Add the (potentially negative) delta to all the configuration's offset.  This is used by
    // TBranchElement in the case of split sub-object.
 
+   // The jitted streamer has the offsets hard-coded.
+   fJitted = nullptr;
+
    TStreamerInfoActions::ActionContainer_t::iterator end = fActions.end();
    for(TStreamerInfoActions::ActionContainer_t::iterator iter = fActions.begin();
        iter != end;
@@ -4186,6 +4203,8 @@ void TStreamerInfoActions::TActionSequence::SetMissing()
    // Add the (potentially negative) delta to all the configuration's offset.  This is used by
    // TBranchElement in the case of split sub-object.
 
+   fJitted = nullptr;
+
    TStreamerInfoActions::ActionContainer_t::iterator end = fActions.end();
    for(TStreamerInfoActions::ActionContainer_t::iterator iter = fActions.begin();
        iter != end;
@@ -4196,6 +4215,148 @@ void TStreamerInfoActions::TActionSequence::SetMissing()
    }
 }
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the fundamental type and the TBufferFile method suffix (e.g. "Int_t"
+/// and "Int") corresponding to the basic type code, or nullptrs for the types
+/// (Bits, Float16, Double32, ...) that need more than a plain read.
+
+std::pair<const char *, const char *> GetJitBasicType(Int_t type)
+{
+   switch (type) {
+      case TStreamerInfo::kBool:    return {"Bool_t", "Bool"};
+      case TStreamerInfo::kChar:    return {"Char_t", "Char"};
+      case TStreamerInfo::kShort:   return {"Short_t", "Short"};
+      case TStreamerInfo::kInt:     return {"Int_t", "Int"};
+      case TStreamerInfo::kLong:    return {"Long_t", "Long"};
+      case TStreamerInfo::kLong64:  return {"Long64_t", "Long64"};
+      case TStreamerInfo::kFloat:   return {"Float_t", "Float"};
+      case TStreamerInfo::kDouble:  return {"Double_t", "Double"};
+      case TStreamerInfo::kUChar:   return {"UChar_t", "UChar"};
+      case TStreamerInfo::kUShort:  return {"UShort_t", "UShort"};
+      case TStreamerInfo::kUInt:    return {"UInt_t", "UInt"};
+      case TStreamerInfo::kULong:   return {"ULong_t", "ULong"};
+      case TStreamerInfo::kULong64: return {"ULong64_t", "ULong64"};
+      default:                      return {nullptr, nullptr};
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the basic type code read by a plain ReadBasicType action, or -1.
+
+Int_t GetJitReadBasicTypeCode(TStreamerInfoAction_t action)
+{
+   if (action == ReadBasicType<Bool_t>)    return TStreamerInfo::kBool;
+   if (action == ReadBasicType<Char_t>)    return TStreamerInfo::kChar;
+   if (action == ReadBasicType<Short_t>)   return TStreamerInfo::kShort;
+   if (action == ReadBasicType<Int_t>)     return TStreamerInfo::kInt;
+   if (action == ReadBasicType<Long_t>)    return TStreamerInfo::kLong;
+   if (action == ReadBasicType<Long64_t>)  return TStreamerInfo::kLong64;
+   if (action == ReadBasicType<Float_t>)   return TStreamerInfo::kFloat;
+   if (action == ReadBasicType<Double_t>)  return TStreamerInfo::kDouble;
+   if (action == ReadBasicType<UChar_t>)   return TStreamerInfo::kUChar;
+   if (action == ReadBasicType<UShort_t>)  return TStreamerInfo::kUShort;
+   if (action == ReadBasicType<UInt_t>)    return TStreamerInfo::kUInt;
+   if (action == ReadBasicType<ULong_t>)   return TStreamerInfo::kULong;
+   if (action == ReadBasicType<ULong64_t>) return TStreamerInfo::kULong64;
+   return -1;
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Generate, via the interpreter, a straight-line function equivalent to this
+/// sequence of read actions and store it in fJitted, to be used by
+/// TBufferFile::ApplySequence.
+///
+/// Members of fundamental type and fixed size arrays thereof are read with
+/// direct (non-virtual, inlined) calls to TBufferFile, with their offsets
+/// hard-coded; all the other actions are called through the sequence.
+/// Functions are cached by their generated code, i.e. per on-file/in-memory
+/// layout, and shared between sequences with identical layouts.
+/// Returns false if nothing was generated, in which case the interpreted
+/// sequence is used.
+
+Bool_t TStreamerInfoActions::TActionSequence::JitReadActions()
+{
+   fJitted = nullptr;
+   if (!gInterpreter || fLoopConfig)
+      return kFALSE;
+
+   std::string body;
+   Int_t nbasic = 0;
+   for (size_t i = 0; i < fActions.size(); ++i) {
+      const TConfiguration *conf = fActions[i].fConfiguration;
+      if (conf->fOffset == TVirtualStreamerInfo::kMissing) {
+         body += "   s.fActions[" + std::to_string(i) + "](b, obj);\n";
+         continue;
+      }
+      Int_t type = GetJitReadBasicTypeCode(fActions[i].fAction);
+      if (type != -1) {
+         auto names = GetJitBasicType(type);
+         body += std::string("   b.TBufferFile::Read") + names.second + "(*(" + names.first + " *)(o + " +
+                 std::to_string(conf->fOffset) + "));\n";
+         ++nbasic;
+         continue;
+      }
+      if (fActions[i].fAction == GenericReadAction && conf->fCompInfo->fType > TStreamerInfo::kOffsetL &&
+          conf->fCompInfo->fType < TStreamerInfo::kOffsetP && !conf->fCompInfo->fElem->TestBit(TStreamerElement::kCache)) {
+         // Fixed size array of, or regrouped consecutive members of, a fundamental type.
+         auto names = GetJitBasicType(conf->fCompInfo->fType - TStreamerInfo::kOffsetL);
+         if (names.first) {
+            body += std::string("   b.TBufferFile::ReadFastArray((") + names.first + " *)(o + " +
+                    std::to_string(conf->fCompInfo->fOffset + conf->fOffset) + "), " +
+                    std::to_string(conf->fCompInfo->fLength) + ");\n";
+            ++nbasic;
+            continue;
+         }
+      }
+      body += "   s.fActions[" + std::to_string(i) + "](b, obj);\n";
+   }
+   if (!nbasic)
+      return kFALSE;
+
+   R__LOCKGUARD(gInterpreterMutex);
+   static std::unordered_map<std::string, JittedReadAction_t> gJittedReadActions;
+   auto cached = gJittedReadActions.find(body);
+   if (cached != gJittedReadActions.end()) {
+      fJitted = cached->second;
+      return fJitted != nullptr;
+   }
+
+   std::string name = "ReadActions" + std::to_string(gJittedReadActions.size());
+   std::string code = "#include \"TBufferFile.h\"\n"
+                      "#include \"TStreamerInfoActions.h\"\n"
+                      "namespace ROOT { namespace Internal { namespace StreamerInfoJit {\n"
+                      "Int_t " + name + "(TBuffer &buf, void *obj, const TStreamerInfoActions::TActionSequence &s)\n"
+                      "{\n"
+                      "   TBufferFile &b = static_cast<TBufferFile &>(buf);\n"
+                      "   char *o = (char *)obj;\n"
+                      "   (void)o; (void)s;\n" +
+                      body +
+                      "   return 0;\n"
+                      "}\n"
+                      "}}}\n";
+
+   JittedReadAction_t jitted = nullptr;
+   if (gInterpreter->Declare(code.c_str())) {
+      TInterpreter::EErrorCode error = TInterpreter::kNoError;
+      std::string address = "(Long_t)&ROOT::Internal::StreamerInfoJit::" + name + ";";
+      Long_t result = gInterpreter->Calc(address.c_str(), &error);
+      if (error == TInterpreter::kNoError)
+         jitted = reinterpret_cast<JittedReadAction_t>(result);
+   }
+   if (!jitted)
+      Warning("TActionSequence::JitReadActions", "Could not generate the streamer of %s, using the interpreted actions.",
+              fStreamerInfo->GetName());
+
+   // Also cache failures, to not try again.
+   gJittedReadActions[body] = jitted;
+   fJitted = jitted;
+   return fJitted != nullptr;
+}
+
 TStreamerInfoActions::TActionSequence *TStreamerInfoActions::TActionSequence::CreateCopy()
 {
    // Create a copy of this sequence.
@@ -0,0 +1,18 @@
+#ifndef ROOT_TEST_JITREADACTIONSSTRUCT
+#define ROOT_TEST_JITREADACTIONSSTRUCT
+
+/**
+ * Input of the TFile.JitReadActions test. No other test streams this
+ * class, so the test compiles its TStreamerInfo itself.
+ */
+
+class JitReadActionsStruct {
+public:
+   int fInt = 0;
+   short fShort = 0;
+   double fDoubles[3] = {0., 0., 0.};
+   float fFloat = 0.f;
+   long long fLong64 = 0;
+};
+
+#endif
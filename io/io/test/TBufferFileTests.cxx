@@ -0,0 +1,142 @@
+#include "TBufferFile.h"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// Expected on-file bytes of the elements of v: the bit pattern of each value,
+// most significant byte first, derived independently of the host byte order.
+template <typename T>
+static std::vector<unsigned char> BigEndianBytes(const std::vector<T> &v)
+{
+   static_assert(sizeof(T) <= sizeof(std::uint64_t), "unsupported element size");
+   std::vector<unsigned char> bytes;
+   for (const T &value : v) {
+      std::uint64_t bits = 0;
+      if (sizeof(T) == 2) {
+         std::uint16_t b;
+         std::memcpy(&b, &value, 2);
+         bits = b;
+      } else if (sizeof(T) == 4) {
+         std::uint32_t b;
+         std::memcpy(&b, &value, 4);
+         bits = b;
+      } else {
+         std::memcpy(&bits, &value, 8);
+      }
+      for (int i = sizeof(T) - 1; i >= 0; --i)
+         bytes.push_back((bits >> (8 * i)) & 0xff);
+   }
+   return bytes;
+}
+
+static std::vector<unsigned char> BufferBytes(const TBufferFile &buf, Int_t offset, std::size_t n)
+{
+   auto begin = reinterpret_cast<const unsigned char *>(buf.Buffer()) + offset;
+   return std::vector<unsigned char>(begin, begin + n);
+}
+
+template <typename T>
+static void CheckFastArrayRoundTrip(Int_t n)
+{
+   std::vector<T> in(n), out(n);
+   for (Int_t i = 0; i < n; ++i)
+      in[i] = T(i * 37 + 11) / T(3);
+
+   TBufferFile buf(TBuffer::kWrite);
+   buf.WriteFastArray(in.data(), n);
+   buf.WriteArray(in.data(), n);
+
+   // On file, each element is stored big endian; WriteArray precedes its elements by their count.
+   const auto expected = BigEndianBytes(in);
+   EXPECT_EQ(expected, BufferBytes(buf, 0, expected.size())) << "WriteFastArray of " << n << " elements";
+   EXPECT_EQ(BigEndianBytes(std::vector<Int_t>{n}), BufferBytes(buf, expected.size(), sizeof(Int_t)));
+   EXPECT_EQ(expected, BufferBytes(buf, expected.size() + sizeof(Int_t), expected.size()))
+      << "WriteArray of " << n << " elements";
+
+   buf.SetReadMode();
+   buf.SetBufferOffset(0);
+   buf.ReadFastArray(out.data(), n);
+   EXPECT_EQ(in, out) << "ReadFastArray of " << n << " elements";
+
+   std::fill(out.begin(), out.end(), T(0));
+   T *ptr = out.data();
+   EXPECT_EQ(n, buf.ReadArray(ptr));
+   EXPECT_EQ(in, out) << "ReadArray of " << n << " elements";
+}
+
+// Cover the vectorized byte swapping loops as well as their scalar tails.
+TEST(TBufferFile, FastArrayRoundTrip)
+{
+   for (Int_t n : {1, 3, 15, 16, 17, 33, 1000, 1023}) {
+      CheckFastArrayRoundTrip<Short_t>(n);
+      CheckFastArrayRoundTrip<Int_t>(n);
+      CheckFastArrayRoundTrip<Long64_t>(n);
+      CheckFastArrayRoundTrip<Float_t>(n);
+      CheckFastArrayRoundTrip<Double_t>(n);
+   }
+}
+
+// Read arrays of known big-endian byte sequences, with the lengths of the
+// vectorized loops and their tails.
+template <typename T, std::size_t N>
+static void CheckReadBigEndian(const unsigned char (&bytes)[N], T value)
+{
+   static_assert(N == sizeof(T), "one element per byte sequence");
+   for (Int_t n : {1, 3, 7, 8, 9, 15, 16, 17, 31, 32, 33, 1023}) {
+      std::vector<char> raw;
+      for (Int_t i = 0; i < n; ++i)
+         raw.insert(raw.end(), bytes, bytes + N);
+
+      TBufferFile buf(TBuffer::kRead, raw.size(), raw.data(), kFALSE);
+      std::vector<T> out(n);
+      buf.ReadFastArray(out.data(), n);
+      EXPECT_EQ(std::vector<T>(n, value), out) << "ReadFastArray of " << n << " elements";
+
+      TBufferFile wbuf(TBuffer::kWrite);
+      wbuf.WriteFastArray(out.data(), n);
+      EXPECT_EQ(std::vector<unsigned char>(raw.begin(), raw.end()), BufferBytes(wbuf, 0, raw.size()))
+         << "WriteFastArray of " << n << " elements";
+   }
+}
+
+TEST(TBufferFile, FastArrayBigEndian)
+{
+   const unsigned char shortBytes[] = {0x12, 0x34};
+   CheckReadBigEndian<Short_t>(shortBytes, 0x1234);
+   const unsigned char ushortBytes[] = {0xfe, 0xdc};
+   CheckReadBigEndian<UShort_t>(ushortBytes, 0xfedc);
+   const unsigned char intBytes[] = {0x12, 0x34, 0x56, 0x78};
+   CheckReadBigEndian<Int_t>(intBytes, 0x12345678);
+   const unsigned char uintBytes[] = {0xfe, 0xdc, 0xba, 0x98};
+   CheckReadBigEndian<UInt_t>(uintBytes, 0xfedcba98u);
+   const unsigned char long64Bytes[] = {0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef};
+   CheckReadBigEndian<Long64_t>(long64Bytes, 0x0123456789abcdefLL);
+   // -1.5f is 0xbfc00000, 3.0 is 0x4008000000000000.
+   const unsigned char floatBytes[] = {0xbf, 0xc0, 0x00, 0x00};
+   CheckReadBigEndian<Float_t>(floatBytes, -1.5f);
+   const unsigned char doubleBytes[] = {0x40, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+   CheckReadBigEndian<Double_t>(doubleBytes, 3.0);
+}
+
+TEST(TBufferFile, ReadFastArrayWithFactor)
+{
+   const Int_t n = 700;
+   std::vector<UInt_t> in(n);
+   for (Int_t i = 0; i < n; ++i)
+      in[i] = i * 1000;
+
+   TBufferFile buf(TBuffer::kWrite);
+   buf.WriteFastArray(in.data(), n);
+
+   const Double_t factor = 4.;
+   const Double_t xmin = -10.;
+   std::vector<Double_t> out(n);
+   buf.SetReadMode();
+   buf.SetBufferOffset(0);
+   buf.ReadFastArrayWithFactor(out.data(), n, factor, xmin);
+   for (Int_t i = 0; i < n; ++i)
+      EXPECT_DOUBLE_EQ(in[i] / factor + xmin, out[i]);
+}
@@ -178,6 +178,58 @@ TEST(TBufferMerger, AutoSave)
    RemoveFile("tbuffermerger_autosave.root");
 }
 
+TEST(TBufferMerger, QueueKeepsPushOrder)
+{
+   int nbuffers = 8;
+   int nevents = 16;
+
+   ROOT::EnableThreadSafety();
+
+   {
+      TBufferMerger merger("tbuffermerger_order.root");
+
+      // Large enough that no merge happens before the merger is destroyed
+      merger.SetAutoSave(1024 * 1024 * 1024);
+
+      auto myfile = merger.GetFile();
+      auto mytree = new TTree("mytree", "mytree");
+      mytree->ResetBit(kMustCleanup);
+
+      int n = 0;
+      mytree->Branch("n", &n, "n/I");
+
+      for (int i = 0; i < nbuffers; ++i) {
+         for (int j = 0; j < nevents; ++j) {
+            n = i * nevents + j;
+            mytree->Fill();
+         }
+         myfile->Write();
+         EXPECT_EQ(size_t(i + 1), merger.GetQueueSize());
+      }
+
+      mytree->ResetBranchAddresses();
+   }
+
+   {
+      TFile f("tbuffermerger_order.root");
+      auto t = (TTree *)f.Get("mytree");
+      ASSERT_TRUE(t != nullptr);
+
+      int n;
+      int nentries = (int)t->GetEntries();
+      EXPECT_EQ(nbuffers * nevents, nentries);
+
+      t->SetBranchAddress("n", &n);
+
+      for (int i = 0; i < nentries; ++i) {
+         t->GetEntry(i);
+         EXPECT_EQ(i, n);
+      }
+   }
+
+   RemoveFile("tbuffermerger_order.root");
+}
+
 TEST(TBufferMerger, CheckTreeFillResults)
 {
    int sum_s, sum_p;
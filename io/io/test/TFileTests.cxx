@@ -1,4 +1,18 @@
+#include "TClass.h"
 #include "TFile.h"
+#include "TKey.h"
+#include "TMemFile.h"
+#include "TNamed.h"
+#include "TStreamerInfo.h"
+#include "TStreamerInfoActions.h"
+#include "TSystem.h"
+
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "JitReadActionsStruct.h"
+#include "ZipZSTD.h"
 
 #include "gtest/gtest.h"
 
@@ -21,4 +35,115 @@ TEST(TFile, ReadFromSameFile)
    auto o2 = f2.Get(objpath);
 
    EXPECT_TRUE(o1 != o2) << "Same objects read from two different files have the same pointer!";
-}
\ No newline at end of file
+}
+
+TEST(TFile, JitReadActions)
+{
+   auto wasEnabled = TStreamerInfo::SetJitActions(kTRUE);
+   {
+      TMemFile f("JitReadActions.root", "RECREATE");
+      JitReadActionsStruct obj;
+      obj.fInt = 42;
+      obj.fShort = -7;
+      obj.fDoubles[0] = 1.5;
+      obj.fDoubles[1] = -2.25;
+      obj.fDoubles[2] = 1e100;
+      obj.fFloat = 2.5f;
+      obj.fLong64 = 1LL << 40;
+      f.WriteObject(&obj, "obj");
+
+      // The StreamerInfo of this class is only ever compiled here, with jitting enabled.
+      auto info = static_cast<TStreamerInfo *>(TClass::GetClass<JitReadActionsStruct>()->GetStreamerInfo());
+      ASSERT_TRUE(info != nullptr);
+      EXPECT_TRUE(info->GetReadObjectWiseActions()->fJitted != nullptr);
+
+      std::unique_ptr<JitReadActionsStruct> read(f.Get<JitReadActionsStruct>("obj"));
+      ASSERT_TRUE(read != nullptr);
+      EXPECT_EQ(42, read->fInt);
+      EXPECT_EQ(-7, read->fShort);
+      EXPECT_DOUBLE_EQ(1.5, read->fDoubles[0]);
+      EXPECT_DOUBLE_EQ(-2.25, read->fDoubles[1]);
+      EXPECT_DOUBLE_EQ(1e100, read->fDoubles[2]);
+      EXPECT_FLOAT_EQ(2.5f, read->fFloat);
+      EXPECT_EQ(1LL << 40, read->fLong64);
+   }
+   TStreamerInfo::SetJitActions(wasEnabled);
+}
+
+TEST(TFile, VerifyDetectsCorruptedRecords)
+{
+   const auto filename = "VerifyDetectsCorruptedRecords.root";
+   // ZSTD records only carry a checksum if requested.
+   const auto zstdChecksum = R__SetZSTDChecksum(1);
+   for (int settings : {101, 207, 404, 505}) {
+      Long64_t seek = 0;
+      Int_t keylen = 0, nbytes = 0;
+      {
+         TFile f(filename, "RECREATE", "", settings);
+         std::string title;
+         for (int i = 0; i < 1000; ++i)
+            title += std::to_string(i);
+         TNamed named("named", title.c_str());
+         f.WriteObject(&named, "named");
+         f.Write();
+         auto key = f.GetKey("named");
+         ASSERT_TRUE(key != nullptr);
+         seek = key->GetSeekKey();
+         keylen = key->GetKeylen();
+         nbytes = key->GetNbytes();
+         ASSERT_LT(nbytes - keylen, key->GetObjlen()) << "record is not compressed";
+      }
+      {
+         TFile f(filename);
+         EXPECT_EQ(0, f.Verify()) << "settings " << settings;
+      }
+      {
+         // Flip a byte in the middle of the compressed payload.
+         std::fstream raw(filename, std::ios::in | std::ios::out | std::ios::binary);
+         const auto pos = seek + keylen + (nbytes - keylen) / 2;
+         raw.seekg(pos);
+         char c = raw.get();
+         raw.seekp(pos);
+         raw.put(c ^ 0x5a);
+      }
+      {
+         TFile f(filename);
+         EXPECT_EQ(1, f.Verify()) << "settings " << settings;
+      }
+   }
+   gSystem->Unlink(filename);
+   R__SetZSTDChecksum(zstdChecksum);
+}
+
+TEST(TFile, VerifyReportsRecordsWithoutChecksum)
+{
+   const auto filename = "VerifyReportsRecordsWithoutChecksum.root";
+   const auto zstdChecksum = R__SetZSTDChecksum(1);
+   // Number of unchecked records for the given compression settings.
+   auto countUnchecked = [&](int settings) {
+      {
+         TFile f(filename, "RECREATE", "", settings);
+         std::string title;
+         for (int i = 0; i < 1000; ++i)
+            title += std::to_string(i);
+         TNamed named("named", title.c_str());
+         f.WriteObject(&named, "named");
+         f.Write();
+      }
+      TFile f(filename);
+      Int_t nunchecked = -1;
+      EXPECT_EQ(0, f.Verify("", &nunchecked)) << "settings " << settings;
+      return nunchecked;
+   };
+
+   // Records that are not compressed, like the key list, have no checksum in any case.
+   const Int_t withChecksum = countUnchecked(505);
+   EXPECT_GT(withChecksum, 0);
+   EXPECT_EQ(withChecksum, countUnchecked(101));
+   EXPECT_GT(countUnchecked(0), withChecksum);
+   R__SetZSTDChecksum(0);
+   EXPECT_GT(countUnchecked(505), withChecksum);
+
+   gSystem->Unlink(filename);
+   R__SetZSTDChecksum(zstdChecksum);
+}
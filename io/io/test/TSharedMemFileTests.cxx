@@ -0,0 +1,104 @@
+#include "TError.h"
+#include "TFile.h"
+#include "TMemFile.h"
+#include "TNamed.h"
+#include "TSharedMemFile.h"
+#include "TTree.h"
+
+#include <memory>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "gtest/gtest.h"
+
+static std::string SegmentName(const char *test)
+{
+   return std::string("TSharedMemFileTests_") + test + "_" + std::to_string(getpid());
+}
+
+static void PublishCalibration(const std::string &segment)
+{
+   TMemFile calib("calib.root", "RECREATE");
+   TNamed named("named", "calibration constants");
+   calib.WriteTObject(&named);
+   TTree tree("tree", "tree");
+   int i = 0;
+   tree.Branch("i", &i);
+   for (i = 0; i < 1000; ++i)
+      tree.Fill();
+   tree.Write();
+   calib.Write();
+   ASSERT_TRUE(TSharedMemFile::Publish(calib, segment.c_str()));
+}
+
+TEST(TSharedMemFile, PublishAndRead)
+{
+   const auto segment = SegmentName("PublishAndRead");
+   PublishCalibration(segment);
+
+   {
+      TSharedMemFile f(segment.c_str());
+      ASSERT_FALSE(f.IsZombie());
+      std::unique_ptr<TNamed> named(f.Get<TNamed>("named"));
+      ASSERT_TRUE(named != nullptr);
+      EXPECT_STREQ("calibration constants", named->GetTitle());
+   }
+   {
+      std::unique_ptr<TFile> f(TFile::Open(("shm:///" + segment).c_str()));
+      ASSERT_TRUE(f != nullptr);
+      auto tree = f->Get<TTree>("tree");
+      ASSERT_TRUE(tree != nullptr);
+      int i = -1;
+      tree->SetBranchAddress("i", &i);
+      ASSERT_EQ(1000, tree->GetEntries());
+      for (Long64_t e = 0; e < tree->GetEntries(); ++e) {
+         tree->GetEntry(e);
+         EXPECT_EQ(e, i);
+      }
+   }
+   EXPECT_TRUE(TSharedMemFile::Unlink(segment.c_str()));
+}
+
+TEST(TSharedMemFile, ReadFromChildProcess)
+{
+   const auto segment = SegmentName("ReadFromChildProcess");
+   PublishCalibration(segment);
+
+   pid_t pid = fork();
+   ASSERT_NE(-1, pid);
+   if (pid == 0) {
+      TSharedMemFile f(segment.c_str());
+      std::unique_ptr<TNamed> named(f.Get<TNamed>("named"));
+      _exit(named && std::string(named->GetTitle()) == "calibration constants" ? 0 : 1);
+   }
+   int status = 0;
+   waitpid(pid, &status, 0);
+   EXPECT_TRUE(WIFEXITED(status));
+   EXPECT_EQ(0, WEXITSTATUS(status));
+   EXPECT_TRUE(TSharedMemFile::Unlink(segment.c_str()));
+}
+
+TEST(TSharedMemFile, Errors)
+{
+   const auto segment = SegmentName("Errors");
+   PublishCalibration(segment);
+   auto oldIgnoreLevel = gErrorIgnoreLevel;
+   gErrorIgnoreLevel = kBreak;
+   {
+      TMemFile other("other.root", "RECREATE");
+      other.Write();
+      // A published segment cannot be overwritten.
+      EXPECT_FALSE(TSharedMemFile::Publish(other, segment.c_str()));
+   }
+   {
+      TSharedMemFile f(segment.c_str(), "UPDATE");
+      EXPECT_TRUE(f.IsZombie());
+   }
+   EXPECT_TRUE(TSharedMemFile::Unlink(segment.c_str()));
+   {
+      TSharedMemFile f(segment.c_str());
+      EXPECT_TRUE(f.IsZombie());
+   }
+   gErrorIgnoreLevel = oldIgnoreLevel;
+}
@@ -27,9 +27,11 @@
 
 #include "Math/Integrator.h"
 #include "Math/IntegratorMultiDim.h"
+#include "Math/Util.h"
 
 #include "TError.h"
 #include <vector>
+#include <algorithm>
 
 // using parameter cache is not thread safe but needed for normalizing the functions
 #define USE_PARAMCACHE
@@ -117,6 +119,30 @@ namespace FitUtil {
      double weight2;
   };
 
+  // compensated sums of the log-likelihood terms and of the weights of the
+  // data points, see EvaluateSumInChunks
+  struct LikelihoodSum {
+     ROOT::Math::KahanSum<double> logvalue;
+     ROOT::Math::KahanSum<double> weight;
+     ROOT::Math::KahanSum<double> weight2;
+
+     LikelihoodSum &operator+=(const LikelihoodAux<double> &l)
+     {
+        logvalue += l.logvalue;
+        weight += l.weight;
+        weight2 += l.weight2;
+        return *this;
+     }
+
+     LikelihoodSum &operator+=(const LikelihoodSum &l)
+     {
+        logvalue += l.logvalue;
+        weight += l.weight;
+        weight2 += l.weight2;
+        return *this;
+     }
+  };
+
   // internal class to evaluate the function or the integral
   // and cached internal integration details
   // if useIntegral is false no allocation is done
@@ -369,6 +395,53 @@ namespace FitUtil {
 
    unsigned setAutomaticChunking(unsigned nEvents);
 
+   /**
+       Sum mapFunction(i) for i in [0, n) into a compensated sum of type Sum
+       (ROOT::Math::KahanSum<double> or LikelihoodSum). The points are split
+       in nChunks chunks of consecutive points (setAutomaticChunking(n) if
+       nChunks is 0), summed serially or in parallel depending on the
+       execution policy; the chunk sums are then added in order. The result
+       depends only on the chunking, not on the execution policy nor on the
+       number of threads.
+   */
+   template <class Sum, class MapFunction>
+   Sum EvaluateSumInChunks(const MapFunction &mapFunction, unsigned n, ROOT::Fit::ExecutionPolicy executionPolicy,
+                           unsigned nChunks)
+   {
+      if (n == 0)
+         return Sum{};
+      if (nChunks == 0)
+         nChunks = setAutomaticChunking(n);
+      nChunks = std::min(std::max(nChunks, 1u), n);
+      const unsigned step = (n + nChunks - 1) / nChunks;
+      nChunks = (n + step - 1) / step;
+
+      auto chunkSum = [&](unsigned c) {
+         Sum sum{};
+         const unsigned end = std::min(n, (c + 1) * step);
+         for (unsigned i = c * step; i < end; ++i)
+            sum += mapFunction(i);
+         return sum;
+      };
+
+      Sum total{};
+#ifdef R__USE_IMT
+      if (executionPolicy == ROOT::Fit::ExecutionPolicy::kMultithread) {
+         std::vector<Sum> sums(nChunks);
+         ROOT::TThreadExecutor pool;
+         pool.Foreach([&](unsigned c) { sums[c] = chunkSum(c); }, ROOT::TSeq<unsigned>(0, nChunks));
+         for (auto &sum : sums)
+            total += sum;
+         return total;
+      }
+#else
+      (void)executionPolicy;
+#endif
+      for (unsigned c = 0; c < nChunks; ++c)
+         total += chunkSum(c);
+      return total;
+   }
+
    template<class T>
    struct Evaluate {
 #ifdef R__HAS_VECCORE
@@ -230,6 +230,15 @@ namespace ROOT {
          return *this;
        }
 
+       /// Add the compensated sum `other` into this accumulator, keeping its
+       /// compensation. Does not vectorise.
+       template <unsigned int M>
+       KahanSum<T, N>& operator+=(const KahanSum<T, M>& other) {
+         Add(other.Sum());
+         Add(-other.Carry());
+         return *this;
+       }
+
      private:
        T fSum[N];
        T fCarry[N];
@@ -376,13 +376,7 @@ namespace ROOT {
       return chi2;
   };
 
-#ifdef R__USE_IMT
-  auto redFunction = [](const std::vector<double> & objs){
-                          return std::accumulate(objs.begin(), objs.end(), double{});
-  };
-#else
-  (void)nChunks;
-
+#ifndef R__USE_IMT
   // If IMT is disabled, force the execution policy to the serial case
   if (executionPolicy == ROOT::Fit::ExecutionPolicy::kMultithread) {
      Warning("FitUtil::EvaluateChi2", "Multithread execution policy requires IMT, which is disabled. Changing "
@@ -392,16 +386,10 @@ namespace ROOT {
 #endif
 
   double res{};
-  if(executionPolicy == ROOT::Fit::ExecutionPolicy::kSerial){
-    for (unsigned int i=0; i<n; ++i) {
-      res += mapFunction(i);
-    }
-#ifdef R__USE_IMT
-  } else if(executionPolicy == ROOT::Fit::ExecutionPolicy::kMultithread) {
-    ROOT::TThreadExecutor pool;
-    auto chunks = nChunks !=0? nChunks: setAutomaticChunking(data.Size());
-    res = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, n), redFunction, chunks);
-#endif
+  if (executionPolicy == ROOT::Fit::ExecutionPolicy::kSerial ||
+      executionPolicy == ROOT::Fit::ExecutionPolicy::kMultithread) {
+    // same compensated sum over the same chunks for both policies
+    res = EvaluateSumInChunks<ROOT::Math::KahanSum<double>>(mapFunction, n, executionPolicy, nChunks);
 //   } else if(executionPolicy == ROOT::Fit::kMultitProcess){
     // ROOT::TProcessExecutor pool;
     // res = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, n), redFunction);
@@ -1017,24 +1005,7 @@ double FitUtil::EvaluateLogL(const IModelFunctionTempl<double> &func, const UnBi
             return LikelihoodAux<double>(logval, W, W2);
          };
 
-#ifdef R__USE_IMT
-  // auto redFunction = [](const std::vector<LikelihoodAux<double>> & objs){
-  //          return std::accumulate(objs.begin(), objs.end(), LikelihoodAux<double>(0.0,0.0,0.0),
-  //                      [](const LikelihoodAux<double> &l1, const LikelihoodAux<double> &l2){
-  //                          return l1+l2;
-  //                 });
-  // };
-  // do not use std::accumulate to be sure to maintain always the same order
-  auto redFunction = [](const std::vector<LikelihoodAux<double>> & objs){
-     auto l0 =  LikelihoodAux<double>(0.0,0.0,0.0);
-     for ( auto & l : objs ) {
-        l0 = l0 + l;
-     }
-     return l0;
-  };
-#else
-  (void)nChunks;
-
+#ifndef R__USE_IMT
   // If IMT is disabled, force the execution policy to the serial case
   if (executionPolicy == ROOT::Fit::ExecutionPolicy::kMultithread) {
      Warning("FitUtil::EvaluateLogL", "Multithread execution policy requires IMT, which is disabled. Changing "
@@ -1046,22 +1017,13 @@ double FitUtil::EvaluateLogL(const IModelFunctionTempl<double> &func, const UnBi
   double logl{};
   double sumW{};
   double sumW2{};
-  if(executionPolicy == ROOT::Fit::ExecutionPolicy::kSerial){
-    for (unsigned int i=0; i<n; ++i) {
-      auto resArray = mapFunction(i);
-      logl+=resArray.logvalue;
-      sumW+=resArray.weight;
-      sumW2+=resArray.weight2;
-    }
-#ifdef R__USE_IMT
-  } else if(executionPolicy == ROOT::Fit::ExecutionPolicy::kMultithread) {
-    ROOT::TThreadExecutor pool;
-    auto chunks = nChunks !=0? nChunks: setAutomaticChunking(data.Size());
-    auto resArray = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, n), redFunction, chunks);
-    logl=resArray.logvalue;
-    sumW=resArray.weight;
-    sumW2=resArray.weight2;
-#endif
+  if (executionPolicy == ROOT::Fit::ExecutionPolicy::kSerial ||
+      executionPolicy == ROOT::Fit::ExecutionPolicy::kMultithread) {
+    // same compensated sums over the same chunks for both policies
+    auto resArray = EvaluateSumInChunks<LikelihoodSum>(mapFunction, n, executionPolicy, nChunks);
+    logl = resArray.logvalue;
+    sumW = resArray.weight;
+    sumW2 = resArray.weight2;
 //   } else if(executionPolicy == ROOT::Fit::kMultitProcess){
     // ROOT::TProcessExecutor pool;
     // res = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, n), redFunction);
@@ -1548,13 +1510,7 @@ double FitUtil::EvaluatePoissonLogL(const IModelFunction &func, const BinData &d
       return nloglike;
    };
 
-#ifdef R__USE_IMT
-   auto redFunction = [](const std::vector<double> &objs) {
-      return std::accumulate(objs.begin(), objs.end(), double{});
-   };
-#else
-   (void)nChunks;
-
+#ifndef R__USE_IMT
    // If IMT is disabled, force the execution policy to the serial case
    if (executionPolicy == ROOT::Fit::ExecutionPolicy::kMultithread) {
       Warning("FitUtil::EvaluatePoissonLogL", "Multithread execution policy requires IMT, which is disabled. Changing "
@@ -1564,16 +1520,10 @@ double FitUtil::EvaluatePoissonLogL(const IModelFunction &func, const BinData &d
 #endif
 
    double res{};
-   if (executionPolicy == ROOT::Fit::ExecutionPolicy::kSerial) {
-      for (unsigned int i = 0; i < n; ++i) {
-         res += mapFunction(i);
-      }
-#ifdef R__USE_IMT
-   } else if (executionPolicy == ROOT::Fit::ExecutionPolicy::kMultithread) {
-      ROOT::TThreadExecutor pool;
-      auto chunks = nChunks != 0 ? nChunks : setAutomaticChunking(data.Size());
-      res = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, n), redFunction, chunks);
-#endif
+   if (executionPolicy == ROOT::Fit::ExecutionPolicy::kSerial ||
+       executionPolicy == ROOT::Fit::ExecutionPolicy::kMultithread) {
+      // same compensated sum over the same chunks for both policies
+      res = EvaluateSumInChunks<ROOT::Math::KahanSum<double>>(mapFunction, n, executionPolicy, nChunks);
       //   } else if(executionPolicy == ROOT::Fit::kMultitProcess){
       // ROOT::TProcessExecutor pool;
       // res = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, n), redFunction);
@@ -1782,10 +1732,10 @@ void FitUtil::EvaluatePoissonLogLGradient(const IModelFunction &f, const BinData
 
 
 unsigned FitUtil::setAutomaticChunking(unsigned nEvents){
-      auto ncpu  = ROOT::GetThreadPoolSize();
-      if (nEvents/ncpu < 1000) return ncpu;
-      return nEvents/1000;
-      //return ((nEvents/ncpu + 1) % 1000) *40 ; //arbitrary formula
+      // chunks of 1000 events, not depending on the number of threads, so
+      // that the results of the parallel evaluation are reproducible
+      const unsigned chunkSize = 1000;
+      return std::max(1u, (nEvents + chunkSize - 1) / chunkSize);
 }
 
 }
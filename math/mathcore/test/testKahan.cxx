@@ -1,4 +1,6 @@
 #include "Math/Util.h"
+#include "Fit/FitUtil.h"
+#include "TROOT.h"
 #include <vector>
 #include <random>
 
@@ -184,3 +186,46 @@ TEST(KahanTest, VectorisableVsLegacy)
   EXPECT_FLOAT_EQ(allVecKahan5.Sum(), kahan4AccAll.Sum() + 10.) << "Initial value works.";
 }
 
+
+TEST(KahanTest, AddKahanSum)
+{
+  std::vector<double> numbers(1000);
+  for (std::size_t i = 0; i < numbers.size(); ++i)
+    numbers[i] = (i % 2 ? 1.E-8 : 1.) * (1. + i / 1000.);
+
+  ROOT::Math::KahanSum<double> all;
+  all.Add(numbers);
+
+  // sums of parts keep their compensation when added together
+  ROOT::Math::KahanSum<double> total;
+  for (std::size_t part = 0; part < 10; ++part) {
+    ROOT::Math::KahanSum<double, 4> partSum;
+    partSum.Add(numbers.begin() + 100 * part, numbers.begin() + 100 * (part + 1));
+    total += partSum;
+  }
+  EXPECT_NEAR(total.Sum(), all.Sum(), 1.E-14 * all.Sum());
+}
+
+TEST(KahanTest, FitUtilSumInChunks)
+{
+  const unsigned n = 100000;
+  auto term = [](unsigned i) { return 1.E8 * (i % 3 == 0) + 0.1 * (i % 7); };
+  long double exact = 0.;
+  for (unsigned i = 0; i < n; ++i)
+    exact += term(i);
+
+  using ROOT::Fit::ExecutionPolicy;
+  using ROOT::Fit::FitUtil::EvaluateSumInChunks;
+  const double serial = EvaluateSumInChunks<ROOT::Math::KahanSum<double>>(term, n, ExecutionPolicy::kSerial, 0);
+  EXPECT_NEAR(serial, exact, 1.E-15 * exact);
+
+#ifdef R__USE_IMT
+  // the result must not depend on the execution policy nor the number of threads
+  ROOT::EnableImplicitMT(2);
+  EXPECT_EQ(EvaluateSumInChunks<ROOT::Math::KahanSum<double>>(term, n, ExecutionPolicy::kMultithread, 0), serial);
+  ROOT::DisableImplicitMT();
+  ROOT::EnableImplicitMT(4);
+  EXPECT_EQ(EvaluateSumInChunks<ROOT::Math::KahanSum<double>>(term, n, ExecutionPolicy::kMultithread, 0), serial);
+  ROOT::DisableImplicitMT();
+#endif
+}
@@ -52,6 +52,10 @@ public:
 
    void SetErrorDef(double up) { fUp = up; }
 
+   /// declare that the wrapped function can be evaluated from several threads at the same time
+   void SetReentrant(bool on = true) { fReentrant = on; }
+   bool IsReentrant() const { return fReentrant; }
+
    //virtual std::vector<double> Gradient(const std::vector<double>&) const;
 
    // forward interface
@@ -60,6 +64,7 @@ public:
 private:
    const Function & fFunc;
    double fUp;
+   bool fReentrant = false;
 };
 
    } // end namespace Minuit2
@@ -113,6 +113,14 @@ public:
    */
    virtual void SetErrorDef(double ) {};
 
+   /**
+       Return true if operator() may be called from several threads at the same
+       time. The numerical gradient and the Hessian are then computed in parallel
+       over the parameters, using the ROOT implicit multi-threading pool when it
+       is enabled. Re-implement this function if needed.
+   */
+   virtual bool IsReentrant() const { return false; }
+
 };
 
   }  // namespace Minuit2
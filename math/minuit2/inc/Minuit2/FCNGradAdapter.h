@@ -58,6 +58,10 @@ public:
 
    double Up() const {return fUp;}
 
+   /// declare that the wrapped function can be evaluated from several threads at the same time
+   void SetReentrant(bool on = true) { fReentrant = on; }
+   bool IsReentrant() const { return fReentrant; }
+
    std::vector<double> Gradient(const std::vector<double>& v) const {
       fFunc.Gradient(&v[0], &fGrad[0]);
 
@@ -77,6 +81,7 @@ private:
    const Function & fFunc;
    double fUp;
    mutable std::vector<double> fGrad;
+   bool fReentrant = false;
 };
 
    } // end namespace Minuit2
@@ -13,6 +13,8 @@
 #include "Minuit2/MnConfig.h"
 #include "Minuit2/MnMatrix.h"
 
+#include <atomic>
+
 namespace ROOT {
 
    namespace Minuit2 {
@@ -34,6 +36,7 @@ public:
 
    /// constructor of
    explicit MnFcn(const FCNBase& fcn, int ncall = 0) : fFCN(fcn), fNumCall(ncall) {}
+   MnFcn(const MnFcn& fcn) : fFCN(fcn.fFCN), fNumCall(fcn.NumOfCalls()) {}
 
   virtual ~MnFcn();
 
@@ -54,7 +57,8 @@ private:
 
 protected:
 
-  mutable int fNumCall;
+  // atomic, since the function may be called from several threads (see FCNBase::IsReentrant)
+  mutable std::atomic<int> fNumCall;
 };
 
   }  // namespace Minuit2
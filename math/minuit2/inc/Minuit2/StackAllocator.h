@@ -42,10 +42,33 @@ class StackOverflow {};
 class StackError {};
 //  using namespace std;
 
+/** Cache of the large memory blocks last freed by a thread, used by
+    StackAllocator when _MN_NO_THREAD_SAVE_ is not defined. Minuit allocates
+    vectors and matrices of the same sizes at every iteration: reusing the
+    blocks avoids returning them to the system and getting them back
+    zero-filled each time, which dominates the O(n^2) updates of fits with
+    many parameters. The memory kept by the cache of a thread is limited,
+    and released at the end of each minimization.
+ */
+
+class StackAllocatorBlockCache {
+
+public:
+
+  static void* Allocate(size_t nBytes);
+
+  static void Deallocate(void* p);
+
+  /// free the blocks cached by the calling thread
+  static void Release();
+};
+
+
 /** StackAllocator controls the memory allocation/deallocation of Minuit. If
     _MN_NO_THREAD_SAVE_ is defined, memory is taken from a pre-allocated piece
     of heap memory which is then used like a stack, otherwise via standard
-    malloc/free. Note that defining _MN_NO_THREAD_SAVE_ makes the code thread-
+    malloc/free, with the large blocks cached per thread (see
+    StackAllocatorBlockCache). Note that defining _MN_NO_THREAD_SAVE_ makes the code thread-
     unsave. The gain in performance is mainly for cost-cheap FCN functions.
  */
 
@@ -94,8 +117,7 @@ public:
 #endif
 
 #else
-      void* result = malloc(nBytes);
-      if (!result) throw std::bad_alloc();
+      void* result = StackAllocatorBlockCache::Allocate(nBytes);
 #endif
 
       return result;
@@ -124,7 +146,7 @@ public:
       CheckConsistency();
 #endif
 #else
-      free(p);
+      StackAllocatorBlockCache::Deallocate(p);
 #endif
       // std::cout << "Block at " << delBlock
       //   << " deallocated, fStackOffset = " << fStackOffset << std::endl;
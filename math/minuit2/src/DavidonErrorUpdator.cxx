@@ -26,8 +26,8 @@ namespace ROOT {
 
 
 double inner_product(const LAVector&, const LAVector&);
-double similarity(const LAVector&, const LASymMatrix&);
 double sum_of_elements(const LASymMatrix&);
+int mndspr(const char*, unsigned int, double, const double*, int, double*);
 
 MinimumError DavidonErrorUpdator::Update(const MinimumState& s0,
                                          const MinimumParameters& p1,
@@ -41,8 +41,11 @@ MinimumError DavidonErrorUpdator::Update(const MinimumState& s0,
    MnAlgebraicVector dx = p1.Vec() - s0.Vec();
    MnAlgebraicVector dg = g1.Vec() - s0.Gradient().Vec();
 
+   // v0*dg is needed for gvg and for the update: compute it once
+   MnAlgebraicVector vg = v0*dg;
+
    double delgam = inner_product(dx, dg);
-   double gvg = similarity(dg, v0);
+   double gvg = inner_product(dg, vg);
 
 
 #ifdef DEBUG
@@ -70,13 +73,17 @@ MinimumError DavidonErrorUpdator::Update(const MinimumState& s0,
    }
 
 
-   MnAlgebraicVector vg = v0*dg;
-
-   MnAlgebraicSymMatrix vUpd = Outer_product(dx)/delgam - Outer_product(vg)/gvg;
+   // accumulate the rank one updates in place (DSPR), without temporary
+   // matrices: vUpd = dx*dx^T/delgam - vg*vg^T/gvg
+   const unsigned int n = dx.size();
+   MnAlgebraicSymMatrix vUpd(n);
+   mndspr("U", n, 1./delgam, dx.Data(), 1, vUpd.Data());
+   mndspr("U", n, -1./gvg, vg.Data(), 1, vUpd.Data());
 
    if(delgam > gvg) {
       // use rank 1 formula
-      vUpd += gvg*Outer_product(MnAlgebraicVector(dx/delgam - vg/gvg));
+      MnAlgebraicVector flnu(dx/delgam - vg/gvg);
+      mndspr("U", n, gvg, flnu.Data(), 1, vUpd.Data());
    }
 
    double sum_upd = sum_of_elements(vUpd);
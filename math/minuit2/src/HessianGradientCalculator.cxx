@@ -15,6 +15,7 @@
 #include "Minuit2/MinimumParameters.h"
 #include "Minuit2/FunctionGradient.h"
 #include "Minuit2/MnStrategy.h"
+#include "MnParallel.h"
 
 #include <math.h>
 
@@ -90,8 +91,9 @@ std::pair<FunctionGradient, MnAlgebraicVector> HessianGradientCalculator::DeltaG
    unsigned int startElementIndex = mpiproc.StartElementIndex();
    unsigned int endElementIndex = mpiproc.EndElementIndex();
 
-   for(unsigned int i = startElementIndex; i < endElementIndex; i++) {
-      double xtf = x(i);
+   // compute the derivative along parameter i, using xv (equal to par.Vec()) for the function calls
+   auto derivative = [&](unsigned int i, MnAlgebraicVector& xv) {
+      double xtf = xv(i);
       double dmin = 4.*Precision().Eps2()*(xtf + Precision().Eps2());
       double epspri = Precision().Eps2() + fabs(grd(i)*Precision().Eps2());
       double optstp = sqrt(dfmin/(fabs(g2(i))+epspri));
@@ -103,11 +105,11 @@ std::pair<FunctionGradient, MnAlgebraicVector> HessianGradientCalculator::DeltaG
       double grdold = 0.;
       double grdnew = 0.;
       for(unsigned int j = 0; j < Ncycle(); j++)  {
-         x(i) = xtf + d;
-         double fs1 = Fcn()(x);
-         x(i) = xtf - d;
-         double fs2 = Fcn()(x);
-         x(i) = xtf;
+         xv(i) = xtf + d;
+         double fs1 = Fcn()(xv);
+         xv(i) = xtf - d;
+         double fs2 = Fcn()(xv);
+         xv(i) = xtf;
          //       double sag = 0.5*(fs1+fs2-2.*fcnmin);
          //LM: should I calculate also here second derivatives ???
 
@@ -135,7 +137,19 @@ std::pair<FunctionGradient, MnAlgebraicVector> HessianGradientCalculator::DeltaG
       std::cout << "HGC Param : " << i << "\t new g1 = " << grd(i) << " gstep = " << d << " dgrd = " << dgrd(i) << std::endl;
 #endif
 
-   }
+   };
+
+   // with a reentrant function, the parameters are distributed to the threads of the ROOT
+   // implicit multi-threading pool, each with its own copy of the point
+   const bool parallel = mpiproc.GetMPISize() == 1 && UseParallelFcn(Fcn(), n);
+   ParallelForFcn(parallel, startElementIndex, endElementIndex, [&](unsigned int i) {
+      if (parallel) {
+         MnAlgebraicVector xi = par.Vec();
+         derivative(i, xi);
+      } else {
+         derivative(i, x);
+      }
+   });
 
    mpiproc.SyncVector(grd);
    mpiproc.SyncVector(gstep);
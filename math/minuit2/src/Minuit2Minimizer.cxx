@@ -351,12 +351,24 @@ bool Minuit2Minimizer::GetVariableSettings(unsigned int ivar, ROOT::Fit::Paramet
 
 
 
+// the function can be evaluated concurrently if declared so with the extra Minuit2 option
+// "ReentrantFCN"; the numerical derivatives are then computed in parallel when ROOT implicit
+// multi-threading is enabled (see FCNBase::IsReentrant)
+static bool IsReentrantFCN() {
+   ROOT::Math::IOptions * minuit2Opt = ROOT::Math::MinimizerOptions::FindDefault("Minuit2");
+   int reentrant = 0;
+   if (minuit2Opt) minuit2Opt->GetValue("ReentrantFCN",reentrant);
+   return reentrant != 0;
+}
+
 void Minuit2Minimizer::SetFunction(const  ROOT::Math::IMultiGenFunction & func) {
    // set function to be minimized
    if (fMinuitFCN) delete fMinuitFCN;
    fDim = func.NDim();
    if (!fUseFumili) {
-      fMinuitFCN = new ROOT::Minuit2::FCNAdapter<ROOT::Math::IMultiGenFunction> (func, ErrorDef() );
+      auto fcn = new ROOT::Minuit2::FCNAdapter<ROOT::Math::IMultiGenFunction> (func, ErrorDef() );
+      fcn->SetReentrant(IsReentrantFCN());
+      fMinuitFCN = fcn;
    }
    else {
       // for Fumili the fit method function interface is required
@@ -374,7 +386,9 @@ void Minuit2Minimizer::SetFunction(const  ROOT::Math::IMultiGradFunction & func)
    fDim = func.NDim();
    if (fMinuitFCN) delete fMinuitFCN;
    if (!fUseFumili) {
-      fMinuitFCN = new ROOT::Minuit2::FCNGradAdapter<ROOT::Math::IMultiGradFunction> (func, ErrorDef() );
+      auto fcn = new ROOT::Minuit2::FCNGradAdapter<ROOT::Math::IMultiGradFunction> (func, ErrorDef() );
+      fcn->SetReentrant(IsReentrantFCN());
+      fMinuitFCN = fcn;
    }
    else {
       // for Fumili the fit method function interface is required
@@ -29,6 +29,10 @@
 #endif
 
 #include "Minuit2/MPIProcess.h"
+#include "MnParallel.h"
+
+#include <algorithm>
+#include <atomic>
 
 namespace ROOT {
 
@@ -130,9 +134,31 @@ MinimumState MnHesse::operator()(const MnFcn& mfcn, const MinimumState& st, cons
 #endif
 
 
-   for(unsigned int i = 0; i < n; i++) {
+   // in case of failure, return a diagonal matrix from the second derivatives
+   auto failedState = [&]() {
+      for(unsigned int j = 0; j < n; j++) {
+         double tmp = g2(j) < prec.Eps2() ? 1. : 1./g2(j);
+         vhmat(j,j) = tmp < prec.Eps2() ? 1. : tmp;
+      }
+
+      return MinimumState(st.Parameters(), MinimumError(vhmat, MinimumError::MnHesseFailed()), st.Gradient(), st.Edm(), mfcn.NumOfCalls());
+   };
 
-      double xtf = x(i);
+   auto tooManyCalls = [&]() {
+      if(mfcn.NumOfCalls()  <= maxcalls) return false;
+#ifdef WARNINGMSG
+      //std::cout<<"maxcalls " << maxcalls << " " << mfcn.NumOfCalls() << "  " <<   st.NFcn() << std::endl;
+      MN_INFO_MSG("MnHesse: maximum number of allowed function calls exhausted.");
+      MN_INFO_MSG("MnHesse fails and will return diagonal matrix ");
+#endif
+      return true;
+   };
+
+   // compute the second derivative along parameter i, using xv (equal to x) for the function calls;
+   // return false if it is zero
+   auto diagonal = [&](unsigned int i, MnAlgebraicVector& xv) {
+
+      double xtf = xv(i);
       double dmin = 8.*prec.Eps2()*(fabs(xtf) + prec.Eps2());
       double d = fabs(gst(i));
       if(d < dmin) d = dmin;
@@ -147,11 +173,11 @@ MinimumState MnHesse::operator()(const MnFcn& mfcn, const MinimumState& st, cons
          double fs1 = 0.;
          double fs2 = 0.;
          for(unsigned int multpy = 0; multpy < 5; multpy++) {
-            x(i) = xtf + d;
-            fs1 = mfcn(x);
-            x(i) = xtf - d;
-            fs2 = mfcn(x);
-            x(i) = xtf;
+            xv(i) = xtf + d;
+            fs1 = mfcn(xv);
+            xv(i) = xtf - d;
+            fs2 = mfcn(xv);
+            xv(i) = xtf;
             sag = 0.5*(fs1+fs2-2.*amin);
 
 #ifdef DEBUG
@@ -180,12 +206,7 @@ L26:
          }
 #endif
 
-         for(unsigned int j = 0; j < n; j++) {
-            double tmp = g2(j) < prec.Eps2() ? 1. : 1./g2(j);
-            vhmat(j,j) = tmp < prec.Eps2() ? 1. : tmp;
-         }
-
-         return MinimumState(st.Parameters(), MinimumError(vhmat, MinimumError::MnHesseFailed()), st.Gradient(), st.Edm(), mfcn.NumOfCalls());
+         return false;
 
 L30:
             double g2bfor = g2(i);
@@ -212,22 +233,31 @@ L30:
          d = std::max(d, 0.1*dlast);
       }
       vhmat(i,i) = g2(i);
-      if(mfcn.NumOfCalls()  > maxcalls) {
-
-#ifdef WARNINGMSG
-         //std::cout<<"maxcalls " << maxcalls << " " << mfcn.NumOfCalls() << "  " <<   st.NFcn() << std::endl;
-         MN_INFO_MSG("MnHesse: maximum number of allowed function calls exhausted.");
-         MN_INFO_MSG("MnHesse fails and will return diagonal matrix ");
-#endif
-
-         for(unsigned int j = 0; j < n; j++) {
-            double tmp = g2(j) < prec.Eps2() ? 1. : 1./g2(j);
-            vhmat(j,j) = tmp < prec.Eps2() ? 1. : tmp;
-         }
-
-         return MinimumState(st.Parameters(), MinimumError(vhmat, MinimumError::MnHesseFailed()), st.Gradient(), st.Edm(), mfcn.NumOfCalls());
+      return true;
+   };
+
+   // with a reentrant function, the parameters are distributed to the threads of the ROOT
+   // implicit multi-threading pool, each with its own copy of the point
+   const bool parallel = UseParallelFcn(mfcn, n);
+
+   if (parallel) {
+      // as in the serial loop, stop at the first parameter with a zero second derivative
+      // or once the maximum number of calls is exceeded: the parameters not started yet
+      // are skipped, those in progress are completed
+      std::atomic<bool> failed(false);
+      ParallelForFcn(true, 0, n, [&](unsigned int i) {
+         if (failed) return;
+         MnAlgebraicVector xi = x;
+         if (!diagonal(i, xi) || (!failed && tooManyCalls()))
+            failed = true;
+      });
+      if (failed)
+         return failedState();
+   } else {
+      for(unsigned int i = 0; i < n; i++) {
+         if (!diagonal(i, x) || tooManyCalls())
+            return failedState();
       }
-
    }
 
 #ifdef DEBUG
@@ -247,34 +277,49 @@ L30:
    // initial starting values
    if (n > 0) { 
       MPIProcess mpiprocOffDiagonal(n*(n-1)/2,0);
-      unsigned int startParIndexOffDiagonal = mpiprocOffDiagonal.StartElementIndex();
-      unsigned int endParIndexOffDiagonal = mpiprocOffDiagonal.EndElementIndex();
 
-      unsigned int offsetVect = 0;
-      for (unsigned int in = 0; in<startParIndexOffDiagonal; in++)
-         if ((in+offsetVect)%(n-1)==0) offsetVect += (in+offsetVect)/(n-1);
+      if (parallel && mpiprocOffDiagonal.GetMPISize() == 1) {
+         // one task per row of the upper triangle
+         ParallelForFcn(true, 0, n - 1, [&](unsigned int i) {
+            MnAlgebraicVector xi = x;
+            xi(i) += dirin(i);
+            for (unsigned int j = i + 1; j < n; j++) {
+               xi(j) += dirin(j);
+               double fs1 = mfcn(xi);
+               vhmat(i,j) = (fs1 + amin - yy(i) - yy(j))/(dirin(i)*dirin(j));
+               xi(j) -= dirin(j);
+            }
+         });
+      } else {
+         unsigned int startParIndexOffDiagonal = mpiprocOffDiagonal.StartElementIndex();
+         unsigned int endParIndexOffDiagonal = mpiprocOffDiagonal.EndElementIndex();
 
-      for (unsigned int in = startParIndexOffDiagonal;
-           in<endParIndexOffDiagonal; in++) {
+         unsigned int offsetVect = 0;
+         for (unsigned int in = 0; in<startParIndexOffDiagonal; in++)
+            if ((in+offsetVect)%(n-1)==0) offsetVect += (in+offsetVect)/(n-1);
 
-         int i = (in+offsetVect)/(n-1);
-         if ((in+offsetVect)%(n-1)==0) offsetVect += i;
-         int j = (in+offsetVect)%(n-1)+1;
+         for (unsigned int in = startParIndexOffDiagonal;
+              in<endParIndexOffDiagonal; in++) {
 
-         if ((i+1)==j || in==startParIndexOffDiagonal)
-            x(i) += dirin(i);
+            int i = (in+offsetVect)/(n-1);
+            if ((in+offsetVect)%(n-1)==0) offsetVect += i;
+            int j = (in+offsetVect)%(n-1)+1;
 
-         x(j) += dirin(j);
+            if ((i+1)==j || in==startParIndexOffDiagonal)
+               x(i) += dirin(i);
 
-         double fs1 = mfcn(x);
-         double elem = (fs1 + amin - yy(i) - yy(j))/(dirin(i)*dirin(j));
-         vhmat(i,j) = elem;
+            x(j) += dirin(j);
 
-         x(j) -= dirin(j);
+            double fs1 = mfcn(x);
+            double elem = (fs1 + amin - yy(i) - yy(j))/(dirin(i)*dirin(j));
+            vhmat(i,j) = elem;
 
-         if (j%(n-1)==0 || in==endParIndexOffDiagonal-1)
-            x(i) -= dirin(i);
+            x(j) -= dirin(j);
 
+            if (j%(n-1)==0 || in==endParIndexOffDiagonal-1)
+               x(i) -= dirin(i);
+
+         }
       }
 
       mpiprocOffDiagonal.SyncSymMatrixOffDiagonal(vhmat);
@@ -0,0 +1,65 @@
+// @(#)root/minuit2:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2020 LCG ROOT Math team,  CERN/EP-SFT                *
+ *                                                                    *
+ **********************************************************************/
+
+#ifndef ROOT_Minuit2_MnParallel
+#define ROOT_Minuit2_MnParallel
+
+#include "Minuit2/MnFcn.h"
+#include "Minuit2/FCNBase.h"
+
+#ifdef MINUIT2_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#include "TROOT.h"
+#endif
+
+namespace ROOT {
+
+   namespace Minuit2 {
+
+/**
+   Return true if loops over n parameters calling fcn run in parallel: the
+   function must be reentrant (FCNBase::IsReentrant) and ROOT implicit
+   multi-threading enabled. Never the case for the standalone build or when
+   OpenMP is used.
+ */
+inline bool UseParallelFcn(const MnFcn& fcn, unsigned int n) {
+#if defined(MINUIT2_IMT) && !defined(_OPENMP)
+   return n > 1 && fcn.Fcn().IsReentrant() && ROOT::IsImplicitMTEnabled();
+#else
+   (void)fcn;
+   (void)n;
+   return false;
+#endif
+}
+
+/**
+   Call func(i) for all i in [begin, end), on the ROOT implicit
+   multi-threading pool if parallel is true, otherwise in order.
+   func must only write to the elements of its index i.
+ */
+template <class Func>
+void ParallelForFcn(bool parallel, unsigned int begin, unsigned int end, Func func) {
+#ifdef MINUIT2_IMT
+   if (parallel && end > begin + 1) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(func, ROOT::TSeqU(begin, end));
+      return;
+   }
+#else
+   (void)parallel;
+#endif
+   for (unsigned int i = begin; i < end; ++i)
+      func(i);
+}
+
+   }  // namespace Minuit2
+
+}  // namespace ROOT
+
+#endif  // ROOT_Minuit2_MnParallel
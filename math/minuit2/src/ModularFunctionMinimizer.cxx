@@ -28,6 +28,7 @@
 
 #if defined(DEBUG) || defined(WARNINGMSG)
 #include "Minuit2/MnPrint.h"
+#include "Minuit2/StackAllocator.h"
 #endif
 
 
@@ -163,7 +164,12 @@ FunctionMinimum ModularFunctionMinimizer::Minimize(const MnFcn& mfcn, const Grad
 
 
 
-   return mb.Minimum(mfcn, gc, seed, strategy, maxfcn, effective_toler);
+   FunctionMinimum min = mb.Minimum(mfcn, gc, seed, strategy, maxfcn, effective_toler);
+
+   // the memory blocks cached for the iterations are not needed any more
+   StackAllocatorBlockCache::Release();
+
+   return min;
 }
 
 
@@ -15,6 +15,7 @@
 #include "Minuit2/MinimumParameters.h"
 #include "Minuit2/FunctionGradient.h"
 #include "Minuit2/MnStrategy.h"
+#include "MnParallel.h"
 
 
 //#define DEBUG
@@ -111,38 +112,9 @@ FunctionGradient Numerical2PGradientCalculator::operator()(const MinimumParamete
    std::cout.precision(pr);
 #endif
 
-#ifndef _OPENMP
-   // for serial execution this can be outside the loop
-   MnAlgebraicVector x = par.Vec();
-
-   unsigned int startElementIndex = mpiproc.StartElementIndex();
-   unsigned int endElementIndex = mpiproc.EndElementIndex();
-
-   for(unsigned int i = startElementIndex; i < endElementIndex; i++) {
-
-#else
-
- // parallelize this loop using OpenMP
-//#define N_PARALLEL_PAR 5
-#pragma omp parallel
-#pragma omp for
-//#pragma omp for schedule (static, N_PARALLEL_PAR)
-
-   for(int i = 0; i < int(n); i++) {
-
-#endif
-
-#ifdef DEBUG_MP
-      int ith = omp_get_thread_num();
-      //std::cout << "Thread number " << ith << "  " << i << std::endl;
-#endif
-
-#ifdef _OPENMP
-       // create in loop since each thread will use its own copy
-      MnAlgebraicVector x = par.Vec();
-#endif
-
-      double xtf = x(i);
+   // compute the derivative along parameter i, using xv (equal to par.Vec()) for the function calls
+   auto derivative = [&](unsigned int i, MnAlgebraicVector& xv) {
+      double xtf = xv(i);
       double epspri = eps2 + fabs(grd(i)*eps2);
       double stepb4 = 0.;
       for(unsigned int j = 0; j < ncycle; j++)  {
@@ -155,7 +127,7 @@ FunctionGradient Numerical2PGradientCalculator::operator()(const MinimumParamete
          double stpmax = 10.*fabs(gstep(i));
          if(step > stpmax) step = stpmax;
          //       std::cout<<" "<<step;
-         double stpmin = std::max(vrysml, 8.*fabs(eps2*x(i)));
+         double stpmin = std::max(vrysml, 8.*fabs(eps2*xv(i)));
          if(step < stpmin) step = stpmin;
          //       std::cout<<" "<<step<<std::endl;
          //       std::cout<<"step: "<<step<<std::endl;
@@ -172,21 +144,19 @@ FunctionGradient Numerical2PGradientCalculator::operator()(const MinimumParamete
          //       double fs1 = Fcn()(pstate + pstep);
          //       double fs2 = Fcn()(pstate - pstep);
 
-         x(i) = xtf + step;
-         double fs1 = Fcn()(x);
-         x(i) = xtf - step;
-         double fs2 = Fcn()(x);
-         x(i) = xtf;
+         xv(i) = xtf + step;
+         double fs1 = Fcn()(xv);
+         xv(i) = xtf - step;
+         double fs2 = Fcn()(xv);
+         xv(i) = xtf;
 
          double grdb4 = grd(i);
          grd(i) = 0.5*(fs1 - fs2)/step;
          g2(i) = (fs1 + fs2 - 2.*fcnmin)/step/step;
 
 #ifdef DEBUG
-         pr = std::cout.precision(13);
-         std::cout << "cycle " << j << " x " << x(i) << " step " << step << " f1 " << fs1 << " f2 " << fs2
+         std::cout << "cycle " << j << " x " << xv(i) << " step " << step << " f1 " << fs1 << " f2 " << fs2
                    << " grd " << grd(i) << " g2 " << g2(i) << std::endl;
-         std::cout.precision(pr);
 #endif
 
          if(fabs(grdb4-grd(i))/(fabs(grd(i))+dfmin/step) < GradTolerance())  {
@@ -198,27 +168,66 @@ FunctionGradient Numerical2PGradientCalculator::operator()(const MinimumParamete
          }
       }
 
-
-#ifdef DEBUG_MP
-#pragma omp critical
-      {
-         std::cout << "Gradient for thread " << ith << "  " << i << "  " << std::setprecision(15)  << grd(i) << "  " << g2(i) << std::endl;
-      }
-#endif
-
       //     vgrd(i) = grd;
       //     vgrd2(i) = g2;
       //     vgstp(i) = gstep;
 
-
 #ifdef DEBUG
-      pr = std::cout.precision(13);
       int iext = Trafo().ExtOfInt(i);
       std::cout << "Parameter " << Trafo().Name(iext) << " Gradient =   " << grd(i) << " g2 = " << g2(i) << " step " << gstep(i) << std::endl;
-      std::cout.precision(pr);
+#endif
+   };
+
+#ifndef _OPENMP
+
+   // with a reentrant function, the parameters are distributed to the threads of the ROOT
+   // implicit multi-threading pool, each with its own copy of the point
+   const bool parallel = mpiproc.GetMPISize() == 1 && UseParallelFcn(Fcn(), n);
+
+   // for serial execution this can be outside the loop
+   MnAlgebraicVector x = par.Vec();
+
+   unsigned int startElementIndex = mpiproc.StartElementIndex();
+   unsigned int endElementIndex = mpiproc.EndElementIndex();
+
+   ParallelForFcn(parallel, startElementIndex, endElementIndex, [&](unsigned int i) {
+      if (parallel) {
+         MnAlgebraicVector xi = par.Vec();
+         derivative(i, xi);
+      } else {
+         derivative(i, x);
+      }
+   });
+
+#else
+
+ // parallelize this loop using OpenMP
+//#define N_PARALLEL_PAR 5
+#pragma omp parallel
+#pragma omp for
+//#pragma omp for schedule (static, N_PARALLEL_PAR)
+
+   for(int i = 0; i < int(n); i++) {
+
+#ifdef DEBUG_MP
+      int ith = omp_get_thread_num();
+      //std::cout << "Thread number " << ith << "  " << i << std::endl;
+#endif
+
+       // create in loop since each thread will use its own copy
+      MnAlgebraicVector x = par.Vec();
+      derivative(i, x);
+
+#ifdef DEBUG_MP
+#pragma omp critical
+      {
+         std::cout << "Gradient for thread " << ith << "  " << i << "  " << std::setprecision(15)  << grd(i) << "  " << g2(i) << std::endl;
+      }
 #endif
    }
 
+#endif
+
 #ifndef _OPENMP
    mpiproc.SyncVector(grd);
    mpiproc.SyncVector(g2);
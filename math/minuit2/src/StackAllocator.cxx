@@ -0,0 +1,116 @@
+// @(#)root/minuit2:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2020 LCG ROOT Math team,  CERN/EP-SFT                *
+ *                                                                    *
+ **********************************************************************/
+
+#include "Minuit2/StackAllocator.h"
+
+namespace ROOT {
+
+   namespace Minuit2 {
+
+namespace {
+
+// blocks smaller than kMinSize are not cached, and a thread keeps at most
+// kNBlocks blocks with a total size of kMaxBytes
+enum {kNBlocks = 8, kMinSize = 4096, kMaxBytes = 8 * 1024 * 1024, kHeader = 16};
+
+// trivially destructible, so that blocks freed after the end of the
+// thread (e.g. by static objects) can still go to free()
+struct BlockCache {
+   size_t* fBlocks[kNBlocks];
+   size_t fBytes;
+   int fNext;
+   bool fDead;
+};
+
+void FreeBlocks(BlockCache& cache) {
+   for (int i = 0; i < kNBlocks; ++i) {
+      free(cache.fBlocks[i]);
+      cache.fBlocks[i] = 0;
+   }
+   cache.fBytes = 0;
+}
+
+struct BlockCacheCleaner {
+   ~BlockCacheCleaner();
+};
+
+BlockCache& GetBlockCache() {
+   static thread_local BlockCache cache = {{0}, 0, 0, false};
+   static thread_local BlockCacheCleaner cleaner;
+   (void)cleaner;
+   return cache;
+}
+
+BlockCacheCleaner::~BlockCacheCleaner() {
+   BlockCache& cache = GetBlockCache();
+   FreeBlocks(cache);
+   cache.fDead = true;
+}
+
+}  // namespace
+
+
+void* StackAllocatorBlockCache::Allocate(size_t nBytes) {
+   BlockCache& cache = GetBlockCache();
+   size_t* block = 0;
+   if (nBytes >= kMinSize && !cache.fDead) {
+      for (int i = 0; i < kNBlocks; ++i) {
+         if (cache.fBlocks[i] && cache.fBlocks[i][0] == nBytes) {
+            block = cache.fBlocks[i];
+            cache.fBlocks[i] = 0;
+            cache.fBytes -= nBytes;
+            break;
+         }
+      }
+   }
+   if (!block) {
+      // the header keeps the size, and the alignment of malloc
+      block = static_cast<size_t*>(malloc(nBytes + kHeader));
+      if (!block) throw std::bad_alloc();
+      block[0] = nBytes;
+   }
+   return reinterpret_cast<unsigned char*>(block) + kHeader;
+}
+
+void StackAllocatorBlockCache::Deallocate(void* p) {
+   if (!p) return;
+   size_t* block = reinterpret_cast<size_t*>(static_cast<unsigned char*>(p) - kHeader);
+   BlockCache& cache = GetBlockCache();
+   if (block[0] < kMinSize || block[0] > kMaxBytes || cache.fDead) {
+      free(block);
+      return;
+   }
+   int slot = cache.fNext;
+   for (int i = 0; i < kNBlocks; ++i) {
+      if (!cache.fBlocks[i]) {
+         slot = i;
+         break;
+      }
+   }
+   // make room, starting with the replaced slot, until the block fits in the limit
+   for (int i = 0; i < kNBlocks; ++i) {
+      size_t*& old = cache.fBlocks[(slot + i) % kNBlocks];
+      if (i > 0 && cache.fBytes + block[0] <= kMaxBytes) break;
+      if (old) {
+         cache.fBytes -= old[0];
+         free(old);
+         old = 0;
+      }
+   }
+   cache.fBlocks[slot] = block;
+   cache.fBytes += block[0];
+   cache.fNext = (slot + 1) % kNBlocks;
+}
+
+void StackAllocatorBlockCache::Release() {
+   FreeBlocks(GetBlockCache());
+}
+
+   }  // namespace Minuit2
+
+}  // namespace ROOT
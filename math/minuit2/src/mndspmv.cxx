@@ -221,18 +221,30 @@ int Mndspmv(const char* uplo, unsigned int n, double alpha,
       /*        Form  y  when AP contains the Upper triangle. */
 
       if (incx == 1 && incy == 1) {
+         // the case used by LAVector: the dot product of column j with x
+         // uses four partial sums, so that the loop can be vectorized
          i__1 = n;
          for (j = 1; j <= i__1; ++j) {
+            const double* col = &ap[kk] - 1;
             temp1 = alpha * x[j];
-            temp2 = 0.;
-            k = kk;
+            double s0 = 0., s1 = 0., s2 = 0., s3 = 0.;
             i__2 = j - 1;
-            for (i__ = 1; i__ <= i__2; ++i__) {
-               y[i__] += temp1 * ap[k];
-               temp2 += ap[k] * x[i__];
-               ++k;
+            for (i__ = 1; i__ + 3 <= i__2; i__ += 4) {
+               y[i__] += temp1 * col[i__];
+               y[i__ + 1] += temp1 * col[i__ + 1];
+               y[i__ + 2] += temp1 * col[i__ + 2];
+               y[i__ + 3] += temp1 * col[i__ + 3];
+               s0 += col[i__] * x[i__];
+               s1 += col[i__ + 1] * x[i__ + 1];
+               s2 += col[i__ + 2] * x[i__ + 2];
+               s3 += col[i__ + 3] * x[i__ + 3];
+            }
+            for (; i__ <= i__2; ++i__) {
+               y[i__] += temp1 * col[i__];
+               s0 += col[i__] * x[i__];
                /* L50: */
             }
+            temp2 = (s0 + s1) + (s2 + s3);
             y[j] = y[j] + temp1 * ap[kk + j - 1] + alpha * temp2;
             kk += j;
             /* L60: */
@@ -17,6 +17,16 @@
 #include "Minuit2/MnPlot.h"
 #include "Minuit2/MinosError.h"
 #include "Minuit2/FCNBase.h"
+#include "Minuit2/MnHesse.h"
+#include "Minuit2/MnFcn.h"
+#include "Minuit2/MnStrategy.h"
+#include "Minuit2/Numerical2PGradientCalculator.h"
+#include "Minuit2/FunctionGradient.h"
+#include "Minuit2/MnUserCovariance.h"
+// MINUIT2_IMT is only defined when building within ROOT with imt
+#ifdef MINUIT2_IMT
+#include "TROOT.h"
+#endif
 #include <cmath>
 #include <iostream>
 
@@ -24,6 +34,8 @@
 // to speed up the result
 // define the environment variable OMP_NUM_THREADS to the number of desired threads
 // By default it will have thenumber of core of the machine
+// Without OpenMP, the gradient and the Hessian are computed on the ROOT implicit
+// multi-threading pool, since the FCN is declared reentrant
 // The default number of dimension is 20 (fit in 40 parameters) on 1000 data events.
 // One can change the dimension and the number of events by doing:
 // ./test_Minuit2_Parallel    ndim  nevents
@@ -67,9 +79,66 @@ struct LogLikeFCN  : public FCNBase {
       return logl;
    }
    double Up() const { return 0.5; }
+   bool IsReentrant() const { return true; }
    const Data & fData;
 };
 
+#ifdef MINUIT2_IMT
+// compute the numerical gradient and the Hessian at the minimum with and without
+// implicit multi-threading: both must be identical, since each parameter is
+// computed by the same operations in either case
+int CheckParallelDerivatives(const FCNBase & fcn, const FunctionMinimum & min) {
+
+   const MnUserTransformation & trafo = min.UserState().Trafo();
+   MnStrategy strategy(1);
+
+   ROOT::DisableImplicitMT();
+   MnFcn mfcnSeq(fcn);
+   FunctionGradient gradSeq = Numerical2PGradientCalculator(mfcnSeq, trafo, strategy)(min.Parameters());
+   MnUserParameterState hesseSeq = MnHesse(strategy)(fcn, min.UserState());
+
+   ROOT::EnableImplicitMT();
+   MnFcn mfcnPar(fcn);
+   FunctionGradient gradPar = Numerical2PGradientCalculator(mfcnPar, trafo, strategy)(min.Parameters());
+   MnUserParameterState hessePar = MnHesse(strategy)(fcn, min.UserState());
+
+   int nfail = 0;
+   const unsigned int n = gradSeq.Vec().size();
+   for (unsigned int i = 0; i < n; ++i) {
+      if (gradSeq.Vec()(i) != gradPar.Vec()(i) || gradSeq.G2()(i) != gradPar.G2()(i) ||
+          gradSeq.Gstep()(i) != gradPar.Gstep()(i)) {
+         std::cout << "Error: different gradient for parameter " << i << " with implicit multi-threading: "
+                   << gradSeq.Vec()(i) << " " << gradPar.Vec()(i) << std::endl;
+         ++nfail;
+      }
+   }
+   if (mfcnSeq.NumOfCalls() != mfcnPar.NumOfCalls()) {
+      std::cout << "Error: different number of function calls for the gradient with implicit multi-threading: "
+                << mfcnSeq.NumOfCalls() << " " << mfcnPar.NumOfCalls() << std::endl;
+      ++nfail;
+   }
+
+   const MnUserCovariance & covSeq = hesseSeq.Covariance();
+   const MnUserCovariance & covPar = hessePar.Covariance();
+   if (hesseSeq.HasCovariance() != hessePar.HasCovariance() || covSeq.Nrow() != covPar.Nrow()) {
+      std::cout << "Error: different Hesse result with implicit multi-threading" << std::endl;
+      return nfail + 1;
+   }
+   for (unsigned int i = 0; i < covSeq.Nrow(); ++i) {
+      for (unsigned int j = 0; j <= i; ++j) {
+         if (covSeq(i,j) != covPar(i,j)) {
+            std::cout << "Error: different covariance element (" << i << "," << j
+                      << ") with implicit multi-threading: " << covSeq(i,j) << " " << covPar(i,j) << std::endl;
+            ++nfail;
+         }
+      }
+   }
+   if (nfail == 0)
+      std::cout << "gradient and Hessian are identical with and without implicit multi-threading" << std::endl;
+   return nfail;
+}
+#endif
+
 int doFit(int ndim, int ndata) {
 
   // generate the data (1000 data points) in 100 dimension
@@ -113,9 +182,18 @@ int doFit(int ndim, int ndata) {
   // Minimize
   FunctionMinimum min = fMinimizer.Minimize(fcn, init_par, init_err);
 
+  // compute the full Hessian at the minimum
+  MnHesse hesse;
+  hesse(fcn, min);
+
   // output
   std::cout<<"minimum: "<<min<<std::endl;
 
+#ifdef MINUIT2_IMT
+  if (CheckParallelDerivatives(fcn, min) != 0)
+     return 1;
+#endif
+
 
 //     // create MINOS Error factory
 //     MnMinos Minos(fFCN, min);
@@ -153,6 +231,9 @@ int main(int argc, char **argv) {
    if (argc > 2) {
       ndata = atoi(argv[2] );
    }
+#ifdef MINUIT2_IMT
+   ROOT::EnableImplicitMT();
+#endif
    std::cout << "do fit of " << ndim << " dimensional data on " << ndata << " events " << std::endl;
-   doFit(ndim,ndata);
+   return doFit(ndim,ndata);
 }
@@ -0,0 +1,144 @@
+// @(#)root/minuit2:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2020 LCG ROOT Math team,  CERN/EP-SFT                *
+ *                                                                    *
+ **********************************************************************/
+
+// test of the packed symmetric matrix kernels used by the variable metric
+// update (Mndspmv, mndspr) against plain reference implementations, for
+// dimensions covering all remainders of the unrolled loops, and of the
+// block cache of the StackAllocator
+
+#include "Minuit2/MnMatrix.h"
+#include "Minuit2/LaProd.h"
+#include "Minuit2/StackAllocator.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace ROOT {
+   namespace Minuit2 {
+      int Mndspmv(const char*, unsigned int, double, const double*, const double*, int, double, double*, int);
+      int mndspr(const char*, unsigned int, double, const double*, int, double*);
+   }
+}
+
+using namespace ROOT::Minuit2;
+
+// element (i,j), i <= j, of the upper triangle in packed storage
+inline unsigned int Packed(unsigned int i, unsigned int j) { return i + j*(j+1)/2; }
+
+bool IsClose(double a, double b) {
+   return std::fabs(a - b) <= 1.E-13 * std::max(1., std::max(std::fabs(a), std::fabs(b)));
+}
+
+double Random() { return 2.*std::rand()/RAND_MAX - 1.; }
+
+int TestDspmv(unsigned int n) {
+   std::vector<double> ap(n*(n+1)/2), x(n), y(n), yref(n);
+   for (auto & a : ap) a = Random();
+   for (auto & a : x) a = Random();
+   for (unsigned int i = 0; i < n; ++i) y[i] = yref[i] = Random();
+
+   const double alpha = 0.7, beta = -1.3;
+   for (unsigned int i = 0; i < n; ++i) {
+      double sum = 0;
+      for (unsigned int j = 0; j < n; ++j)
+         sum += ap[i <= j ? Packed(i,j) : Packed(j,i)] * x[j];
+      yref[i] = alpha * sum + beta * yref[i];
+   }
+   Mndspmv("U", n, alpha, ap.data(), x.data(), 1, beta, y.data(), 1);
+
+   int nfail = 0;
+   for (unsigned int i = 0; i < n; ++i) {
+      if (!IsClose(y[i], yref[i])) {
+         std::cout << "Error: Mndspmv n = " << n << " element " << i << " : " << y[i] << " expected " << yref[i] << std::endl;
+         ++nfail;
+      }
+   }
+   return nfail;
+}
+
+int TestDspr(unsigned int n) {
+   std::vector<double> ap(n*(n+1)/2), apref, x(n);
+   for (auto & a : ap) a = Random();
+   for (auto & a : x) a = Random();
+   apref = ap;
+
+   const double alpha = -0.4;
+   for (unsigned int j = 0; j < n; ++j)
+      for (unsigned int i = 0; i <= j; ++i)
+         apref[Packed(i,j)] += alpha * x[i] * x[j];
+   mndspr("U", n, alpha, x.data(), 1, ap.data());
+
+   int nfail = 0;
+   for (unsigned int k = 0; k < ap.size(); ++k) {
+      if (!IsClose(ap[k], apref[k])) {
+         std::cout << "Error: mndspr n = " << n << " element " << k << " : " << ap[k] << " expected " << apref[k] << std::endl;
+         ++nfail;
+      }
+   }
+   return nfail;
+}
+
+// the matrix-vector product of the algebra classes goes through Mndspmv
+int TestSymMatrixVector(unsigned int n) {
+   MnAlgebraicSymMatrix m(n);
+   MnAlgebraicVector v(n);
+   for (unsigned int i = 0; i < n; ++i) {
+      v(i) = Random();
+      for (unsigned int j = 0; j <= i; ++j)
+         m(i,j) = Random();
+   }
+   MnAlgebraicVector mv = m*v;
+
+   int nfail = 0;
+   for (unsigned int i = 0; i < n; ++i) {
+      double ref = 0;
+      for (unsigned int j = 0; j < n; ++j)
+         ref += m(i,j) * v(j);
+      if (!IsClose(mv(i), ref)) {
+         std::cout << "Error: matrix * vector n = " << n << " element " << i << " : " << mv(i) << " expected " << ref << std::endl;
+         ++nfail;
+      }
+   }
+   return nfail;
+}
+
+int TestBlockCache() {
+   const size_t nBytes = 100000;
+   void* p = StackAllocatorBlockCache::Allocate(nBytes);
+   StackAllocatorBlockCache::Deallocate(p);
+   // the block of the same size is reused
+   void* q = StackAllocatorBlockCache::Allocate(nBytes);
+   int nfail = 0;
+   if (q != p) {
+      std::cout << "Error: freed block was not reused" << std::endl;
+      ++nfail;
+   }
+   StackAllocatorBlockCache::Deallocate(q);
+   StackAllocatorBlockCache::Release();
+   // blocks over the limit of the cache are not kept
+   void* big = StackAllocatorBlockCache::Allocate(64 * 1024 * 1024);
+   StackAllocatorBlockCache::Deallocate(big);
+   StackAllocatorBlockCache::Release();
+   return nfail;
+}
+
+int main() {
+   std::srand(111);
+   int nfail = 0;
+   for (unsigned int n = 1; n <= 21; ++n) {
+      nfail += TestDspmv(n);
+      nfail += TestDspr(n);
+      nfail += TestSymMatrixVector(n);
+   }
+   nfail += TestBlockCache();
+   if (nfail == 0)
+      std::cout << "testLAKernels: all tests passed" << std::endl;
+   return nfail != 0;
+}
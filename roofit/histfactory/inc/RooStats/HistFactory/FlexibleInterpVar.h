@@ -43,7 +43,7 @@ namespace HistFactory{
 
     void setInterpCode(RooAbsReal& param, int code);
     void setAllInterpCodes(int code);
-    void setGlobalBoundary(double boundary) {_interpBoundary = boundary;}
+    void setGlobalBoundary(double boundary) {_interpBoundary = boundary; _logInit = kFALSE; _paramTermX.clear(); setValueDirty();}
     void setNominal(Double_t newNominal);
     void setLow(RooAbsReal& param, Double_t newLow);
     void setHigh(RooAbsReal& param, Double_t newHigh);
@@ -59,6 +59,7 @@ namespace HistFactory{
   private:
 
     double PolyInterpValue(int i, double x) const;
+    double paramTerm(int i, double x) const;
 
   protected:
 
@@ -73,6 +74,8 @@ namespace HistFactory{
 
     mutable Bool_t         _logInit ;            //! flag used for chaching polynomial coefficients
     mutable std::vector< double>  _polCoeff;     //! cached polynomial coefficients
+    mutable std::vector<double>   _paramTermX;   //! parameter values of the cached terms
+    mutable std::vector<double>   _paramTerm;    //! cached contribution of each parameter
 
     Double_t evaluate() const;
 
@@ -91,6 +91,7 @@ protected:
   std::vector<int> _interpCode;
 
   Double_t evaluate() const;
+  RooSpan<double> evaluateBatch(std::size_t begin, std::size_t batchSize) const;
 
   ClassDef(PiecewiseInterpolation,3) // Sum of RooAbsReal objects
 };
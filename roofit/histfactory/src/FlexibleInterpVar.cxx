@@ -19,6 +19,7 @@
 
 #include "Riostream.h"
 #include <math.h>
+#include <limits>
 #include "TMath.h"
 
 #include "RooAbsReal.h"
@@ -223,6 +224,7 @@ void FlexibleInterpVar::setInterpCode(RooAbsReal& param, int code){
   }
   // GHL: Adding suggestion by Swagato:
   _logInit = kFALSE ;
+  _paramTermX.clear();
   setValueDirty();
 }
 
@@ -234,6 +236,7 @@ void FlexibleInterpVar::setAllInterpCodes(int code){
   }
   // GHL: Adding suggestion by Swagato:
   _logInit = kFALSE ;
+  _paramTermX.clear();
   setValueDirty();
 
 }
@@ -245,6 +248,7 @@ void FlexibleInterpVar::setNominal(Double_t newNominal){
   _nominal = newNominal;
 
   _logInit = kFALSE ;
+  _paramTermX.clear();
 
   setValueDirty();
 }
@@ -263,6 +267,7 @@ void FlexibleInterpVar::setLow(RooAbsReal& param, Double_t newLow){
   }
 
   _logInit = kFALSE ;
+  _paramTermX.clear();
 
   setValueDirty();
 }
@@ -281,6 +286,7 @@ void FlexibleInterpVar::setHigh(RooAbsReal& param, Double_t newHigh){
   }
 
   _logInit = kFALSE ;
+  _paramTermX.clear();
   setValueDirty();
 }
 
@@ -376,99 +382,99 @@ double FlexibleInterpVar::PolyInterpValue(int i, double x) const {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Calculate and return value of polynomial
+/// Return the contribution of the i-th parameter at value x: a term added
+/// to the total for the additive interpolation codes (0, 2 and 3), a factor
+/// multiplying it for the multiplicative ones (1 and 4).
 
-Double_t FlexibleInterpVar::evaluate() const 
+double FlexibleInterpVar::paramTerm(int i, double x) const
 {
-  Double_t total(_nominal) ;
-  _paramIter->Reset() ;
-
-  RooAbsReal* param ;
-  //const RooArgSet* nset = _paramList.nset() ;
-  int i=0;
-
-  // TString name = GetName();
-  // if (name == TString("ZHWW_ll12_vzll_epsilon") )
-  //    //    std::cout << "evaluate flexible interp var - init flag is " << _logInit << std::endl;
-
-  while((param=(RooAbsReal*)_paramIter->Next())) {
-    //    param->Print("v");
-
+  switch(_interpCode[i]) {
+
+  case 0: {
+    // piece-wise linear
+    if(x>0)
+      return x*(_high[i] - _nominal );
+    else
+      return x*(_nominal - _low[i]);
+  }
+  case 1: {
+    // pice-wise log
+    if(x>=0)
+      return pow(_high[i]/_nominal, +x);
+    else
+      return pow(_low[i]/_nominal,  -x);
+  }
+  case 2:
+  case 3: {
+    // parabolic with linear, and parabolic version of log-normal
+    double a = 0.5*(_high[i]+_low[i])-_nominal;
+    double b = 0.5*(_high[i]-_low[i]);
+    double c = 0;
+    if(x>1 ){
+      return (2*a+b)*(x-1)+_high[i]-_nominal;
+    } else if(x<-1 ) {
+      return -1*(2*a-b)*(x+1)+_low[i]-_nominal;
+    } else {
+      return a*pow(x,2) + b*x+c;
+    }
+  }
+  case 4: {
+    double boundary = _interpBoundary;
+    if(x >= boundary)
+      return std::pow(_high[i]/_nominal, +x);
+    else if (x <= -boundary)
+      return std::pow(_low[i]/_nominal, -x);
+    else if (x != 0)
+      return PolyInterpValue(i, x);
+    return 1.;
+  }
+  default:
+    return 0.;
+  }
+}
 
-    Int_t icode = _interpCode[i] ;
+////////////////////////////////////////////////////////////////////////////////
+/// Calculate and return the interpolated value.
+///
+/// The contribution of each parameter (see paramTerm()) is cached together
+/// with the parameter value it was computed for, and only recomputed for
+/// the parameters whose value changed since the last evaluation. During the
+/// computation of numerical derivatives, this is a single parameter. The
+/// cache is reset by the setters of the interpolation configuration.
 
-    switch(icode) {
+Double_t FlexibleInterpVar::evaluate() const 
+{
+  const unsigned int n = _paramList.size();
+  if (_paramTermX.size() != n) {
+    // NaN never compares equal, so all terms are computed
+    _paramTermX.assign(n, std::numeric_limits<double>::quiet_NaN());
+    _paramTerm.assign(n, 0.);
+  }
 
-    case 0: {
-      // piece-wise linear
-      if(param->getVal()>0)
-	total +=  param->getVal()*(_high[i] - _nominal );
-      else
-	total += param->getVal()*(_nominal - _low[i]);
-      break ;
-    }
-    case 1: {
-      // pice-wise log
-      if(param->getVal()>=0)
-	total *= pow(_high[i]/_nominal, +param->getVal());
-      else
-	total *= pow(_low[i]/_nominal,  -param->getVal());
-      break ;
-    }
-    case 2: {
-      // parabolic with linear
-      double a = 0.5*(_high[i]+_low[i])-_nominal;
-      double b = 0.5*(_high[i]-_low[i]);
-      double c = 0;
-      if(param->getVal()>1 ){
-	total += (2*a+b)*(param->getVal()-1)+_high[i]-_nominal;
-      } else if(param->getVal()<-1 ) {
-	total += -1*(2*a-b)*(param->getVal()+1)+_low[i]-_nominal;
-      } else {
-	total +=  a*pow(param->getVal(),2) + b*param->getVal()+c;
-      }
-      break ;
-    }
-    case 3: {
-      //parabolic version of log-normal
-      double a = 0.5*(_high[i]+_low[i])-_nominal;
-      double b = 0.5*(_high[i]-_low[i]);
-      double c = 0;
-      if(param->getVal()>1 ){
-	total += (2*a+b)*(param->getVal()-1)+_high[i]-_nominal;
-      } else if(param->getVal()<-1 ) {
-	total += -1*(2*a-b)*(param->getVal()+1)+_low[i]-_nominal;
-      } else {
-	total +=  a*pow(param->getVal(),2) + b*param->getVal()+c;
-      }
-      break ;
+  Double_t total(_nominal) ;
+  for (unsigned int i = 0; i < n; ++i) {
+    auto param = static_cast<const RooAbsReal*>(_paramList.at(i));
+    const double x = param->getVal();
+    if (x != _paramTermX[i]) {
+      _paramTerm[i] = paramTerm(i, x);
+      _paramTermX[i] = x;
     }
 
-    case 4: {
-      double boundary = _interpBoundary;
-      double x = param->getVal(); 
-      //std::cout << icode << " param " << param->GetName() << "  " << param->getVal() << " boundary " << boundary << std::endl;
-
-      if(x >= boundary)
-      {
-         total *= std::pow(_high[i]/_nominal, +param->getVal());
-      }
-      else if (x <= -boundary)
-      {
-         total *= std::pow(_low[i]/_nominal, -param->getVal());
-      }
-      else if (x != 0)
-      {
-         total *= PolyInterpValue(i, x);
-      }
+    switch(_interpCode[i]) {
+    case 0:
+    case 2:
+    case 3:
+      total += _paramTerm[i];
+      break ;
+    case 1:
+    case 4:
+      total *= _paramTerm[i];
       break ;
-    }
     default: {
       coutE(InputArguments) << "FlexibleInterpVar::evaluate ERROR:  " << param->GetName() 
 			    << " with unknown interpolation code" << endl ;
     }
     }
-    ++i;
   }
 
   if(total<=0) {
@@ -24,9 +24,12 @@
 #include "RooMsgService.h"
 #include "RooNumIntConfig.h"
 #include "RooTrace.h"
+#include "BatchHelpers.h"
 
 #include <exception>
+#include <limits>
 #include <math.h>
+#include <vector>
 
 using namespace std;
 
@@ -297,6 +300,174 @@ Double_t PiecewiseInterpolation::evaluate() const
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Interpolate all bins (events) of a batch in one pass. The interpolation
+/// parameters do not depend on the observables, so the code path of each
+/// parameter, and the terms that only depend on its value, are evaluated
+/// once per batch instead of once per bin. The bins are then updated in
+/// loops that the compiler can vectorise. The operations done on each bin
+/// are the same as in evaluate(), in the same order.
+
+RooSpan<double> PiecewiseInterpolation::evaluateBatch(std::size_t begin, std::size_t batchSize) const
+{
+  const unsigned int nParams = _paramSet.size();
+
+  std::vector<RooSpan<const double>> batches;
+  batches.reserve(2 * nParams + 1);
+  batches.push_back(_nominal.getValBatch(begin, batchSize));
+  for (unsigned int i=0; i < nParams; ++i) {
+    auto param = static_cast<RooAbsReal*>(_paramSet.at(i));
+    if (!param->getValBatch(begin, batchSize).empty()) {
+      // Parameters varying from bin to bin are not foreseen, compute bin by bin
+      return RooAbsReal::evaluateBatch(begin, batchSize);
+    }
+    batches.push_back(static_cast<RooAbsReal*>(_lowSet.at(i))->getValBatch(begin, batchSize));
+    batches.push_back(static_cast<RooAbsReal*>(_highSet.at(i))->getValBatch(begin, batchSize));
+  }
+
+  const std::size_t n = BatchHelpers::findSize(batches);
+  if (n == std::numeric_limits<std::size_t>::max()) {
+    return {};
+  }
+
+  auto output = _batchData.makeWritableBatchUnInit(begin, n);
+  const BatchHelpers::BracketAdapterWithMask nominal(_nominal, batches[0]);
+  for (std::size_t j = 0; j < n; ++j) { //CHECK_VECTORISE
+    output[j] = nominal[j];
+  }
+
+  for (unsigned int i=0; i < nParams; ++i) {
+    auto param = static_cast<RooAbsReal*>(_paramSet.at(i));
+    auto lowArg  = static_cast<RooAbsReal*>(_lowSet.at(i));
+    auto highArg = static_cast<RooAbsReal*>(_highSet.at(i));
+    const BatchHelpers::BracketAdapterWithMask low(lowArg->getVal(), batches[2*i + 1]);
+    const BatchHelpers::BracketAdapterWithMask high(highArg->getVal(), batches[2*i + 2]);
+    const double x = param->getVal();
+    Int_t icode = _interpCode[i] ;
+
+    switch(icode) {
+    case 0: {
+      // piece-wise linear
+      if (x>0) {
+        for (std::size_t j = 0; j < n; ++j) { //CHECK_VECTORISE
+          output[j] += x*(high[j] - nominal[j]);
+        }
+      } else {
+        for (std::size_t j = 0; j < n; ++j) { //CHECK_VECTORISE
+          output[j] += x*(nominal[j] - low[j]);
+        }
+      }
+      break ;
+    }
+    case 1: {
+      // pice-wise log
+      if (x>=0) {
+        for (std::size_t j = 0; j < n; ++j) {
+          output[j] *= pow(high[j]/nominal[j], +x);
+        }
+      } else {
+        for (std::size_t j = 0; j < n; ++j) {
+          output[j] *= pow(low[j]/nominal[j], -x);
+        }
+      }
+      break ;
+    }
+    case 2:
+    case 3: {
+      // parabolic with linear, and parabolic version of log-normal
+      if (x>1) {
+        for (std::size_t j = 0; j < n; ++j) { //CHECK_VECTORISE
+          const double a = 0.5*(high[j]+low[j])-nominal[j];
+          const double b = 0.5*(high[j]-low[j]);
+          output[j] += (2*a+b)*(x-1)+high[j]-nominal[j];
+        }
+      } else if (x<-1) {
+        for (std::size_t j = 0; j < n; ++j) { //CHECK_VECTORISE
+          const double a = 0.5*(high[j]+low[j])-nominal[j];
+          const double b = 0.5*(high[j]-low[j]);
+          output[j] += -1*(2*a-b)*(x+1)+low[j]-nominal[j];
+        }
+      } else {
+        const double x2 = pow(x,2);
+        for (std::size_t j = 0; j < n; ++j) { //CHECK_VECTORISE
+          const double a = 0.5*(high[j]+low[j])-nominal[j];
+          const double b = 0.5*(high[j]-low[j]);
+          output[j] += a*x2 + b*x + 0.;
+        }
+      }
+      break ;
+    }
+    case 4: {
+      if (x>1) {
+        for (std::size_t j = 0; j < n; ++j) { //CHECK_VECTORISE
+          output[j] += x*(high[j] - nominal[j]);
+        }
+      } else if (x<-1) {
+        for (std::size_t j = 0; j < n; ++j) { //CHECK_VECTORISE
+          output[j] += x*(nominal[j] - low[j]);
+        }
+      } else {
+        // Even part of the polynomial, common to all bins
+        const double poly = 15 + x * x * (-10 + x * x * 3);
+        for (std::size_t j = 0; j < n; ++j) { //CHECK_VECTORISE
+          const double eps_plus = high[j] - nominal[j];
+          const double eps_minus = nominal[j] - low[j];
+          const double S = 0.5 * (eps_plus + eps_minus);
+          const double A = 0.0625 * (eps_plus - eps_minus);
+          double val = nominal[j] + x * (S + x * A * poly);
+          val = val < 0 ? 0. : val;
+          output[j] += val-nominal[j];
+        }
+      }
+      break ;
+    }
+    case 5: {
+      const double x0 = 1.0;//boundary;
+      if (x > x0 || x < -x0) {
+        if (x>0) {
+          for (std::size_t j = 0; j < n; ++j) { //CHECK_VECTORISE
+            output[j] += x*(high[j] - nominal[j]);
+          }
+        } else {
+          for (std::size_t j = 0; j < n; ++j) { //CHECK_VECTORISE
+            output[j] += x*(nominal[j] - low[j]);
+          }
+        }
+      } else {
+        const double x2 = pow(x, 2);
+        const double x4 = pow(x, 4);
+        for (std::size_t j = 0; j < n; ++j) { //CHECK_VECTORISE
+          const double eps_plus = high[j] - nominal[j];
+          const double eps_minus = nominal[j] - low[j];
+          const double S = (eps_plus + eps_minus)/2;
+          const double A = (eps_plus - eps_minus)/2;
+          const double a = S;
+          const double b = 3*A/(2*x0);
+          const double d = -A/(2*x0*x0*x0);
+          double val = nominal[j] + a*x + b*x2 + 0 + d*x4;
+          val = val < 0 ? 0. : val;
+          output[j] += nominal[j] != 0 ? val-nominal[j] : 0.;
+        }
+      }
+      break ;
+    }
+    default: {
+      coutE(InputArguments) << "PiecewiseInterpolation::evaluateBatch ERROR:  " << param->GetName()
+			    << " with unknown interpolation code" << icode << endl ;
+      break ;
+    }
+    }
+  }
+
+  if (_positiveDefinite) {
+    for (std::size_t j = 0; j < n; ++j) { //CHECK_VECTORISE
+      output[j] = output[j] < 0 ? 0. : output[j];
+    }
+  }
+
+  return output;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 Bool_t PiecewiseInterpolation::setBinIntegrator(RooArgSet& allVars) 
@@ -604,6 +775,7 @@ void PiecewiseInterpolation::setInterpCode(RooAbsReal& param, int code){
 			    << " is now " << code << endl ;
     _interpCode.at(index) = code;
   }
+  setValueDirty();
 }
 
 
@@ -613,6 +785,7 @@ void PiecewiseInterpolation::setAllInterpCodes(int code){
   for(unsigned int i=0; i<_interpCode.size(); ++i){
     _interpCode.at(i) = code;
   }
+  setValueDirty();
 }
 
 
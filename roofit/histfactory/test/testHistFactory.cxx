@@ -2,9 +2,15 @@
 // Authors: Stephan Hageboeck, CERN  01/2019
 
 #include "RooStats/HistFactory/Sample.h"
+#include "RooStats/HistFactory/FlexibleInterpVar.h"
+#include "RooStats/HistFactory/PiecewiseInterpolation.h"
 #include "RooStats/ModelConfig.h"
 #include "RooWorkspace.h"
 #include "RooArgSet.h"
+#include "RooRealVar.h"
+#include "RooDataHist.h"
+#include "RooDataSet.h"
+#include "RooHistFunc.h"
 
 #include "TROOT.h"
 #include "TFile.h"
@@ -81,3 +87,120 @@ TEST(HistFactory, Read_ROOT6_16_Combined_Model) {
   EXPECT_NEAR(pdf->getVal(), 0.17488817, 1.E-8);
   EXPECT_NEAR(pdf->getVal(*obs), 0.95652174, 1.E-8);
 }
+
+
+/// The terms of FlexibleInterpVar are cached per parameter. After changing
+/// parameters, the value must be the one of a fresh copy without cache.
+TEST(FlexibleInterpVar, CachedTerms)
+{
+  RooRealVar alpha1("alpha1", "", 0., -5., 5.);
+  RooRealVar alpha2("alpha2", "", 0., -5., 5.);
+  RooRealVar alpha3("alpha3", "", 0., -5., 5.);
+  FlexibleInterpVar fiv("fiv", "", RooArgList(alpha1, alpha2, alpha3), 1., {0.9, 0.7, 0.8}, {1.1, 1.2, 1.3},
+                        {4, 1, 0});
+
+  const double values[][3] = {{0., 0., 0.}, {0.5, 0., 0.}, {0.5, -0.3, 0.}, {0.5, -0.3, 2.},
+                              {-1.5, -0.3, 2.}, {-1.5, 0.7, -0.2}, {0., 0., 0.}};
+  for (const auto& v : values) {
+    alpha1.setVal(v[0]);
+    alpha2.setVal(v[1]);
+    alpha3.setVal(v[2]);
+    FlexibleInterpVar fresh(fiv, "fresh");
+    EXPECT_DOUBLE_EQ(fiv.getVal(), fresh.getVal()) << "at " << v[0] << " " << v[1] << " " << v[2];
+  }
+
+  // Changing the configuration invalidates the cache
+  fiv.setAllInterpCodes(0);
+  FlexibleInterpVar fresh(fiv, "fresh");
+  EXPECT_DOUBLE_EQ(fiv.getVal(), fresh.getVal());
+}
+
+/// Every setter of the interpolation configuration has to reset the cached
+/// terms: the value after the change must be that of a fresh copy, and differ
+/// from the value before.
+TEST(FlexibleInterpVar, ConfigurationChangesResetCache)
+{
+  RooRealVar alpha1("alpha1", "", 0.8, -5., 5.);
+  RooRealVar alpha2("alpha2", "", -0.6, -5., 5.);
+  FlexibleInterpVar fiv("fiv", "", RooArgList(alpha1, alpha2), 1., {0.9, 0.7}, {1.1, 1.2}, {4, 0});
+
+  auto expectReset = [&](const char* change) {
+    FlexibleInterpVar fresh(fiv, "fresh");
+    EXPECT_DOUBLE_EQ(fresh.getVal(), fiv.getVal()) << "after " << change;
+  };
+
+  // Fill the cache; alpha1 is in the polynomial region of code 4
+  double before = fiv.getVal();
+
+  fiv.setGlobalBoundary(0.5);
+  EXPECT_NE(before, fiv.getVal()) << "setGlobalBoundary";
+  expectReset("setGlobalBoundary");
+
+  before = fiv.getVal();
+  fiv.setLow(alpha2, 0.5);
+  EXPECT_NE(before, fiv.getVal()) << "setLow";
+  expectReset("setLow");
+
+  before = fiv.getVal();
+  fiv.setHigh(alpha1, 1.4);
+  EXPECT_NE(before, fiv.getVal()) << "setHigh";
+  expectReset("setHigh");
+
+  before = fiv.getVal();
+  fiv.setInterpCode(alpha2, 1);
+  EXPECT_NE(before, fiv.getVal()) << "setInterpCode";
+  expectReset("setInterpCode");
+
+  // Only the changed parameter is recomputed, the cached term of the other one is kept
+  alpha2.setVal(0.3);
+  expectReset("changing alpha2");
+}
+
+/// Changing the interpolation codes has to reach the values computed in
+/// batches, where all bins are interpolated in one pass.
+TEST(PiecewiseInterpolation, InterpCodesInBatches)
+{
+  RooRealVar x("x", "x", 0., 10.);
+  x.setBins(10);
+  TH1D hNom("hNom", "", 10, 0., 10.);
+  TH1D hLow("hLow", "", 10, 0., 10.);
+  TH1D hHigh("hHigh", "", 10, 0., 10.);
+  for (int i = 1; i <= 10; ++i) {
+    hNom.SetBinContent(i, 10. + i);
+    hLow.SetBinContent(i, 9. + 0.5 * i);
+    hHigh.SetBinContent(i, 12. + 1.2 * i);
+  }
+  RooDataHist dNom("dNom", "", x, &hNom);
+  RooDataHist dLow("dLow", "", x, &hLow);
+  RooDataHist dHigh("dHigh", "", x, &hHigh);
+  RooHistFunc nom("nom", "", x, dNom);
+  RooHistFunc low("low", "", x, dLow);
+  RooHistFunc high("high", "", x, dHigh);
+  RooRealVar alpha("alpha", "", 0., -5., 5.);
+  PiecewiseInterpolation interp("interp", "", nom, RooArgList(low), RooArgList(high), RooArgList(alpha));
+
+  RooDataSet data("data", "", x);
+  for (int i = 0; i < 10; ++i) {
+    x.setVal(0.5 + i);
+    data.add(x);
+  }
+  std::unique_ptr<RooArgSet> observables(interp.getObservables(data));
+
+  for (double a : {-2.5, -0.4, 0.3, 1.7}) {
+    alpha.setVal(a);
+    for (int code : {0, 1, 2, 4, 5, 3, 0}) {
+      interp.setAllInterpCodes(code);
+
+      data.attachBuffers(*observables);
+      auto batch = interp.getValBatch(0, data.numEntries());
+      ASSERT_EQ(batch.size(), static_cast<std::size_t>(data.numEntries()));
+      std::vector<double> values(batch.begin(), batch.end());
+      data.resetBuffers();
+
+      for (int i = 0; i < data.numEntries(); ++i) {
+        x.setVal(0.5 + i);
+        EXPECT_DOUBLE_EQ(values[i], interp.getVal()) << "code " << code << " alpha " << a << " bin " << i;
+      }
+    }
+  }
+}
@@ -28,6 +28,7 @@
 #include <set>
 #include <deque>
 #include <stack>
+#include <vector>
 #include <string>
 #include <iostream>
 
@@ -560,6 +561,9 @@ protected:
 
    /// Force element to re-evaluate itself when a value is requested.
    void setValueDirty(const RooAbsArg* source);
+   void setValueDirtyFromClosure();
+   const std::vector<RooAbsArg*>& valueClientClosure() const;
+   static void invalidateValueClientClosures();
    /// Notify that a shape-like property (*e.g.* binning) has changed.
    void setShapeDirty(const RooAbsArg* source);
 
@@ -625,7 +629,9 @@ private:
   friend class RooVectorDataStore ;
   friend class RooTreeData ;
   friend class RooDataSet ;
+  friend class RooDataHist ;
   friend class RooRealMPFE ;
+  friend class RooAbsTestStatistic ;
   virtual void syncCache(const RooArgSet* nset=0) = 0 ;
   virtual void copyCache(const RooAbsArg* source, Bool_t valueOnly=kFALSE, Bool_t setValDirty=kTRUE) = 0 ;
 
@@ -660,6 +666,9 @@ private:
   mutable Bool_t _shapeDirty ;  // Flag set if value needs recalculating because input shapes modified
   mutable bool _allBatchesDirty{true}; //! Mark batches as dirty (only meaningful for RooAbsReal).
 
+  mutable std::vector<RooAbsArg*> _valueClientClosure; //! Cached flat list of all nodes reached by value dirty propagation from this leaf
+  mutable std::size_t _valueClientClosureVersion{0}; //! Graph version for which _valueClientClosure was built (0: not built)
+
   mutable OperMode _operMode ; // Dirty state propagation mode
   mutable Bool_t _fast ; // Allow fast access mode in getVal() and proxies
 
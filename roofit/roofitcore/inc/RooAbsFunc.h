@@ -17,6 +17,7 @@
 #define ROO_ABS_FUNC
 
 #include "Rtypes.h"
+#include <cstddef>
 #include <list>
 class RooAbsRealLValue ;
 
@@ -36,6 +37,7 @@ public:
   }
 
   virtual Double_t operator()(const Double_t xvector[]) const = 0;
+  virtual void getValues(const Double_t* xvectors, Double_t* values, std::size_t nPoints) const;
   virtual Double_t getMinLimit(UInt_t dimension) const = 0;
   virtual Double_t getMaxLimit(UInt_t dimension) const = 0;
 
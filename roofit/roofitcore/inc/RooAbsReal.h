@@ -303,6 +303,8 @@ public:
   static void printEvalErrors(std::ostream&os=std::cout, Int_t maxPerNode=10000000) ;
   static Int_t numEvalErrors() ;
   static Int_t numEvalErrorItems() ;
+  static Int_t numEvalErrorsInThread() ;
+  static void clearEvalErrorsInThread() ;
 
    
   typedef std::map<const RooAbsArg*,std::pair<std::string,std::list<EvalError> > >::const_iterator EvalErrorIter ; 
@@ -455,6 +457,7 @@ protected:
 
   friend class RooAbsPdf ;
   friend class RooAbsAnaConvPdf ;
+  friend class RooFormula ; // Batch evaluation writes into _batchData
 
   RooNumIntConfig* _specIntegratorConfig ; // Numeric integrator configuration specific for this object
 
@@ -72,6 +72,7 @@ protected:
   mutable RooObjCacheManager _cacheMgr ; // The cache manager
 
   Double_t evaluate() const;
+  RooSpan<double> evaluateBatch(std::size_t begin, std::size_t batchSize) const;
 
   ClassDef(RooAddition,2) // Sum of RooAbsReal objects
 };
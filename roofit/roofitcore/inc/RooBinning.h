@@ -40,6 +40,7 @@ public:
     return _nbins+1;
   }
   virtual Int_t binNumber(Double_t x) const;
+  virtual void binNumbers(const Double_t* x, Int_t* bins, std::size_t n, Int_t coef=1) const;
   virtual Int_t rawBinNumber(Double_t x) const;
   virtual Double_t nearestBoundary(Double_t x) const;
 
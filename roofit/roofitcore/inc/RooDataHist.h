@@ -35,6 +35,7 @@ class RooPlot;
 class RooArgSet ;
 class RooLinkedList ;
 class RooAbsLValue ;
+namespace BatchHelpers { class BatchData ; }
 
 class RooDataHist : public RooAbsData, public RooDirItem {
 public:
@@ -108,6 +109,9 @@ public:
   }
   Double_t weightSquared() const ;
   Double_t weight(const RooArgSet& bin, Int_t intOrder=1, Bool_t correctForBinSize=kFALSE, Bool_t cdfBoundaries=kFALSE, Bool_t oneSafe=kFALSE) ;   
+  void weights(Double_t* output, std::size_t nEvents, const RooArgSet& bin, const std::vector<RooSpan<const double>>& coordinates, Bool_t correctForBinSize) ;
+  RooSpan<double> weightBatch(BatchHelpers::BatchData& batchData, std::size_t begin, std::size_t batchSize,
+      const RooArgSet& histObs, const RooArgSet& obs, Bool_t correctForBinSize) ;
   Double_t binVolume() const { return _curVolume ; }
   Double_t binVolume(const RooArgSet& bin) ; 
   virtual Bool_t valid() const ;
@@ -24,6 +24,7 @@ class RooDataHist;
 #include "RooAbsData.h"
 #include "RooDirItem.h"
 #include <list>
+#include <vector>
 
 
 #define USEMEMPOOLFORDATASET
@@ -117,6 +118,10 @@ public:
   virtual void addFast(const RooArgSet& row, Double_t weight=1.0, Double_t weightError=0);
 
   void append(RooDataSet& data) ;
+
+  // Add many rows from whole columns
+  Bool_t fillFromColumns(const RooArgList& vars, const std::vector<RooSpan<const double>>& columns) ;
+  Bool_t adoptColumns(const RooArgList& vars, std::vector<std::vector<double>>&& columns) ;
   Bool_t merge(RooDataSet* data1, RooDataSet* data2=0, RooDataSet* data3=0,  
  	       RooDataSet* data4=0, RooDataSet* data5=0, RooDataSet* data6=0) ; 
   Bool_t merge(std::list<RooDataSet*> dsetList) ;
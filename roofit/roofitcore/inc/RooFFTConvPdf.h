@@ -19,7 +19,12 @@
 #include "RooHistPdf.h"
 #include "TVirtualFFT.h"
 
+#include <complex>
+#include <memory>
+#include <vector>
+
 class RooRealVar;
+class RooChangeTracker;
 
 ///PDF for the numerical (FFT) convolution of two PDFs.
 class RooFFTConvPdf : public RooAbsCachedPdf {
@@ -73,7 +78,7 @@ protected:
   void calcParams() ;
   Bool_t redirectServersHook(const RooAbsCollection& newServerList, Bool_t mustReplaceAll, Bool_t nameChange, Bool_t isRecursive) ;
 
-  Double_t*  scanPdf(RooRealVar& obs, RooAbsPdf& pdf, const RooDataHist& hist, const RooArgSet& slicePos, Int_t& N, Int_t& N2, Int_t& zeroBin, Double_t shift) const ;
+  void scanPdf(RooRealVar& obs, RooAbsPdf& pdf, const RooDataHist& hist, const RooArgSet& slicePos, std::vector<Double_t>& array, Int_t& N, Int_t& N2, Int_t& zeroBin, Double_t shift) const ;
 
   class FFTCacheElem : public PdfCacheElem {
   public:
@@ -82,18 +87,39 @@ protected:
 
     virtual RooArgList containedArgs(Action) ;
 
-    TVirtualFFT* fftr2c1 ;
-    TVirtualFFT* fftr2c2 ;
-    TVirtualFFT* fftc2r ;
+    // Transformation plans with their buffers. Every thread convolving slices uses its own.
+    struct FFTPlans {
+      std::unique_ptr<TVirtualFFT> r2c ;
+      std::unique_ptr<TVirtualFFT> c2r ;
+    } ;
+    std::vector<FFTPlans> fftPlans ;
+
+    // Sampled inputs, their transforms and the convolution output of one slice of the cache
+    struct SliceData {
+      std::vector<Double_t> input1 ;
+      std::vector<Double_t> input2 ;
+      std::vector<std::complex<Double_t>> fft1 ;
+      std::vector<std::complex<Double_t>> fft2 ;
+      std::vector<Double_t> output ;
+    } ;
+    std::vector<SliceData> slices ;
+    Int_t N ;        // Number of bins of the convolution observable
+    Int_t N2 ;       // Number of bins including the buffer zones
+    Int_t zeroBin1 ; // Bin containing zero in the sampling of pdf1
 
     RooAbsPdf* pdf1Clone ;
     RooAbsPdf* pdf2Clone ;
 
+    RooChangeTracker* pdf1Tracker ; // Parameters of pdf1, to only re-sample the input that changed
+    RooChangeTracker* pdf2Tracker ; // Parameters of pdf2
+
     RooAbsBinning* histBinning ;
     RooAbsBinning* scanBinning ;
 
   };
 
+  static void convolveSlice(FFTCacheElem::FFTPlans& plans, FFTCacheElem::SliceData& slice, Int_t N, Int_t N2, Int_t totalShift, Bool_t redo1, Bool_t redo2) ;
+
   friend class FFTCacheElem ;  
 
   virtual Double_t evaluate() const { RooArgSet dummy(_x.arg()) ; return getVal(&dummy) ; } ; // dummy
@@ -102,7 +128,6 @@ protected:
   virtual RooArgSet* actualParameters(const RooArgSet& nset) const ;
   virtual RooAbsArg& pdfObservable(RooAbsArg& histObservable) const ;
   virtual void fillCacheObject(PdfCacheElem& cache) const ;
-  void fillCacheSlice(FFTCacheElem& cache, const RooArgSet& slicePosition) const ;
 
   virtual PdfCacheElem* createCache(const RooArgSet* nset) const ;
   virtual TString histNameSuffix() const ;
@@ -65,6 +65,7 @@ public:
 
   // Function evaluation
   virtual Double_t evaluate() const ;
+  virtual RooSpan<double> evaluateBatch(std::size_t begin, std::size_t batchSize) const ;
 
   protected:
   // Post-processing of server redirection
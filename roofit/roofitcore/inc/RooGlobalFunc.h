@@ -67,7 +67,9 @@ enum MsgLevel { DEBUG=0, INFO=1, PROGRESS=2, WARNING=3, ERROR=4, FATAL=5 } ;
 enum MsgTopic { Generation=1, Minimization=2, Plotting=4, Fitting=8, Integration=16, LinkStateMgmt=32, 
 	 Eval=64, Caching=128, Optimization=256, ObjectHandling=512, InputArguments=1024, Tracing=2048, 
 	 Contents=4096, DataHandling=8192, NumIntegration=16384, FastEvaluations=1<<15, HistFactory=1<<16 };
-enum MPSplit { BulkPartition=0, Interleave=1, SimComponents=2, Hybrid=3 } ;
+/// Strategies to split test statistics in NumCPU(). Threads can be added to a
+/// strategy to evaluate the partitions in threads instead of forked processes.
+enum MPSplit { BulkPartition=0, Interleave=1, SimComponents=2, Hybrid=3, Threads=4 } ;
 
 /**
  * \defgroup CmdArgs RooFit command arguments
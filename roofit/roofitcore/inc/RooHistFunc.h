@@ -85,6 +85,7 @@ protected:
   Bool_t areIdentical(const RooDataHist& dh1, const RooDataHist& dh2) ;
 
   Double_t evaluate() const;
+  RooSpan<double> evaluateBatch(std::size_t begin, std::size_t batchSize) const;
   Double_t totalVolume() const ;
   friend class RooAbsCachedReal ;
   Double_t totVolume() const ;
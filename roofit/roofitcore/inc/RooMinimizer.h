@@ -51,6 +51,7 @@ public:
   void optimizeConst(Int_t flag) ;
   void setEvalErrorWall(Bool_t flag) { fitterFcn()->SetEvalErrorWall(flag); }
   void setOffsetting(Bool_t flag) ;
+  void setParallelGradient(Int_t nWorkers) ;
   void setMaxIterations(Int_t n) ;
   void setMaxFunctionCalls(Int_t n) ; 
 
@@ -102,11 +103,13 @@ protected:
   inline std::ofstream* logfile() { return fitterFcn()->GetLogFile(); }
   inline Double_t& maxFCN() { return fitterFcn()->GetMaxFCN() ; }
   
-  const RooMinimizerFcn* fitterFcn() const {  return ( fitter()->GetFCN() ? ((RooMinimizerFcn*) fitter()->GetFCN()) : _fcn ) ; }
-  RooMinimizerFcn* fitterFcn() { return ( fitter()->GetFCN() ? ((RooMinimizerFcn*) fitter()->GetFCN()) : _fcn ) ; }
+  const RooMinimizerFcn* fitterFcn() const {  return ( dynamic_cast<const RooMinimizerFcn*>(fitter()->GetFCN()) ? dynamic_cast<const RooMinimizerFcn*>(fitter()->GetFCN()) : _fcn ) ; }
+  RooMinimizerFcn* fitterFcn() { return ( dynamic_cast<RooMinimizerFcn*>(fitter()->GetFCN()) ? dynamic_cast<RooMinimizerFcn*>(fitter()->GetFCN()) : _fcn ) ; }
 
 private:
 
+  bool fitFcn() ;
+
   Int_t       _printLevel ;
   Int_t       _status ;
   Bool_t      _optConst ;
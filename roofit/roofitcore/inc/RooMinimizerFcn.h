@@ -53,6 +53,8 @@ class RooMinimizerFcn : public ROOT::Math::IBaseFunctionMultiDim {
   Bool_t SetLogFile(const char* inLogfile);
   std::ofstream* GetLogFile() { return _logfile; }
   void SetVerbose(Bool_t flag=kTRUE) { _verbose = flag ; }
+  void SetParallelGradient(Int_t nWorkers) ;
+  Int_t GetParallelGradient() const { return _nGradWorkers ; }
 
   Double_t& GetMaxFCN() { return _maxFCN; }
   Int_t GetNumInvalidNLL() { return _numBadNLL; }
@@ -62,6 +64,9 @@ class RooMinimizerFcn : public ROOT::Math::IBaseFunctionMultiDim {
   void BackProp(const ROOT::Fit::FitResult &results);  
   void ApplyCovarianceMatrix(TMatrixDSym& V); 
 
+  void Gradient(const double *x, double *grad) const ;
+  double Derivative(const double *x, unsigned int icoord) const ;
+
   Int_t evalCounter() const { return _evalCounter ; }
   void zeroEvalCount() { _evalCounter = 0 ; }
 
@@ -80,6 +85,12 @@ class RooMinimizerFcn : public ROOT::Math::IBaseFunctionMultiDim {
   virtual double DoEval(const double * x) const;  
   void updateFloatVec() ;
 
+  std::vector<double> evalDerivatives(const double *x, const std::vector<Int_t>& coords) const ;
+  Bool_t evalGradientPointsMT(const double *x, const std::vector<Int_t>& pars, const std::vector<double>& lo,
+                              const std::vector<double>& hi, std::vector<double>& values) const ;
+  void initGradientClones() const ;
+  void clearGradientClones() const ;
+
 private:
 
   mutable Int_t _evalCounter ;
@@ -102,6 +113,12 @@ private:
   RooArgList* _initFloatParamList;
   RooArgList* _initConstParamList;
 
+  Int_t _nGradWorkers ;  // Number of clones of the function that evaluate the gradient in parallel
+  Bool_t _optConst ;     // Constant term optimization requested in the last Synchronize()
+  mutable std::vector<RooAbsReal*> _gradClones ;                  //! Clones of the function, one per gradient worker
+  mutable std::vector<std::vector<RooAbsArg*> > _gradCloneParams ; //! Parameters of each clone, ordered as _floatParamVec followed by _constParamList
+  mutable Bool_t _gradSerialEval ;                                //! Evaluate the clones one after another for the next gradient
+
 };
 
 #endif
@@ -157,6 +157,7 @@ private:
 
  
   friend class RooProdGenContext ;
+  friend class RooWorkspace ;
   virtual RooAbsGenContext* genContext(const RooArgSet &vars, const RooDataSet *prototype=0, 
 	                               const RooArgSet *auxProto=0, Bool_t verbose= kFALSE) const ;
 
@@ -18,6 +18,8 @@
 
 #include "RooAbsFunc.h"
 #include <list>
+#include <memory>
+#include <vector>
 
 class RooAbsRealLValue;
 class RooAbsReal;
@@ -30,6 +32,7 @@ public:
   virtual ~RooRealBinding();
 
   virtual Double_t operator()(const Double_t xvector[]) const;
+  virtual void getValues(const Double_t* xvectors, Double_t* values, std::size_t nPoints) const;
   virtual Double_t getMinLimit(UInt_t dimension) const;
   virtual Double_t getMaxLimit(UInt_t dimension) const;
 
@@ -44,6 +47,11 @@ public:
 protected:
 
   void loadValues(const Double_t xvector[]) const;
+
+  struct ThreadCopy;
+  std::unique_ptr<ThreadCopy> makeThreadCopy() const;
+  void syncThreadCopy(const ThreadCopy& copy) const;
+
   const RooAbsReal *_func;
   RooAbsRealLValue **_vars;
   const RooArgSet *_nset;
@@ -55,6 +63,9 @@ protected:
   mutable std::list<RooAbsReal*> _compList ; //!
   mutable std::list<Double_t>    _compSave ; //!
   mutable Double_t _funcSave ; //!
+
+  mutable std::vector<std::unique_ptr<ThreadCopy>> _threadCopies ; //! Independent copies of the function, for evaluation in threads
+  mutable Bool_t _threadCopyFailed ; //! Function cannot be copied for evaluation in threads
   
   ClassDef(RooRealBinding,0) // Function binding to RooAbsReal object
 };
@@ -92,6 +92,10 @@ public:
   // Add rows 
   virtual void append(RooAbsDataStore& other) override;
 
+  // Add rows from whole columns
+  Bool_t fillFromColumns(const RooArgList& vars, const std::vector<RooSpan<const double>>& columns);
+  Bool_t adoptColumns(const RooArgList& vars, std::vector<std::vector<double>>&& columns);
+
   // General & bookkeeping methods
   virtual Bool_t valid() const override;
   virtual Int_t numEntries() const override { return static_cast<int>(size()); }
@@ -619,6 +623,11 @@ public:
 
   void setAllBuffersNative() ;
 
+  std::vector<std::size_t> columnPositions(const RooArgList& vars, std::size_t nColumns, const char* caller) const ;
+  Bool_t appendColumnsFrom(const RooVectorDataStore& other) ;
+  void padErrorColumns() ;
+  void addToSumWeight(std::size_t firstEntry) ;
+
   Double_t _sumWeight ; 
   Double_t _sumWeightCarry;
 
@@ -25,6 +25,7 @@
 #include <map>
 #include <list>
 #include <string>
+#include <vector>
 #include "ROOT/RMakeUnique.hxx"
 
 class TClass ;
@@ -36,6 +37,7 @@ class RooAbsReal ;
 class RooAbsCategory ;
 class RooFactoryWSTool ;
 class RooAbsStudy ;
+class TFile ;
 
 #include "TNamed.h"
 #include "TDirectoryFile.h"
@@ -110,8 +112,8 @@ public:
   RooAbsArg* arg(const char* name) const ;
   RooAbsArg* fundArg(const char* name) const ;
   RooArgSet argSet(const char* nameList) const ;
-  TIterator* componentIterator() const { return _allOwnedNodes.createIterator() ; }
-  const RooArgSet& components() const { return _allOwnedNodes ; }
+  TIterator* componentIterator() const { loadAllIndexed() ; return _allOwnedNodes.createIterator() ; }
+  const RooArgSet& components() const { loadAllIndexed() ; return _allOwnedNodes ; }
   TObject* genobj(const char* name) const ;
   TObject* obj(const char* name) const ;
 
@@ -131,6 +133,12 @@ public:
 
   Bool_t writeToFile(const char* fileName, Bool_t recreate=kTRUE) ;
 
+  // Indexed persistence with on-demand loading of components and datasets
+  Bool_t writeIndexedToFile(const char* fileName, Bool_t recreate=kTRUE) ;
+  static RooWorkspace* openIndexed(const char* fileName, const char* name) ;
+  /// True if this workspace was opened with openIndexed(), and may load components on first access.
+  Bool_t isIndexed() const { return _indexDir != nullptr ; }
+
   /// Make internal collection use an unordered_map for
   /// faster searching. Important when large trees are
   /// imported / or modified in the workspace.
@@ -251,6 +259,11 @@ public:
     void exportObj(TObject *obj);
     void unExport();
 
+    RooAbsArg* loadIndexedArg(const char* name) const;
+    RooAbsData* loadIndexedData(const char* name, Bool_t embedded) const;
+    void loadAllIndexed() const;
+    static std::vector<RooArgSet*> normSetsOutsideProxies(RooAbsArg& node);
+
     friend class CodeRepo;
     static std::list<std::string> _classDeclDirList;
     static std::list<std::string> _classImplDirList;
@@ -283,6 +296,9 @@ public:
     Bool_t _openTrans;       //! Is there a transaction open?
     RooArgSet _sandboxNodes; //! Sandbox for incoming objects in a transaction
 
+    std::unique_ptr<TFile> _indexFile; //! File holding the not yet loaded contents of an indexed workspace
+    TDirectory* _indexDir{nullptr};    //! Directory of this workspace in _indexFile
+
     ClassDef(RooWorkspace, 8) // Persistable project container for (composite) pdfs, functions, variables and datasets
 } ;
 
@@ -68,6 +68,8 @@ setting/clearing/testing named attributes.
 #include <sstream>
 #include <cstring>
 #include <algorithm>
+#include <atomic>
+#include <unordered_set>
 
 using namespace std;
 
@@ -85,6 +87,18 @@ Bool_t RooAbsArg::inhibitDirty() const { return _inhibitDirty && !_localNoInhibi
 std::map<RooAbsArg*,std::unique_ptr<TRefArray>> RooAbsArg::_ioEvoList;
 std::stack<RooAbsArg*> RooAbsArg::_ioReadStack ;
 
+namespace {
+
+/// Version of the structure of all computation graphs. Cached value client closures
+/// are valid as long as this doesn't change. Zero marks a closure that was never built.
+std::atomic<std::size_t>& graphVersion()
+{
+  static std::atomic<std::size_t> version{1};
+  return version;
+}
+
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Default constructor
@@ -161,6 +175,7 @@ RooAbsArg& RooAbsArg::operator=(const RooAbsArg& other) {
   _stringAttrib = other._stringAttrib;
   _deleteWatch = other._deleteWatch;
   _operMode = other._operMode;
+  invalidateValueClientClosures();
   _fast = other._fast;
   _ownedComponents = nullptr;
   _prohibitServerRedirect = other._prohibitServerRedirect;
@@ -381,6 +396,8 @@ void RooAbsArg::addServer(RooAbsArg& server, Bool_t valueProp, Bool_t shapeProp,
   server._clientList.Add(this, refCount);
   if (valueProp) server._clientListValue.Add(this, refCount);
   if (shapeProp) server._clientListShape.Add(this, refCount);
+
+  if (valueProp) invalidateValueClientClosures() ;
 }
 
 
@@ -423,6 +440,8 @@ void RooAbsArg::removeServer(RooAbsArg& server, Bool_t force)
   server._clientList.Remove(this, force) ;
   server._clientListValue.Remove(this, force) ;
   server._clientListShape.Remove(this, force) ;
+
+  invalidateValueClientClosures() ;
 }
 
 
@@ -466,6 +485,8 @@ void RooAbsArg::changeServer(RooAbsArg& server, Bool_t valueProp, Bool_t shapePr
   if (shapeProp) {
     server._clientListShape.Add(this, scount) ;
   }
+
+  invalidateValueClientClosures() ;
 }
 
 
@@ -835,6 +856,13 @@ void RooAbsArg::setValueDirty(const RooAbsArg* source)
     return ;
   }
 
+  // Leaf nodes (typically fit parameters and observables) have their value clients
+  // flattened once, so that setting them dirty doesn't walk every path of the graph
+  if (source==0 && _serverList.empty() && !_verboseDirty) {
+    setValueDirtyFromClosure() ;
+    return ;
+  }
+
   // Cyclical dependency interception
   if (source==0) {
     source=this ;
@@ -863,6 +891,69 @@ void RooAbsArg::setValueDirty(const RooAbsArg* source)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Raise the value dirty flag of this object and of all nodes in its value client
+/// closure. This is equivalent to the recursive propagation of setValueDirty(), but
+/// every client is visited only once, also if it can be reached through many paths
+/// of the graph.
+
+void RooAbsArg::setValueDirtyFromClosure()
+{
+  _valueDirty = kTRUE ;
+
+  for (auto client : valueClientClosure()) {
+    client->_allBatchesDirty = true;
+    if (client->_operMode==Auto) {
+      client->_valueDirty = kTRUE ;
+    }
+  }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the flat list of all nodes that receive a value dirty flag when this
+/// object changes its value. Propagation stops at clients that are not in Auto
+/// mode, like in setValueDirty(). The list is cached and rebuilt when the structure
+/// of any graph (server links or operation modes) has changed since it was built.
+
+const std::vector<RooAbsArg*>& RooAbsArg::valueClientClosure() const
+{
+  const std::size_t version = graphVersion().load() ;
+  if (_valueClientClosureVersion == version) return _valueClientClosure ;
+
+  _valueClientClosure.clear() ;
+  std::unordered_set<const RooAbsArg*> visited{this} ;
+  std::vector<const RooAbsArg*> stack{this} ;
+  while (!stack.empty()) {
+    const RooAbsArg* arg = stack.back() ;
+    stack.pop_back() ;
+    for (auto client : arg->_clientListValue) {
+      if (client==this) {
+        coutE(LinkStateMgmt) << "RooAbsArg::setValueDirty(" << GetName()
+                             << "): cyclical dependency detected, source = " << GetName() << endl ;
+        continue ;
+      }
+      if (!visited.insert(client).second) continue ;
+      _valueClientClosure.push_back(client) ;
+      if (client->_operMode==Auto) stack.push_back(client) ;
+    }
+  }
+
+  _valueClientClosureVersion = version ;
+  return _valueClientClosure ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Invalidate the cached value client closures of all objects. Needs to be called
+/// whenever value client links or operation modes are changed.
+
+void RooAbsArg::invalidateValueClientClosures()
+{
+  ++graphVersion() ;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Mark this object as having changed its shape, and propagate this status
 /// change to all of our clients.
@@ -1723,6 +1814,7 @@ void RooAbsArg::setOperMode(OperMode mode, Bool_t recurseADirty)
   if (mode==_operMode) return ;
 
   _operMode = mode ;
+  invalidateValueClientClosures() ;
   _fast = ((mode==AClean) || dynamic_cast<RooRealVar*>(this)!=0 || dynamic_cast<RooConstVar*>(this)!=0 ) ;
   for (Int_t i=0 ;i<numCaches() ; i++) {
     getCache(i)->operModeHook() ;
@@ -56,6 +56,20 @@ RooAbsBinning::~RooAbsBinning()
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Add coef times the bin number of x[i] to bins[i], for i in [0, n). This
+/// is the batch version of binNumber(), used to compute the indices of the
+/// bins of multi-dimensional histograms in one pass per dimension.
+
+void RooAbsBinning::binNumbers(const Double_t* x, Int_t* bins, std::size_t n, Int_t coef) const
+{
+  for (std::size_t i = 0; i < n; ++i) {
+    bins[i] += coef * binNumber(x[i]) ;
+  }
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Print binning name
 
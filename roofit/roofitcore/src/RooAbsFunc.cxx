@@ -39,6 +39,21 @@ ClassImp(RooAbsFunc);
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the function at nPoints points. The getDimension() coordinates
+/// of each point are stored one after the other in xvectors, the result for
+/// point i is written to values[i]. Implementations may evaluate the points
+/// in parallel; the default evaluates them one by one.
+
+void RooAbsFunc::getValues(const Double_t* xvectors, Double_t* values, std::size_t nPoints) const
+{
+  for (std::size_t i = 0; i < nPoints; ++i) {
+    values[i] = (*this)(xvectors + i * _dimension);
+  }
+}
+
+
+
 
 
 
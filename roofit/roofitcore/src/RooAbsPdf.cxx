@@ -867,6 +867,9 @@ Double_t RooAbsPdf::extendedTerm(Double_t observed, const RooArgSet* nset) const
 ///                     do not share many parameters
 ///   <tr><td> 3 = RooFit::Hybrid <td> Follow strategy 0 for all RooSimultaneous components, except those with less than
 ///                     30 dataset entries, for which strategy 2 is followed.
+///   <tr><td> + RooFit::Threads <td> Added to one of the strategies above, e.g. `RooFit::Interleave | RooFit::Threads`,
+///                     evaluates the partitions in threads of the ROOT task pool instead of forked processes.
+///                     Requires ROOT to be built with imt.
 ///   </table>
 /// <tr><td> `BatchMode(bool on)`              <td> Batch evaluation mode. See createNLL().
 /// <tr><td> `Optimize(Bool_t flag)`           <td> Activate constant term optimization (on by default)
@@ -957,10 +960,10 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooLinkedList& cmdList)
   Int_t numcpu   = pc.getInt("numcpu") ;
   Int_t numcpu_strategy = pc.getInt("interleave");
   // strategy 3 works only for RooSimultaneus.
-  if (numcpu_strategy==3 && !this->InheritsFrom("RooSimultaneous") ) {
+  if ((numcpu_strategy & ~RooFit::Threads)==3 && !this->InheritsFrom("RooSimultaneous") ) {
      coutW(Minimization) << "Cannot use a NumCpu Strategy = 3 when the pdf is not a RooSimultaneus, "
                             "falling back to default strategy = 0"  << endl;
-     numcpu_strategy = 0;
+     numcpu_strategy &= RooFit::Threads;
   }
   RooFit::MPSplit interl = (RooFit::MPSplit) numcpu_strategy;
 
@@ -1172,6 +1175,9 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooLinkedList& cmdList)
 ///                     do not share many parameters
 ///   <tr><td> 3 = RooFit::Hybrid <td> Follow strategy 0 for all RooSimultaneous components, except those with less than
 ///                     30 dataset entries, for which strategy 2 is followed.
+///   <tr><td> + RooFit::Threads <td> Added to one of the strategies above, e.g. `RooFit::Interleave | RooFit::Threads`,
+///                     evaluates the partitions in threads of the ROOT task pool instead of forked processes.
+///                     Requires ROOT to be built with imt.
 ///   </table>
 /// <tr><td> `SplitRange(Bool_t flag)`          <td>  Use separate fit ranges in a simultaneous fit. Actual range name for each subsample is assumed
 ///                                                 to by `rangeName_indexState` where indexState is the state of the master index category of the simultaneous fit.
@@ -106,9 +106,29 @@
 #include <sstream>
 #include <iostream>
 #include <iomanip>
+#include <mutex>
 
 using namespace std ;
 
+namespace {
+
+/// Evaluation errors may be logged from several threads at the same time,
+/// e.g. by the partitions of a test statistic evaluated in parallel.
+std::mutex& evalErrorMutex()
+{
+  static std::mutex theMutex;
+  return theMutex;
+}
+
+/// Number of evaluation errors reported in the calling thread, in any logging mode.
+Int_t& evalErrorsInThread()
+{
+  static thread_local Int_t count = 0;
+  return count;
+}
+
+}
+
 ClassImp(RooAbsReal)
 
 Bool_t RooAbsReal::_globalSelectComp = false;
@@ -3672,16 +3692,19 @@ Double_t RooAbsReal::maxVal(Int_t /*code*/) const
 
 void RooAbsReal::logEvalError(const RooAbsReal* originator, const char* origName, const char* message, const char* serverValueString)
 {
+  ++evalErrorsInThread() ;
+
   if (_evalErrorMode==Ignore) {
     return ;
   }
 
   if (_evalErrorMode==CountErrors) {
+    std::lock_guard<std::mutex> lock(evalErrorMutex()) ;
     _evalErrorCount++ ;
     return ;
   }
 
-  static Bool_t inLogEvalError = kFALSE ;
+  static thread_local Bool_t inLogEvalError = kFALSE ;
 
   if (inLogEvalError) {
     return ;
@@ -3695,6 +3718,7 @@ void RooAbsReal::logEvalError(const RooAbsReal* originator, const char* origName
     ee.setServerValues(serverValueString) ;
   }
 
+  std::lock_guard<std::mutex> lock(evalErrorMutex()) ;
   if (_evalErrorMode==PrintErrors) {
    oocoutE((TObject*)0,Eval) << "RooAbsReal::logEvalError(" << "<STATIC>" << ") evaluation error, " << endl
 		   << " origin       : " << origName << endl
@@ -3727,16 +3751,19 @@ void RooAbsReal::logEvalError(const RooAbsReal* originator, const char* origName
 
 void RooAbsReal::logEvalError(const char* message, const char* serverValueString) const
 {
+  ++evalErrorsInThread() ;
+
   if (_evalErrorMode==Ignore) {
     return ;
   }
 
   if (_evalErrorMode==CountErrors) {
+    std::lock_guard<std::mutex> lock(evalErrorMutex()) ;
     _evalErrorCount++ ;
     return ;
   }
 
-  static Bool_t inLogEvalError = kFALSE ;
+  static thread_local Bool_t inLogEvalError = kFALSE ;
 
   if (inLogEvalError) {
     return ;
@@ -3769,6 +3796,7 @@ void RooAbsReal::logEvalError(const char* message, const char* serverValueString
   ostringstream oss2 ;
   printStream(oss2,kName|kClassName|kArgs,kInline)  ;
 
+  std::lock_guard<std::mutex> lock(evalErrorMutex()) ;
   if (_evalErrorMode==PrintErrors) {
    coutE(Eval) << "RooAbsReal::logEvalError(" << GetName() << ") evaluation error, " << endl
 	       << " origin       : " << oss2.str() << endl
@@ -3880,6 +3908,28 @@ Int_t RooAbsReal::numEvalErrors()
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of evaluation errors reported in the calling thread since
+/// the last call to clearEvalErrorsInThread(). Errors are counted in all logging
+/// modes, including Ignore. This allows work that is distributed over threads to
+/// check its own evaluations without reading the global error log.
+
+Int_t RooAbsReal::numEvalErrorsInThread()
+{
+  return evalErrorsInThread() ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Reset the count of evaluation errors of the calling thread, see numEvalErrorsInThread().
+
+void RooAbsReal::clearEvalErrorsInThread()
+{
+  evalErrorsInThread() = 0 ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Fix the interpretation of the coefficient of any RooAddPdf component in
 /// the expression tree headed by this object to the given set of observables.
@@ -32,6 +32,25 @@ organizes multi-processor parallel calculation of test statistic
 values. For the latter, the test statistic value is calculated in
 partitions in parallel executing processes and a posteriori
 combined in the main thread.
+
+If the splitting strategy passed to NumCPU() includes the RooFit::Threads flag,
+e.g. `NumCPU(4, RooFit::Interleave | RooFit::Threads)`, the partitions are
+instead evaluated by threads of the ROOT task pool, within the same process.
+Each partition is a clone of the test statistic with its own copy of the
+model, the data and the parameters; the parameter values of the master are
+copied into the partitions before each evaluation, and the partial results
+are added in a fixed order, so that the value does not depend on the
+scheduling of the threads.
+
+Creating RooFit objects is not thread safe (memory pools, the name registry
+and the expensive object cache are shared). Partitions therefore must never
+create objects while they are evaluated in threads. All objects that a
+partition needs are created in its first evaluation, which runs the
+partitions in sequence. Every change that can make a partition create new
+objects (setting up the partitions, setData(), a change of the constant
+flags of the parameters, constant term optimization or offsetting) makes
+the next evaluation run in sequence again. Changing only parameter values
+only recomputes existing caches.
 **/
 
 #include "RooAbsTestStatistic.h"
@@ -50,10 +69,17 @@ combined in the main thread.
 #include "RooRealSumPdf.h"
 #include "RooAbsCategoryLValue.h"
 
+#include "RConfigure.h"
 #include "TTimeStamp.h"
 #include "TClass.h"
 #include <string>
 
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#include "TROOT.h"
+#endif
+
 using namespace std;
 
 ClassImp(RooAbsTestStatistic);
@@ -65,7 +91,7 @@ RooAbsTestStatistic::RooAbsTestStatistic() :
   _func(0), _data(0), _projDeps(0), _splitRange(0), _simCount(0),
   _verbose(kFALSE), _init(kFALSE), _gofOpMode(Slave), _nEvents(0), _setNum(0),
   _numSets(0), _extSet(0), _nGof(0), _gofArray(0), _nCPU(1), _mpfeArray(0),
-  _mpinterl(RooFit::BulkPartition), _doOffset(kFALSE), _offset(0),
+  _mtArray(0), _mtSerialEval(kTRUE), _mpinterl(RooFit::BulkPartition), _doOffset(kFALSE), _offset(0),
   _offsetCarry(0), _evalCarry(0)
 {
 }
@@ -81,7 +107,8 @@ RooAbsTestStatistic::RooAbsTestStatistic() :
 /// \param[in] projDeps A set of projected observables
 /// \param[in] rangeName Fit data only in range with given name
 /// \param[in] addCoefRangeName If not null, all RooAddPdf components of `real` will be instructed to fix their fraction definitions to the given named range.
-/// \param[in] nCPU If larger than one, the test statistic calculation will be parallelized over multiple processes.
+/// \param[in] nCPU If larger than one, the test statistic calculation will be parallelized over multiple processes,
+/// or over multiple threads if `interleave` includes RooFit::Threads.
 /// By default the data is split with 'bulk' partitioning (each process calculates a contigious block of fraction 1/nCPU
 /// of the data). For binned data this approach may be suboptimal as the number of bins with >0 entries
 /// in each processing block many vary greatly thereby distributing the workload rather unevenly.
@@ -114,12 +141,16 @@ RooAbsTestStatistic::RooAbsTestStatistic(const char *name, const char *title, Ro
   _gofArray(0),
   _nCPU(nCPU),
   _mpfeArray(0),
-  _mpinterl(interleave),
+  _mtArray(0),
+  _mtSerialEval(kTRUE),
+  _mpinterl(RooFit::MPSplit(interleave & ~RooFit::Threads)),
   _doOffset(kFALSE),
   _offset(0),
   _offsetCarry(0),
   _evalCarry(0)
 {
+  const Bool_t useThreads = (interleave & RooFit::Threads) != 0 ;
+
   // Register all parameters as servers
   RooArgSet* params = real.getParameters(&data) ;
   _paramSet.add(*params) ;
@@ -132,6 +163,15 @@ RooAbsTestStatistic::RooAbsTestStatistic(const char *name, const char *title, Ro
     }
 
     _gofOpMode = MPMaster ;
+    if (_nCPU>1 && useThreads) {
+#ifdef R__USE_IMT
+      // Use threads rather than forked processes if requested
+      _gofOpMode = MTMaster ;
+#else
+      coutW(InputArguments) << "RooAbsTestStatistic::ctor(" << GetName() << ") ROOT was built without imt,"
+			    << " evaluating partitions in parallel processes instead of threads" << endl ;
+#endif
+    }
 
   } else {
 
@@ -173,6 +213,8 @@ RooAbsTestStatistic::RooAbsTestStatistic(const RooAbsTestStatistic& other, const
   _gofSplitMode(other._gofSplitMode),
   _nCPU(other._nCPU),
   _mpfeArray(0),
+  _mtArray(0),
+  _mtSerialEval(kTRUE),
   _mpinterl(other._mpinterl),
   _doOffset(other._doOffset),
   _offset(other._offset),
@@ -188,7 +230,7 @@ RooAbsTestStatistic::RooAbsTestStatistic(const RooAbsTestStatistic& other, const
       _nCPU=1 ;
     }
       
-    _gofOpMode = MPMaster ;
+    _gofOpMode = (other._gofOpMode == MTMaster) ? MTMaster : MPMaster ;
 
   } else {
 
@@ -223,6 +265,12 @@ RooAbsTestStatistic::~RooAbsTestStatistic()
     delete[] _mpfeArray ;
   }
 
+  if (MTMaster == _gofOpMode && _init) {
+    for (Int_t i = 0; i < _nCPU; ++i) delete _mtArray[i];
+    delete[] _mtArray ;
+    for (auto params : _mtParamArray) delete params;
+  }
+
   if (SimMaster == _gofOpMode && _init) {
     for (Int_t i = 0; i < _nGof; ++i) delete _gofArray[i];
     delete[] _gofArray ;
@@ -239,7 +287,7 @@ RooAbsTestStatistic::~RooAbsTestStatistic()
 /// is calculated from a RooSimultaneous, the test statistic calculation
 /// is performed separately on each simultaneous p.d.f component and associated
 /// data, and then combined. If the test statistic calculation is parallelized,
-/// partitions are calculated in nCPU processes and combined a posteriori.
+/// partitions are calculated in nCPU processes (or threads) and combined a posteriori.
 
 Double_t RooAbsTestStatistic::evaluate() const
 {
@@ -299,6 +347,43 @@ Double_t RooAbsTestStatistic::evaluate() const
     _evalCarry = carry;
     return ret ;
 
+  } else if (MTMaster == _gofOpMode) {
+
+    syncMTParameters() ;
+
+    std::vector<Double_t> values(_nCPU), carries(_nCPU) ;
+    auto evalPartition = [&](Int_t i) {
+      values[i] = _mtArray[i]->getVal() ;
+      carries[i] = _mtArray[i]->getCarry() ;
+    } ;
+
+#ifdef R__USE_IMT
+    if (!_mtSerialEval) {
+      ROOT::TThreadExecutor pool ;
+      pool.Foreach(evalPartition, ROOT::TSeqI(_nCPU)) ;
+    } else
+#endif
+    {
+      // First evaluation after a change of configuration: partitions may still
+      // create caches and normalization integrals, which is not thread safe
+      for (Int_t i = 0; i < _nCPU; ++i) evalPartition(i) ;
+      _mtSerialEval = kFALSE ;
+    }
+
+    // Combine in fixed order, independent of the thread scheduling
+    Double_t sum(0), carry = 0.;
+    for (Int_t i = 0; i < _nCPU; ++i) {
+      Double_t y = values[i];
+      carry += carries[i];
+      y -= carry;
+      const Double_t t = sum + y;
+      carry = (t - sum) - y;
+      sum = t;
+    }
+
+    _evalCarry = carry;
+    return sum ;
+
   } else {
 
     // Evaluate as straight FUNC
@@ -354,6 +439,8 @@ Bool_t RooAbsTestStatistic::initialize()
   
   if (MPMaster == _gofOpMode) {
     initMPMode(_func,_data,_projDeps,_rangeName.size()?_rangeName.c_str():0,_addCoefRangeName.size()?_addCoefRangeName.c_str():0) ;
+  } else if (MTMaster == _gofOpMode) {
+    initMTMode(_func,_data,_projDeps,_rangeName.size()?_rangeName.c_str():0,_addCoefRangeName.size()?_addCoefRangeName.c_str():0) ;
   } else if (SimMaster == _gofOpMode) {
     initSimMode((RooSimultaneous*)_func,_data,_projDeps,_rangeName.size()?_rangeName.c_str():0,_addCoefRangeName.size()?_addCoefRangeName.c_str():0) ;
   }
@@ -433,6 +520,12 @@ void RooAbsTestStatistic::constOptimizeTestStatistic(ConstOpCode opcode, Bool_t
     for (Int_t i = 0; i < _nCPU; ++i) {
       _mpfeArray[i]->constOptimizeTestStatistic(opcode,doAlsoTrackingOpt);
     }
+  } else if (MTMaster == _gofOpMode) {
+    syncMTParameters() ;
+    for (Int_t i = 0; i < _nCPU; ++i) {
+      _mtArray[i]->constOptimizeTestStatistic(opcode,doAlsoTrackingOpt);
+    }
+    _mtSerialEval = kTRUE ;
   }
 }
 
@@ -490,6 +583,63 @@ void RooAbsTestStatistic::initMPMode(RooAbsReal* real, RooAbsData* data, const R
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Initialize multi-threaded calculation mode. Create one component test statistic
+/// per partition, each with its own clone of the function and the data. The
+/// components are connected to private copies of the parameters, such that
+/// no object is shared between the threads evaluating them.
+
+void RooAbsTestStatistic::initMTMode(RooAbsReal* real, RooAbsData* data, const RooArgSet* projDeps, const char* rangeName, const char* addCoefRangeName)
+{
+  _mtArray = new pRooAbsTestStatistic[_nCPU];
+  _mtParamArray.resize(_nCPU);
+
+  for (Int_t i = 0; i < _nCPU; ++i) {
+    RooAbsTestStatistic* gof = create(Form("%s_GOF%d",GetName(),i),Form("%s_GOF%d",GetTitle(),i),*real,*data,*projDeps,
+                                      rangeName,addCoefRangeName,1,_mpinterl,_verbose,_splitRange);
+    _mtParamArray[i] = (RooArgSet*) _paramSet.snapshot(kFALSE) ;
+    gof->recursiveRedirectServers(*_mtParamArray[i]);
+    gof->setMPSet(i,_nCPU);
+    _mtArray[i] = gof;
+  }
+  _mtSerialEval = kTRUE ;
+
+  coutI(Eval) << "RooAbsTestStatistic::initMTMode: created " << _nCPU << " partitions for evaluation in parallel threads." << endl;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy the values and constant flags of the parameters of this test statistic
+/// to the private parameters of the partitions evaluated in threads.
+
+void RooAbsTestStatistic::syncMTParameters() const
+{
+  for (Int_t i = 0; i < _nCPU; ++i) {
+    RooArgSet& copies = *_mtParamArray[i] ;
+    for (std::size_t j = 0; j < _paramSet.size(); ++j) {
+      const RooAbsArg* var = _paramSet[j] ;
+      RooAbsArg* copy = j < copies.size() ? copies[j] : nullptr ;
+      if (!copy || copy->namePtr() != var->namePtr()) {
+        // Parameters of the master were redirected or reordered
+        copy = copies.find(*var) ;
+        if (!copy) continue ;
+      }
+      if (var->isConstant() != copy->isConstant()) {
+        copy->setAttribute("Constant",var->isConstant()) ;
+        copy->setValueDirty() ;
+        // Partitions may rebuild caches for the new set of floating parameters
+        _mtSerialEval = kTRUE ;
+      }
+      if (!copy->isIdentical(*var,kTRUE)) {
+        copy->copyCache(var) ;
+      }
+    }
+  }
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Initialize simultaneous p.d.f processing mode. Strip simultaneous
 /// p.d.f into individual components, split dataset in subset
@@ -673,6 +823,15 @@ Bool_t RooAbsTestStatistic::setData(RooAbsData& indata, Bool_t cloneData)
     coutF(DataHandling) << "RooAbsTestStatistic::setData(" << GetName() << ") FATAL: setData() is not supported in multi-processor mode" << endl;
     throw std::runtime_error("RooAbsTestStatistic::setData is not supported in MPMaster mode");
     break;
+  case MTMaster:
+    // Forward to partitions; each thread needs its own copy of the data
+    initialize();
+    for (Int_t i = 0; i < _nCPU; ++i) {
+      _mtArray[i]->setData(indata, kTRUE);
+    }
+    _mtSerialEval = kTRUE;
+    setValueDirty();
+    break;
   }
 
   return kTRUE;
@@ -709,6 +868,14 @@ void RooAbsTestStatistic::enableOffsetting(Bool_t flag)
       _mpfeArray[i]->enableOffsetting(flag);
     }
     break;
+  case MTMaster:
+    _doOffset = flag;
+    for (Int_t i = 0; i < _nCPU; ++i) {
+      _mtArray[i]->enableOffsetting(flag);
+    }
+    _mtSerialEval = kTRUE;
+    setValueDirty();
+    break;
   }
 }
 
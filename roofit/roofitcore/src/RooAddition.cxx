@@ -37,9 +37,12 @@ in the two sets.
 #include "RooNLLVar.h"
 #include "RooChi2Var.h"
 #include "RooMsgService.h"
+#include "BatchHelpers.h"
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
+#include <vector>
 
 using namespace std;
 
@@ -179,6 +182,44 @@ Double_t RooAddition::evaluate() const
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the sum in batches. Terms that do not depend on the observables
+/// of the batch are added as constants.
+
+RooSpan<double> RooAddition::evaluateBatch(std::size_t begin, std::size_t batchSize) const
+{
+  const RooArgSet* nset = _set.nset() ;
+
+  std::vector<RooSpan<const double>> batches;
+  batches.reserve(_set.size());
+  for (const auto arg : _set) {
+    batches.push_back(static_cast<const RooAbsReal*>(arg)->getValBatch(begin, batchSize, nset));
+  }
+
+  const std::size_t n = BatchHelpers::findSize(batches);
+  if (n == std::numeric_limits<std::size_t>::max()) {
+    return {};
+  }
+
+  auto output = _batchData.makeWritableBatchInit(begin, n, 0.);
+  for (std::size_t k = 0; k < batches.size(); ++k) {
+    const auto& batch = batches[k];
+    if (batch.empty()) {
+      const double val = static_cast<const RooAbsReal&>(_set[k]).getVal(nset);
+      for (std::size_t i = 0; i < n; ++i) { //CHECK_VECTORISE
+        output[i] += val;
+      }
+    } else {
+      for (std::size_t i = 0; i < n; ++i) { //CHECK_VECTORISE
+        output[i] += batch[i];
+      }
+    }
+  }
+
+  return output;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the default error level for MINUIT error analysis
 /// If the addition contains one or more RooNLLVars and 
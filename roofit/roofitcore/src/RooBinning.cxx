@@ -188,6 +188,17 @@ Int_t RooBinning::binNumber(Double_t x) const
   return std::max(0, std::min(_nbins, rawBinNumber(x) - _blo));
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Add coef times the bin number of x[i] to bins[i], for i in [0, n), without
+/// a virtual call per value.
+
+void RooBinning::binNumbers(const Double_t* x, Int_t* bins, std::size_t n, Int_t coef) const
+{
+  for (std::size_t i = 0; i < n; ++i) {
+    bins[i] += coef * std::max(0, std::min(_nbins, RooBinning::rawBinNumber(x[i]) - _blo));
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return sequential bin number that contains value x where bin
 /// zero is the first bin that is defined, regardless if that bin
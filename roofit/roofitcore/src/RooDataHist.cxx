@@ -48,6 +48,7 @@ or RooStringVar objects, thus data can be binned in real and/or discrete dimensi
 #include "RooFormulaVar.h"
 #include "RooFormula.h"
 #include "RooUniformBinning.h"
+#include "BatchData.h"
 
 #include "TH1.h"
 #include "TTree.h"
@@ -55,6 +56,9 @@ or RooStringVar objects, thus data can be binned in real and/or discrete dimensi
 #include "TMath.h"
 #include "Math/Util.h"
 
+#include <algorithm>
+#include <cmath>
+
 using namespace std;
 
 ClassImp(RooDataHist);
@@ -1163,6 +1167,128 @@ Double_t RooDataHist::weight(const RooArgSet& bin, Int_t intOrder, Bool_t correc
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Batch version of weight() without interpolation: store in output[i] the
+/// weight of the bin enclosing the i-th of nEvents points. The k-th span of
+/// `coordinates` holds the values of the k-th element of `bin` for all points.
+/// Elements of `bin` with an empty span, and categories, are taken at their
+/// current value. Bin indices are computed one dimension at a time, using
+/// RooAbsBinning::binNumbers().
+/// \param[out] output Array of (at least) nEvents weights.
+/// \param[in] nEvents Number of points.
+/// \param[in] bin Observables of the points, as passed to weight().
+/// \param[in] coordinates Values of the elements of `bin`, each either empty or of size nEvents or more.
+/// \param[in] correctForBinSize Divide the weights by the bin volumes.
+
+void RooDataHist::weights(Double_t* output, std::size_t nEvents, const RooArgSet& bin,
+    const std::vector<RooSpan<const double>>& coordinates, Bool_t correctForBinSize)
+{
+  checkInit() ;
+  _vars.assignValueOnly(bin) ;
+
+  std::vector<Int_t> idx(nEvents, 0) ;
+  Int_t constIdx(0) ;
+  for (unsigned int i=0; i < _lvvars.size(); ++i) {
+    const RooAbsBinning* binning = _lvbins[i] ;
+    const Int_t k = bin.index(bin.find(*_vars[i])) ;
+    if (binning && k >= 0 && static_cast<std::size_t>(k) < coordinates.size() && !coordinates[k].empty()
+        && dynamic_cast<const RooRealVar*>(_vars[i])) {
+      assert(coordinates[k].size() >= nEvents) ;
+      binning->binNumbers(coordinates[k].data(), idx.data(), nEvents, _idxMult[i]) ;
+    } else {
+      constIdx += _idxMult[i] * _lvvars[i]->getBin(binning) ;
+    }
+  }
+
+  if (correctForBinSize) {
+    for (std::size_t j = 0; j < nEvents; ++j) {
+      const Int_t ibin = constIdx + idx[j] ;
+      output[j] = get_wgt(ibin) / _binv[ibin] ;
+    }
+  } else {
+    for (std::size_t j = 0; j < nEvents; ++j) {
+      output[j] = get_wgt(constIdx + idx[j]) ;
+    }
+  }
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Batch evaluation of a function looking up this histogram without
+/// interpolation, as RooHistFunc and RooHistPdf do. The i-th element of `obs`
+/// is mapped onto the i-th histogram observable in `histObs`. Observables that
+/// provide a batch are looked up with weights(); the others are transferred
+/// to the histogram observables at their current value. Events outside of the
+/// range of a histogram observable get a zero weight.
+/// \param[in,out] batchData Batch storage of the calling function, receiving the weights.
+/// \param[in] begin First event of the batch.
+/// \param[in] batchSize Maximal number of events.
+/// \param[in] histObs Observables of this histogram.
+/// \param[in] obs Observables of the function, mapped onto `histObs`.
+/// \param[in] correctForBinSize Divide the weights by the bin volumes.
+/// \return The weights, or an empty span if none of the observables provides a batch.
+
+RooSpan<double> RooDataHist::weightBatch(BatchHelpers::BatchData& batchData, std::size_t begin, std::size_t batchSize,
+    const RooArgSet& histObs, const RooArgSet& obs, Bool_t correctForBinSize)
+{
+  // Collect the observables that come in batches, transfer the others as in RooHistFunc::evaluate()
+  std::vector<RooSpan<const double>> coordinates(histObs.size()) ;
+  std::size_t nEvents = batchSize ;
+  bool haveBatch = false ;
+  bool inRange = true ;
+  for (unsigned int i=0; i < histObs.size(); ++i) {
+    RooAbsArg* harg = histObs[i] ;
+    RooAbsArg* parg = obs[i] ;
+
+    auto preal = dynamic_cast<const RooAbsReal*>(parg) ;
+    if (preal && dynamic_cast<const RooRealVar*>(harg)) {
+      coordinates[i] = preal->getValBatch(begin, batchSize) ;
+    }
+
+    if (!coordinates[i].empty()) {
+      nEvents = std::min(nEvents, coordinates[i].size()) ;
+      haveBatch = true ;
+    } else if (harg != parg) {
+      parg->syncCache() ;
+      harg->copyCache(parg,kTRUE) ;
+      inRange &= harg->inRange(0) ;
+    }
+  }
+
+  if (!haveBatch) {
+    return {} ;
+  }
+
+  auto output = batchData.makeWritableBatchUnInit(begin, nEvents) ;
+  if (!inRange) {
+    std::fill(output.begin(), output.end(), 0.) ;
+    return output ;
+  }
+
+  weights(output.data(), nEvents, histObs, coordinates, correctForBinSize) ;
+
+  for (unsigned int i=0; i < histObs.size(); ++i) {
+    if (coordinates[i].empty() || histObs[i] == obs[i]) continue ;
+
+    const auto hreal = static_cast<const RooRealVar*>(histObs[i]) ;
+    const double xmin = hreal->getMin() ;
+    const double xmax = hreal->getMax() ;
+    const double* x = coordinates[i].data() ;
+    for (std::size_t j = 0; j < nEvents; ++j) {
+      const double epsilon = 1e-8 * std::abs(x[j]) ;
+      if (!(xmin - epsilon <= x[j] && x[j] <= xmax + epsilon)) {
+        output[j] = 0. ;
+      }
+    }
+  }
+
+  return output ;
+}
+
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the error on current weight
 
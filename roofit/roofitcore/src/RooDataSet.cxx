@@ -1372,6 +1372,48 @@ void RooDataSet::append(RooDataSet& data)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Add entries from whole columns of values, one for each variable of the
+/// dataset including the weight variable. Categories are given by their state
+/// index. This is much faster than adding the entries one by one, and requires
+/// a dataset with vector storage. See RooVectorDataStore::fillFromColumns().
+/// ~~~ {.cpp}
+/// auto xValues = dataFrame.Take<double>("x");
+/// auto yValues = dataFrame.Take<double>("y");
+/// RooDataSet data("data", "data", RooArgSet(x, y));
+/// data.fillFromColumns(RooArgList(x, y), {*xValues, *yValues});
+/// ~~~
+/// \return True in case of errors.
+
+Bool_t RooDataSet::fillFromColumns(const RooArgList& vars, const std::vector<RooSpan<const double>>& columns)
+{
+  checkInit() ;
+  auto vstore = dynamic_cast<RooVectorDataStore*>(_dstore) ;
+  if (!vstore) {
+    coutE(InputArguments) << "RooDataSet::fillFromColumns(" << GetName() << ") only datasets with vector storage can be filled from columns" << endl ;
+    return kTRUE ;
+  }
+  return vstore->fillFromColumns(vars, columns) ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Like fillFromColumns(), but take ownership of the columns. If the dataset is
+/// empty, the columns are used as storage without copying them.
+/// \return True in case of errors.
+
+Bool_t RooDataSet::adoptColumns(const RooArgList& vars, std::vector<std::vector<double>>&& columns)
+{
+  checkInit() ;
+  auto vstore = dynamic_cast<RooVectorDataStore*>(_dstore) ;
+  if (!vstore) {
+    coutE(InputArguments) << "RooDataSet::adoptColumns(" << GetName() << ") only datasets with vector storage can adopt columns" << endl ;
+    return kTRUE ;
+  }
+  return vstore->adoptColumns(vars, std::move(columns)) ;
+}
+
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Add a column with the values of the given (function) argument
@@ -73,6 +73,12 @@
 /// by calling `RooMsgService::instance().addStream(RooMsgService::INFO,Topic("Caching"))`
 /// to see these message on stdout.
 ///
+/// When the cache is refilled, only the input p.d.f. whose parameters changed is sampled and
+/// transformed again, the Fourier transform of the other input is reused. If the cache has
+/// slices, *i.e.* if other observables than the convolution observable are cached, the
+/// transformations of the slices run in parallel when implicit multi-threading is enabled
+/// (ROOT::EnableImplicitMT()).
+///
 /// Multi-dimensional convolutions are not supported at the moment.
 ///
 /// ---
@@ -129,6 +135,16 @@
 #include "RooConstVar.h"
 #include "TClass.h"
 #include "RooUniformBinning.h"
+#include "RooChangeTracker.h"
+
+#include "RConfigure.h"
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#include "TROOT.h"
+#endif
+
+#include <algorithm>
 
 using namespace std;
 
@@ -280,7 +296,7 @@ RooFFTConvPdf::PdfCacheElem* RooFFTConvPdf::createCache(const RooArgSet* nset) c
 
 RooFFTConvPdf::FFTCacheElem::FFTCacheElem(const RooFFTConvPdf& self, const RooArgSet* nsetIn) : 
   PdfCacheElem(self,nsetIn),
-  fftr2c1(0),fftr2c2(0),fftc2r(0) 
+  N(0),N2(0),zeroBin1(0)
 {
   RooAbsPdf* clonePdf1 = (RooAbsPdf*) self._pdf1.arg().cloneTree() ;
   RooAbsPdf* clonePdf2 = (RooAbsPdf*) self._pdf2.arg().cloneTree() ;
@@ -368,6 +384,15 @@ RooFFTConvPdf::FFTCacheElem::FFTCacheElem(const RooFFTConvPdf& self, const RooAr
   // and set all nodes on both pdfs to operMode AlwaysDirty
   hist()->setDirtyProp(kFALSE) ;  
   convObs->setOperMode(ADirty,kTRUE) ;
+
+  // Track the parameters of both inputs separately, so that a refill only
+  // re-samples the input whose parameters changed
+  RooArgSet* params1 = pdf1Clone->getParameters(*hist()->get()) ;
+  RooArgSet* params2 = pdf2Clone->getParameters(*hist()->get()) ;
+  pdf1Tracker = new RooChangeTracker(Form("%s_pdf1Tracker",self.GetName()),"pdf1 parameter tracker",*params1,kTRUE) ;
+  pdf2Tracker = new RooChangeTracker(Form("%s_pdf2Tracker",self.GetName()),"pdf2 parameter tracker",*params2,kTRUE) ;
+  delete params1 ;
+  delete params2 ;
 } 
 
 
@@ -390,6 +415,8 @@ RooArgList RooFFTConvPdf::FFTCacheElem::containedArgs(Action a)
 
   ret.add(*pdf1Clone) ;
   ret.add(*pdf2Clone) ;
+  ret.add(*pdf1Tracker) ;
+  ret.add(*pdf2Tracker) ;
   if (pdf1Clone->ownedComponents()) {
     ret.add(*pdf1Clone->ownedComponents()) ;
   }
@@ -405,9 +432,8 @@ RooArgList RooFFTConvPdf::FFTCacheElem::containedArgs(Action a)
 
 RooFFTConvPdf::FFTCacheElem::~FFTCacheElem() 
 { 
-  delete fftr2c1 ; 
-  delete fftr2c2 ; 
-  delete fftc2r ; 
+  delete pdf1Tracker ;
+  delete pdf2Tracker ;
 
   delete pdf1Clone ;
   delete pdf2Clone ;
@@ -421,14 +447,19 @@ RooFFTConvPdf::FFTCacheElem::~FFTCacheElem()
 
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Fill the contents of the cache the FFT convolution output
+/// Fill the contents of the cache the FFT convolution output.
+/// The inputs are sampled for all slices of the cache first. Only the input p.d.f.s whose
+/// parameters changed since the last filling are sampled again. Then, the slices are
+/// transformed and convolved, in parallel if implicit multi-threading is enabled,
+/// and finally the results are written into the cache histogram.
 
 void RooFFTConvPdf::fillCacheObject(RooAbsCachedPdf::PdfCacheElem& cache) const 
 {
+  FFTCacheElem& aux = static_cast<FFTCacheElem&>(cache) ;
   RooDataHist& cacheHist = *cache.hist() ;
   
-  ((FFTCacheElem&)cache).pdf1Clone->setOperMode(ADirty,kTRUE) ;
-  ((FFTCacheElem&)cache).pdf2Clone->setOperMode(ADirty,kTRUE) ;
+  aux.pdf1Clone->setOperMode(ADirty,kTRUE) ;
+  aux.pdf2Clone->setOperMode(ADirty,kTRUE) ;
 
   // Determine if there other observables than the convolution observable in the cache
   RooArgSet otherObs ;
@@ -439,84 +470,41 @@ void RooFFTConvPdf::fillCacheObject(RooAbsCachedPdf::PdfCacheElem& cache) const
     otherObs.remove(*histArg,kTRUE,kTRUE) ;
   } 
 
-  //cout << "RooFFTConvPdf::fillCacheObject() otherObs = " << otherObs << endl ;
-
-  // Handle trivial scenario -- no other observables
-  if (otherObs.getSize()==0) {
-    fillCacheSlice((FFTCacheElem&)cache,RooArgSet()) ;
-    return ;
-  }
-
-  // Handle cases where there are other cache slices
-  // Iterator over available slice positions and fill each
-
-  // Determine number of bins for each slice position observable
-  Int_t n = otherObs.getSize() ;
-  Int_t* binCur = new Int_t[n+1] ;
-  Int_t* binMax = new Int_t[n+1] ;
-  Int_t curObs = 0 ;
-
-  RooAbsLValue** obsLV = new RooAbsLValue*[n] ;
-  TIterator* iter = otherObs.createIterator() ;
-  RooAbsArg* arg ;
-  Int_t i(0) ;
-  while((arg=(RooAbsArg*)iter->Next())) {
+  // Determine all slice positions, given by the bin numbers of the other observables
+  std::vector<RooAbsLValue*> obsLV ;
+  std::vector<Int_t> binCur ;
+  std::vector<Int_t> binMax ;
+  for (auto arg : otherObs) {
     RooAbsLValue* lvarg = dynamic_cast<RooAbsLValue*>(arg) ;
-    obsLV[i] = lvarg ;
-    binCur[i] = 0 ;
+    obsLV.push_back(lvarg) ;
+    binCur.push_back(0) ;
     // coverity[FORWARD_NULL]
-    binMax[i] = lvarg->numBins(binningName())-1 ;    
-    i++ ;
+    binMax.push_back(lvarg->numBins(binningName())-1) ;
   }
-  delete iter ;
-
-  Bool_t loop(kTRUE) ;
-  while(loop) {
-    // Set current slice position
-    for (Int_t j=0 ; j<n ; j++) { obsLV[j]->setBin(binCur[j],binningName()) ; }
-
-//     cout << "filling slice: bin of obsLV[0] = " << obsLV[0]->getBin() << endl ;
 
-    // Fill current slice
-    fillCacheSlice((FFTCacheElem&)cache,otherObs) ;
+  std::vector<std::vector<Int_t>> sliceBins ;
+  while (true) {
+    sliceBins.push_back(binCur) ;
 
     // Determine which iterator to increment
-    while(binCur[curObs]==binMax[curObs]) {
-      
-      // Reset current iterator and consider next iterator ;
-      binCur[curObs]=0 ;      
-      curObs++ ;
-
-      // master termination condition
-      if (curObs==n) {
-	loop=kFALSE ;
-	break ;
-      }
+    std::size_t curObs = 0 ;
+    while (curObs < binCur.size() && binCur[curObs]==binMax[curObs]) {
+      // Reset current iterator and consider next iterator
+      binCur[curObs++]=0 ;
     }
 
-    // Increment current iterator
+    // master termination condition
+    if (curObs==binCur.size()) break ;
+
     binCur[curObs]++ ;
-    curObs=0 ;      
-    
   }
 
-  delete[] obsLV ;
-  delete[] binMax ;
-  delete[] binCur ;
-  
-}
-
-
-////////////////////////////////////////////////////////////////////////////////
-/// Fill a slice of cachePdf with the output of the FFT convolution calculation
-
-void RooFFTConvPdf::fillCacheSlice(FFTCacheElem& aux, const RooArgSet& slicePos) const 
-{
-  // Extract histogram that is the basis of the RooHistPdf
-  RooDataHist& cacheHist = *aux.hist() ;
+  auto setSlice = [&](std::size_t slice) {
+    for (std::size_t j=0 ; j<obsLV.size() ; j++) { obsLV[j]->setBin(sliceBins[slice][j],binningName()) ; }
+  } ;
 
-  // Sample array of input points from both pdfs 
-  // Note that returned arrays have optional buffers zones below and above range ends
+  // Sample array of input points from both pdfs, for the inputs whose parameters changed.
+  // Note that the arrays have optional buffers zones below and above range ends
   // to reduce cyclical effects and have been cyclically rotated so that bin containing
   // zero value is at position zero. Example:
   // 
@@ -524,83 +512,125 @@ void RooFFTConvPdf::fillCacheSlice(FFTCacheElem& aux, const RooArgSet& slicePos)
   //     add buffer zones:    U U -5 -4 -3 -2 -1 0 +1 +2 +3 +4 +5 O O
   //     rotate:              0 +1 +2 +3 +4 +5 O O U U -5 -4 -3 -2 -1
   //
-  // 
-
-  Int_t N,N2,binShift1,binShift2 ;
-  
-  RooRealVar* histX = (RooRealVar*) cacheHist.get()->find(_x.arg().GetName()) ;
-  if (_bufStrat==Extend) histX->setBinning(*aux.scanBinning) ;
-  Double_t* input1 = scanPdf((RooRealVar&)_x.arg(),*aux.pdf1Clone,cacheHist,slicePos,N,N2,binShift1,_shift1) ;
-  Double_t* input2 = scanPdf((RooRealVar&)_x.arg(),*aux.pdf2Clone,cacheHist,slicePos,N,N2,binShift2,_shift2) ;
-  if (_bufStrat==Extend) histX->setBinning(*aux.histBinning) ;
+  const Bool_t firstFill = aux.slices.size() != sliceBins.size() ;
+  const Bool_t redo1 = aux.pdf1Tracker->hasChanged(kTRUE) || firstFill ;
+  const Bool_t redo2 = aux.pdf2Tracker->hasChanged(kTRUE) || firstFill ;
+  aux.slices.resize(sliceBins.size()) ;
+
+  if (redo1 || redo2) {
+    RooRealVar* histX = (RooRealVar*) cacheHist.get()->find(_x.arg().GetName()) ;
+    for (std::size_t slice=0 ; slice<sliceBins.size() ; ++slice) {
+      setSlice(slice) ;
+
+      Int_t zeroBin2 ;
+      if (_bufStrat==Extend) histX->setBinning(*aux.scanBinning) ;
+      if (redo1) scanPdf((RooRealVar&)_x.arg(),*aux.pdf1Clone,cacheHist,otherObs,aux.slices[slice].input1,aux.N,aux.N2,aux.zeroBin1,_shift1) ;
+      if (redo2) scanPdf((RooRealVar&)_x.arg(),*aux.pdf2Clone,cacheHist,otherObs,aux.slices[slice].input2,aux.N,aux.N2,zeroBin2,_shift2) ;
+      if (_bufStrat==Extend) histX->setBinning(*aux.histBinning) ;
+    }
 
+    // Retrieve previously defined FFT transformation plans, one set per thread
+    std::size_t nPlans = 1 ;
+#ifdef R__USE_IMT
+    if (ROOT::IsImplicitMTEnabled() && sliceBins.size() > 1) {
+      nPlans = std::min<std::size_t>(ROOT::GetThreadPoolSize(), sliceBins.size()) ;
+    }
+#endif
+    while (aux.fftPlans.size() < nPlans) {
+      aux.fftPlans.emplace_back() ;
+      aux.fftPlans.back().r2c.reset(TVirtualFFT::FFT(1, &aux.N2, "R2CK")) ;
+      aux.fftPlans.back().c2r.reset(TVirtualFFT::FFT(1, &aux.N2, "C2RK")) ;
+    }
 
+    const Int_t totalShift = aux.zeroBin1 + (aux.N2-aux.N)/2 ;
+    auto convolveSlices = [&](unsigned int plan) {
+      for (std::size_t slice=plan ; slice<aux.slices.size() ; slice+=nPlans) {
+        convolveSlice(aux.fftPlans[plan],aux.slices[slice],aux.N,aux.N2,totalShift,redo1,redo2) ;
+      }
+    } ;
 
+#ifdef R__USE_IMT
+    if (nPlans > 1) {
+      ROOT::TThreadExecutor pool ;
+      pool.Foreach(convolveSlices, ROOT::TSeqU(nPlans)) ;
+    } else {
+      convolveSlices(0) ;
+    }
+#else
+    convolveSlices(0) ;
+#endif
+  }
 
-  // Retrieve previously defined FFT transformation plans
-  if (!aux.fftr2c1) {
-    aux.fftr2c1 = TVirtualFFT::FFT(1, &N2, "R2CK");
-    aux.fftr2c2 = TVirtualFFT::FFT(1, &N2, "R2CK");
-    aux.fftc2r  = TVirtualFFT::FFT(1, &N2, "C2RK");
+  // Store FFT result in cache
+  for (std::size_t slice=0 ; slice<sliceBins.size() ; ++slice) {
+    setSlice(slice) ;
+
+    const std::vector<Double_t>& output = aux.slices[slice].output ;
+    TIterator* iter = const_cast<RooDataHist&>(cacheHist).sliceIterator(const_cast<RooAbsReal&>(_x.arg()),otherObs) ;
+    for (Int_t i =0 ; i<aux.N ; i++) {
+      iter->Next() ;
+      cacheHist.set(output[i]) ;    
+    }
+    delete iter ;
   }
-  
-  // Real->Complex FFT Transform on p.d.f. 1 sampling
-  aux.fftr2c1->SetPoints(input1);
-  aux.fftr2c1->Transform();
+}
 
-  // Real->Complex FFT Transform on p.d.f 2 sampling
-  aux.fftr2c2->SetPoints(input2);
-  aux.fftr2c2->Transform();
+
+////////////////////////////////////////////////////////////////////////////////
+/// Convolve the sampled inputs of one slice. The Fourier transform of an input is
+/// only recomputed if it was sampled again, otherwise the stored transform is used.
+/// The output is cyclically shifted back so that the bin containing zero is in its
+/// original position.
+
+void RooFFTConvPdf::convolveSlice(FFTCacheElem::FFTPlans& plans, FFTCacheElem::SliceData& slice, Int_t N, Int_t N2, Int_t totalShift, Bool_t redo1, Bool_t redo2)
+{
+  const Int_t nComplex = N2/2+1 ;
+  auto transform = [&](const std::vector<Double_t>& input, std::vector<std::complex<Double_t>>& output) {
+    // Real->Complex FFT Transform on p.d.f. sampling
+    plans.r2c->SetPoints(input.data()) ;
+    plans.r2c->Transform() ;
+    output.resize(nComplex) ;
+    for (Int_t i=0 ; i<nComplex ; i++) {
+      Double_t re,im ;
+      plans.r2c->GetPointComplex(i,re,im) ;
+      output[i] = std::complex<Double_t>(re,im) ;
+    }
+  } ;
+
+  if (redo1) transform(slice.input1, slice.fft1) ;
+  if (redo2) transform(slice.input2, slice.fft2) ;
 
   // Loop over first half +1 of complex output results, multiply 
   // and set as input of reverse transform
-  for (Int_t i=0 ; i<N2/2+1 ; i++) {
-    Double_t re1,re2,im1,im2 ;
-    aux.fftr2c1->GetPointComplex(i,re1,im1) ;
-    aux.fftr2c2->GetPointComplex(i,re2,im2) ;
-    Double_t re = re1*re2 - im1*im2 ;
-    Double_t im = re1*im2 + re2*im1 ;
-    TComplex t(re,im) ;
-    aux.fftc2r->SetPointComplex(i,t) ;
+  for (Int_t i=0 ; i<nComplex ; i++) {
+    const Double_t re1 = slice.fft1[i].real(), im1 = slice.fft1[i].imag() ;
+    const Double_t re2 = slice.fft2[i].real(), im2 = slice.fft2[i].imag() ;
+    TComplex t(re1*re2 - im1*im2, re1*im2 + re2*im1) ;
+    plans.c2r->SetPointComplex(i,t) ;
   }
 
   // Reverse Complex->Real FFT transform product
-  aux.fftc2r->Transform() ;
-
-  Int_t totalShift = binShift1 + (N2-N)/2 ;
+  plans.c2r->Transform() ;
 
-  // Store FFT result in cache
-
-  TIterator* iter = const_cast<RooDataHist&>(cacheHist).sliceIterator(const_cast<RooAbsReal&>(_x.arg()),slicePos) ;
+  slice.output.resize(N) ;
   for (Int_t i =0 ; i<N ; i++) {
-
     // Cyclically shift array back so that bin containing zero is back in zeroBin
     Int_t j = i + totalShift ;
     while (j<0) j+= N2 ;
     while (j>=N2) j-= N2 ;
 
-    iter->Next() ;
-    cacheHist.set(aux.fftc2r->GetPointReal(j)) ;    
+    slice.output[i] = plans.c2r->GetPointReal(j) ;
   }
-  delete iter ;
-
-  // cacheHist.dump2() ;
-
-  // Delete input arrays
-  delete[] input1 ;
-  delete[] input2 ;
-
 }
 
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Scan the values of 'pdf' in observable 'obs' using the bin values stored in 'hist' at slice position 'slicePos'
 /// N is filled with the number of bins defined in hist, N2 is filled with N plus the number of buffer bins
-/// The return value is an array of doubles of length N2 with the sampled values. The caller takes ownership
-/// of the array
+/// `array` is resized to length N2 and filled with the sampled values.
 
-Double_t*  RooFFTConvPdf::scanPdf(RooRealVar& obs, RooAbsPdf& pdf, const RooDataHist& hist, const RooArgSet& slicePos, 
-				  Int_t& N, Int_t& N2, Int_t& zeroBin, Double_t shift) const
+void RooFFTConvPdf::scanPdf(RooRealVar& obs, RooAbsPdf& pdf, const RooDataHist& hist, const RooArgSet& slicePos, 
+				  std::vector<Double_t>& array, Int_t& N, Int_t& N2, Int_t& zeroBin, Double_t shift) const
 {
 
   RooRealVar* histX = (RooRealVar*) hist.get()->find(obs.GetName()) ;
@@ -611,8 +641,8 @@ Double_t*  RooFFTConvPdf::scanPdf(RooRealVar& obs, RooAbsPdf& pdf, const RooData
   N2 = N+2*Nbuf ;
 
   
-  // Allocate array of sampling size plus optional buffer zones
-  Double_t* array = new Double_t[N2] ;
+  // Array of sampling size plus optional buffer zones
+  array.resize(N2) ;
   
   // Set position of non-convolution observable to that of the cache slice that were are processing now
   hist.get(slicePos) ;
@@ -636,7 +666,7 @@ Double_t*  RooFFTConvPdf::scanPdf(RooRealVar& obs, RooAbsPdf& pdf, const RooData
   while(zeroBin<0) zeroBin+= N2 ;
 
   // First scan hist into temp array 
-  Double_t *tmp = new Double_t[N2] ;
+  std::vector<Double_t> tmp(N2) ;
   Int_t k(0) ;
   switch(_bufStrat) {
 
@@ -693,10 +723,6 @@ Double_t*  RooFFTConvPdf::scanPdf(RooRealVar& obs, RooAbsPdf& pdf, const RooData
     if (j>=N2) j-= N2 ;
     array[i] = tmp[j] ;
   }  
-
-  // Cleanup 
-  delete[] tmp ;
-  return array ;
 }
 
 
@@ -884,6 +910,9 @@ void RooFFTConvPdf::setBufferFraction(Double_t frac)
 void RooFFTConvPdf::setBufferStrategy(BufStrat bs) 
 {
   _bufStrat = bs ;
+
+  // Sterilize the cache as the stored samplings of the inputs depend on the buffer strategy
+  _cacheMgr.sterilize() ;
 }
 
 
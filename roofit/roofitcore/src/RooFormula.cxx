@@ -60,10 +60,13 @@ Check the tutorial rf506_msgservice.C for details.
 #include "RooAbsCategory.h"
 #include "RooArgList.h"
 #include "RooMsgService.h"
+#include "BatchHelpers.h"
 #include "ROOT/RMakeUnique.hxx"
 #include "TObjString.h"
 #include "TClass.h"
 
+#include <algorithm>
+#include <limits>
 #include <sstream>
 #include <regex>
 
@@ -363,6 +366,58 @@ Double_t RooFormula::eval(const RooArgSet* nset) const
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the formula for a batch of events, with TFormula::EvalParBatch().
+/// Arguments that are not available in batches enter as constants.
+/// \param[in] dataOwner Object whose batch storage receives the results.
+/// \param[in] begin First event of the batch.
+/// \param[in] batchSize Maximal number of events.
+/// \param[in] nset Normalisation set passed to the arguments.
+/// \return The results, or an empty span if no argument is available in batches
+/// or if the formula depends on categories, which cannot be read in batches.
+RooSpan<double> RooFormula::evaluateBatch(const RooAbsReal* dataOwner, std::size_t begin, std::size_t batchSize,
+    const RooArgSet* nset) const
+{
+  if (!_tFormula) {
+    coutF(Eval) << __func__ << " (" << GetName() << "): Formula didn't compile: " << GetTitle() << endl;
+    std::string what = "Formula ";
+    what += GetTitle();
+    what += " didn't compile.";
+    throw std::runtime_error(what);
+  }
+
+  if (std::any_of(_isCategory.begin(), _isCategory.end(), [](bool isCat){ return isCat; }))
+    return {};
+
+  // TFormula only reads the variables up to the highest one in use
+  const std::size_t nVars = std::min(_origList.size(), static_cast<std::size_t>(std::max(_tFormula->GetNdim(), 0)));
+  std::vector<RooSpan<const double>> batches(nVars);
+  for (std::size_t i = 0; i < nVars; ++i) {
+    batches[i] = static_cast<const RooAbsReal&>(_origList[i]).getValBatch(begin, batchSize, nset);
+  }
+
+  const std::size_t n = BatchHelpers::findSize(batches);
+  if (n == std::numeric_limits<std::size_t>::max())
+    return {};
+
+  // Variables are stored one after the other, as EvalParBatch expects them
+  std::vector<double> xs(nVars * n);
+  for (std::size_t i = 0; i < nVars; ++i) {
+    double* x = xs.data() + i * n;
+    if (batches[i].empty()) {
+      std::fill(x, x + n, static_cast<const RooAbsReal&>(_origList[i]).getVal(nset));
+    } else {
+      std::copy(batches[i].begin(), batches[i].begin() + n, x);
+    }
+  }
+
+  auto output = dataOwner->_batchData.makeWritableBatchUnInit(begin, n);
+  _tFormula->EvalParBatch(n, xs.data(), output.data());
+
+  return output;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Printing interface
 
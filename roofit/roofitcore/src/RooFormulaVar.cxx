@@ -54,6 +54,9 @@
 #include "RooChi2Var.h"
 #include "RooMsgService.h"
 #include "RooTrace.h"
+#include "RooAbsCategory.h"
+
+#include <algorithm>
 
 
 using namespace std;
@@ -151,6 +154,22 @@ Double_t RooFormulaVar::evaluate() const
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the formula for a batch of events. Formulas depending on
+/// categories are evaluated event by event.
+
+RooSpan<double> RooFormulaVar::evaluateBatch(std::size_t begin, std::size_t batchSize) const
+{
+  auto output = formula().evaluateBatch(this, begin, batchSize, _lastNSet);
+  if (output.empty() && std::any_of(_actualVars.begin(), _actualVars.end(),
+                                    [](const RooAbsArg* arg) { return dynamic_cast<const RooAbsCategory*>(arg); })) {
+    return RooAbsReal::evaluateBatch(begin, batchSize);
+  }
+
+  return output;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Propagate server change information to embedded RooFormula object
 
@@ -199,6 +199,21 @@ Double_t RooHistFunc::evaluate() const
   return ret ;
 }
 
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the values of the bins enclosing a batch of events. Without
+/// interpolation, the bins are looked up with RooDataHist::weightBatch(). If
+/// interpolation is requested, the events are evaluated one by one.
+
+RooSpan<double> RooHistFunc::evaluateBatch(std::size_t begin, std::size_t batchSize) const
+{
+  if (_intOrder != 0 || _depList.getSize() == 0) {
+    return RooAbsReal::evaluateBatch(begin, batchSize);
+  }
+
+  return _dataHist->weightBatch(_batchData, begin, batchSize, _histObsList, _depList, kFALSE);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Only handle case of maximum in all variables
 
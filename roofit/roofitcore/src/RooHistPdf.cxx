@@ -230,6 +230,27 @@ Double_t RooHistPdf::evaluate() const
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the values of the bins enclosing a batch of events. Without
+/// interpolation, the bins are looked up with RooDataHist::weightBatch(). If
+/// interpolation is requested, the events are evaluated one by one.
+
+RooSpan<double> RooHistPdf::evaluateBatch(std::size_t begin, std::size_t batchSize) const
+{
+  if (_intOrder != 0) {
+    return RooAbsPdf::evaluateBatch(begin, batchSize);
+  }
+
+  auto output = _dataHist->weightBatch(_batchData, begin, batchSize, _histObsList, _pdfObsList, !_unitNorm);
+
+  for (std::size_t j = 0; j < output.size(); ++j) { //CHECK_VECTORISE
+    output[j] = output[j] < 0. ? 0. : output[j];
+  }
+
+  return output;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the total volume spanned by the observables of the RooHistPdf
 
@@ -38,6 +38,8 @@ numerical integration algorithm.
 #include "RooMsgService.h"
 
 #include <assert.h>
+#include <algorithm>
+#include <vector>
 
 
 
@@ -398,11 +400,19 @@ Double_t RooIntegrator1D::addTrapezoids(Int_t n)
     const double del = _range/nInt;
     const double xmin = _xmin;
 
+    // evaluate all interior points together, the function binding may do so in parallel
+    const UInt_t dim = _function->getDimension();
+    std::vector<double> points(nInt*dim);
+    std::vector<double> values(nInt);
+    for (int j=0; j<nInt; ++j) {
+      points[j*dim] = xmin + (0.5+j)*del;
+      std::copy(_x+1, _x+dim, points.begin()+j*dim+1);
+    }
+    _function->getValues(points.data(), values.data(), nInt);
+
     double sum = 0.;
-    // TODO Replace by batch computation
     for (int j=0; j<nInt; ++j) {
-      double x = xmin + (0.5+j)*del;
-      sum += integrand(xvec(x));
+      sum += values[j];
     }
 
     return (_savedResult= 0.5*(_savedResult + _range*sum/nInt));
@@ -40,6 +40,8 @@ based on a C version from the 0.9 beta release of the GNU scientific library.
 #include "RooMsgService.h"
 
 #include <math.h>
+#include <algorithm>
+#include <vector>
 
 
 
@@ -263,8 +265,17 @@ Double_t RooMCIntegrator::vegas(Stage stage, UInt_t calls, UInt_t iterations, Do
 
   // allocate memory for some book-keeping arrays
   UInt_t *box= _grid.createIndexVector();
-  UInt_t *bin= _grid.createIndexVector();
-  Double_t *x= _grid.createPoint();
+  const UInt_t dim(_grid.getDimension());
+
+  // The points of several boxes are generated in advance, such that the
+  // integrand can evaluate them together (possibly in parallel). Generation
+  // and accumulation happen in the same order as if each point was evaluated
+  // right after its generation, so the result does not depend on this.
+  const UInt_t boxesPerBlock = std::max<UInt_t>(1, 4096/_calls_per_box);
+  std::vector<Double_t> points(boxesPerBlock*_calls_per_box*dim);
+  std::vector<UInt_t> bins(boxesPerBlock*_calls_per_box*dim);
+  std::vector<Double_t> binVolumes(boxesPerBlock*_calls_per_box);
+  std::vector<Double_t> values(boxesPerBlock*_calls_per_box);
 
   // loop over iterations for this step
   Double_t cum_int(0),cum_sig(0);
@@ -278,30 +289,46 @@ Double_t RooMCIntegrator::vegas(Stage stage, UInt_t calls, UInt_t iterations, Do
     // reset the values associated with each grid cell
     _grid.resetValues();
 
-    // loop over grid boxes
+    // loop over blocks of grid boxes
     _grid.firstBox(box);
-    do {
-      Double_t m(0),q(0);
-      // loop over integrand evaluations within this grid box
-      for(UInt_t k = 0; k < _calls_per_box; k++) {
-        // generate a random point in this box
-        Double_t bin_vol(0);
-        _grid.generatePoint(box, x, bin, bin_vol, _genType == QuasiRandom ? kTRUE : kFALSE);
-        // evaluate the integrand at the generated point
-        Double_t fval= jacbin*bin_vol*integrand(x);
-        // update mean and variance calculations
-        Double_t d = fval - m;
-        m+= d / (k + 1.0);
-        q+= d * d * (k / (k + 1.0));
-        // accumulate the results of this evaluation (importance sampling only)
-        if (_mode != Stratified) _grid.accumulate(bin, fval*fval);
-      }
-      intgrl += m * _calls_per_box;
-      Double_t f_sq_sum = q * _calls_per_box ;
-      sig += f_sq_sum ;
+    Bool_t moreBoxes(kTRUE);
+    while (moreBoxes) {
+      // generate random points in the boxes of this block
+      UInt_t nBoxes(0), nPoints(0);
+      do {
+        for(UInt_t k = 0; k < _calls_per_box; k++, nPoints++) {
+          _grid.generatePoint(box, &points[nPoints*dim], &bins[nPoints*dim], binVolumes[nPoints],
+                              _genType == QuasiRandom ? kTRUE : kFALSE);
+        }
+        nBoxes++;
+        moreBoxes = _grid.nextBox(box);
+      } while (moreBoxes && nBoxes < boxesPerBlock);
+
+      // evaluate the integrand at the generated points
+      integrand()->getValues(points.data(), values.data(), nPoints);
+
+      for (UInt_t b = 0; b < nBoxes; b++) {
+        Double_t m(0),q(0);
+        UInt_t *bin(0);
+        // loop over integrand evaluations within this grid box
+        for(UInt_t k = 0; k < _calls_per_box; k++) {
+          const UInt_t i = b*_calls_per_box + k;
+          bin = &bins[i*dim];
+          Double_t fval= jacbin*binVolumes[i]*values[i];
+          // update mean and variance calculations
+          Double_t d = fval - m;
+          m+= d / (k + 1.0);
+          q+= d * d * (k / (k + 1.0));
+          // accumulate the results of this evaluation (importance sampling only)
+          if (_mode != Stratified) _grid.accumulate(bin, fval*fval);
+        }
+        intgrl += m * _calls_per_box;
+        Double_t f_sq_sum = q * _calls_per_box ;
+        sig += f_sq_sum ;
 
-      // accumulate the results for this grid box (stratified sampling only)      
-      if (_mode == Stratified) _grid.accumulate(bin, f_sq_sum);
+        // accumulate the results for this grid box (stratified sampling only)      
+        if (_mode == Stratified) _grid.accumulate(bin, f_sq_sum);
+      }
 
       // print occasional progress messages
       if(_timer.RealTime() > 30) {
@@ -320,7 +347,7 @@ Double_t RooMCIntegrator::vegas(Stage stage, UInt_t calls, UInt_t iterations, Do
         _timer.Start(kFALSE);
       }
 
-    } while(_grid.nextBox(box));
+    }
 
     // compute final results for this iteration
     Double_t wgt;
@@ -366,9 +393,7 @@ Double_t RooMCIntegrator::vegas(Stage stage, UInt_t calls, UInt_t iterations, Do
   }
 
   // cleanup
-  delete[] bin;
   delete[] box;
-  delete[] x;
 
   if(absError) *absError = cum_sig;
   return cum_int;
@@ -34,6 +34,17 @@ are resynchronized with the output state of MINUIT: changes
 parameter values, errors are propagated.
 Various methods are available to control verbosity, profiling,
 automatic PDF optimization.
+
+With setParallelGradient(), MINUIT is given the gradient of the function
+instead of calculating it itself. The points of the finite-difference
+gradient are then evaluated concurrently on clones of the function, using
+ROOT's implicit multi-threading:
+~~~ {.cpp}
+ROOT::EnableImplicitMT(4);
+RooMinimizer m(*nll);
+m.setParallelGradient(4);
+m.migrad();
+~~~
 **/
 
 #ifndef __ROOFIT_NOROOMINIMIZER
@@ -67,6 +78,8 @@ automatic PDF optimization.
 #include "RooFitResult.h"
 
 #include "Math/Minimizer.h"
+#include "Math/IFunction.h"
+#include "TROOT.h"
 
 #if (__GNUC__==3&&__GNUC_MINOR__==2&&__GNUC_PATCHLEVEL__==3)
 char* operator+( streampos&, char* );
@@ -79,6 +92,32 @@ ClassImp(RooMinimizer);
 
 ROOT::Fit::Fitter *RooMinimizer::_theFitter = 0 ;
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Gradient function that forwards to a RooMinimizerFcn, for fits with
+/// RooMinimizer::setParallelGradient(). The Fitter works on a clone of the
+/// function it is given. All clones of this class refer to the same
+/// RooMinimizerFcn, so that its evaluation counter and the clones for the
+/// gradient are shared between fits.
+
+class RooMinimizerGradFcn : public ROOT::Math::IMultiGradFunction {
+public:
+  RooMinimizerGradFcn(RooMinimizerFcn* fcn) : _fcn(fcn) {}
+
+  ROOT::Math::IMultiGradFunction* Clone() const override { return new RooMinimizerGradFcn(_fcn) ; }
+  unsigned int NDim() const override { return _fcn->NDim() ; }
+  void Gradient(const double *x, double *grad) const override { _fcn->Gradient(x, grad) ; }
+
+private:
+  double DoEval(const double *x) const override { return (*_fcn)(x) ; }
+  double DoDerivative(const double *x, unsigned int icoord) const override { return _fcn->Derivative(x, icoord) ; }
+
+  RooMinimizerFcn* _fcn ;
+} ;
+
+}
+
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -239,6 +278,41 @@ void RooMinimizer::setOffsetting(Bool_t flag)
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Let MINUIT use a finite-difference gradient whose points are evaluated by
+/// nWorkers clones of the function in parallel threads. This requires
+/// implicit multi-threading to be enabled with ROOT::EnableImplicitMT(),
+/// otherwise the points are evaluated one by one. Each clone holds a full copy
+/// of the function, including the data of a likelihood, so this is best used
+/// instead of, not in addition to, the NumCPU() option of the likelihood.
+/// nWorkers <= 1 returns to the gradient calculation of MINUIT.
+
+void RooMinimizer::setParallelGradient(Int_t nWorkers)
+{
+  _fcn->SetParallelGradient(nWorkers) ;
+  if (nWorkers > 1 && !ROOT::IsImplicitMTEnabled()) {
+    coutW(Minimization) << "RooMinimizer::setParallelGradient: implicit multi-threading is not enabled,"
+                        << " the gradient will be evaluated serially. Call ROOT::EnableImplicitMT() to"
+                        << " evaluate it in parallel." << endl ;
+  }
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Run the configured minimizer on the function. With parallel gradient
+/// evaluation, the fitter is given a gradient function that forwards to _fcn.
+
+bool RooMinimizer::fitFcn()
+{
+  if (_fcn->GetParallelGradient() > 1) {
+    return _theFitter->FitFCN(RooMinimizerGradFcn(_fcn)) ;
+  }
+  return _theFitter->FitFCN(*_fcn) ;
+}
+
+
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Choose the minimiser algorithm.
@@ -321,7 +395,7 @@ Int_t RooMinimizer::minimize(const char* type, const char* alg)
   RooAbsReal::setEvalErrorLoggingMode(RooAbsReal::CollectErrors) ;
   RooAbsReal::clearEvalErrorLog() ;
 
-  bool ret = _theFitter->FitFCN(*_fcn);
+  bool ret = fitFcn();
   _status = ((ret) ? _theFitter->Result().Status() : -1);
 
   RooAbsReal::setEvalErrorLoggingMode(RooAbsReal::PrintErrors) ;
@@ -350,7 +424,7 @@ Int_t RooMinimizer::migrad()
   RooAbsReal::clearEvalErrorLog() ;
 
   _theFitter->Config().SetMinimizer(_minimizerType.c_str(),"migrad");
-  bool ret = _theFitter->FitFCN(*_fcn);
+  bool ret = fitFcn();
   _status = ((ret) ? _theFitter->Result().Status() : -1);
 
   RooAbsReal::setEvalErrorLoggingMode(RooAbsReal::PrintErrors) ;
@@ -513,7 +587,7 @@ Int_t RooMinimizer::seek()
   RooAbsReal::clearEvalErrorLog() ;
 
   _theFitter->Config().SetMinimizer(_minimizerType.c_str(),"seek");
-  bool ret = _theFitter->FitFCN(*_fcn);
+  bool ret = fitFcn();
   _status = ((ret) ? _theFitter->Result().Status() : -1);
 
   RooAbsReal::setEvalErrorLoggingMode(RooAbsReal::PrintErrors) ;
@@ -542,7 +616,7 @@ Int_t RooMinimizer::simplex()
   RooAbsReal::clearEvalErrorLog() ;
 
   _theFitter->Config().SetMinimizer(_minimizerType.c_str(),"simplex");
-  bool ret = _theFitter->FitFCN(*_fcn);
+  bool ret = fitFcn();
   _status = ((ret) ? _theFitter->Result().Status() : -1);
 
   RooAbsReal::setEvalErrorLoggingMode(RooAbsReal::PrintErrors) ;
@@ -571,7 +645,7 @@ Int_t RooMinimizer::improve()
   RooAbsReal::clearEvalErrorLog() ;
 
   _theFitter->Config().SetMinimizer(_minimizerType.c_str(),"migradimproved");
-  bool ret = _theFitter->FitFCN(*_fcn);
+  bool ret = fitFcn();
   _status = ((ret) ? _theFitter->Result().Status() : -1);
 
   RooAbsReal::setEvalErrorLoggingMode(RooAbsReal::PrintErrors) ;
@@ -17,6 +17,11 @@
 //
 // RooMinimizerFcn is am interface class to the ROOT::Math function 
 // for minization.
+//
+// With SetParallelGradient(n), it can also compute the gradient of the
+// function from central finite differences. The displaced points are then
+// evaluated on n clones of the function, concurrently if ROOT's implicit
+// multi-threading is enabled.
 //                                                                                   
 
 #include <iostream>
@@ -34,10 +39,24 @@
 #include "RooArgSet.h"
 #include "RooRealVar.h"
 #include "RooAbsRealLValue.h"
+#include "RooAbsCategoryLValue.h"
 #include "RooMsgService.h"
 
 #include "RooMinimizer.h"
 
+#include "RConfigure.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#include "TROOT.h"
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+
 using namespace std;
 
 RooMinimizerFcn::RooMinimizerFcn(RooAbsReal *funct, RooMinimizer* context,
@@ -47,7 +66,9 @@ RooMinimizerFcn::RooMinimizerFcn(RooAbsReal *funct, RooMinimizer* context,
   _maxFCN(-1e30), _numBadNLL(0),  
   _printEvalErrors(10), _doEvalErrorWall(kTRUE),
   _nDim(0), _logfile(0),
-  _verbose(verbose)
+  _verbose(verbose),
+  _nGradWorkers(1), _optConst(kFALSE),
+  _gradSerialEval(kTRUE)
 { 
 
   _evalCounter = 0 ;
@@ -105,7 +126,10 @@ RooMinimizerFcn::RooMinimizerFcn(const RooMinimizerFcn& other) : ROOT::Math::IBa
   _nDim(other._nDim),
   _logfile(other._logfile),
   _verbose(other._verbose),
-  _floatParamVec(other._floatParamVec)
+  _floatParamVec(other._floatParamVec),
+  _nGradWorkers(other._nGradWorkers),
+  _optConst(other._optConst),
+  _gradSerialEval(kTRUE)
 {  
   _floatParamList = new RooArgList(*other._floatParamList) ;
   _constParamList = new RooArgList(*other._constParamList) ;
@@ -116,6 +140,7 @@ RooMinimizerFcn::RooMinimizerFcn(const RooMinimizerFcn& other) : ROOT::Math::IBa
 
 RooMinimizerFcn::~RooMinimizerFcn()
 {
+  clearGradientClones();
   delete _floatParamList;
   delete _initFloatParamList;
   delete _constParamList;
@@ -370,6 +395,11 @@ Bool_t RooMinimizerFcn::Synchronize(std::vector<ROOT::Fit::ParameterSettings>& p
 
   }
 
+  // Clones for the gradient are recreated for each minimization, as the function
+  // may have new data or a new parameter configuration since the last one
+  _optConst = optConst ;
+  clearGradientClones() ;
+
   updateFloatVec() ;
 
   return 0 ;  
@@ -579,5 +609,249 @@ double RooMinimizerFcn::DoEval(const double *x) const
   return fvalue;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Set the number of clones of the function that evaluate the gradient, see
+/// Gradient(). The clones are created on the first gradient calculation.
+
+void RooMinimizerFcn::SetParallelGradient(Int_t nWorkers)
+{
+  _nGradWorkers = std::max(nWorkers, 1) ;
+  clearGradientClones() ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Calculate the gradient at x from central finite differences, see evalDerivatives().
+
+void RooMinimizerFcn::Gradient(const double *x, double *grad) const
+{
+  std::vector<Int_t> coords(_nDim) ;
+  for (Int_t i = 0; i < _nDim; ++i) coords[i] = i ;
+
+  const std::vector<double> derivs = evalDerivatives(x, coords) ;
+  std::copy(derivs.begin(), derivs.end(), grad) ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Calculate the derivative at x with respect to the parameter with index icoord
+/// from central finite differences, see evalDerivatives().
+
+double RooMinimizerFcn::Derivative(const double *x, unsigned int icoord) const
+{
+  return evalDerivatives(x, std::vector<Int_t>(1, icoord))[0] ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Calculate the derivatives at x with respect to the parameters with the given
+/// indices from central finite differences. Each floating parameter is displaced
+/// down and up by a step proportional to its value or error; a displaced point
+/// beyond the limits of the parameter is moved onto the limit. With more than one
+/// gradient worker and implicit multi-threading enabled, the displaced points are
+/// evaluated concurrently on clones of the function. Otherwise, or if an evaluation
+/// on the clones reports errors, the points are evaluated one after another with
+/// DoEval(), which applies the evaluation error wall.
+/// \return The derivatives in the order of coords. Constant parameters have zero derivative.
+
+std::vector<double> RooMinimizerFcn::evalDerivatives(const double *x, const std::vector<Int_t>& coords) const
+{
+  std::vector<Int_t> pars ;
+  std::vector<double> lo(_nDim), hi(_nDim) ;
+  const double relStep = std::cbrt(std::numeric_limits<double>::epsilon()) ;
+  for (const Int_t i : coords) {
+    auto par = static_cast<const RooRealVar*>(_floatParamVec[i]) ;
+    if (par->isConstant()) continue ;
+
+    double scale = std::max(std::abs(x[i]), par->getError()) ;
+    if (scale <= 0.) scale = 1. ;
+    lo[i] = std::max(x[i] - relStep*scale, par->getMin()) ;
+    hi[i] = std::min(x[i] + relStep*scale, par->getMax()) ;
+    if (hi[i] > lo[i]) {
+      pars.push_back(i) ;
+    }
+  }
+
+  // Function values at lo and hi for each entry of pars
+  std::vector<double> values(2*pars.size()) ;
+  if (!evalGradientPointsMT(x, pars, lo, hi, values)) {
+    std::vector<double> point(x, x+_nDim) ;
+    for (std::size_t k = 0; k < pars.size(); ++k) {
+      const Int_t i = pars[k] ;
+      point[i] = lo[i] ;
+      values[2*k] = DoEval(point.data()) ;
+      point[i] = hi[i] ;
+      values[2*k+1] = DoEval(point.data()) ;
+      point[i] = x[i] ;
+    }
+  }
+
+  std::vector<double> grad(_nDim, 0.) ;
+  for (std::size_t k = 0; k < pars.size(); ++k) {
+    const Int_t i = pars[k] ;
+    grad[i] = (values[2*k+1] - values[2*k]) / (hi[i] - lo[i]) ;
+  }
+
+  std::vector<double> derivs ;
+  derivs.reserve(coords.size()) ;
+  for (const Int_t i : coords) {
+    derivs.push_back(grad[i]) ;
+  }
+  return derivs ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the displaced points of evalDerivatives() on the clones of the function,
+/// in parallel threads. The parameters are distributed over the clones in a fixed
+/// pattern, and both displaced points of a parameter are evaluated by the same clone,
+/// so the result doesn't depend on thread scheduling.
+/// Evaluation errors are counted by each clone in the thread that evaluates it,
+/// while the global error log is not written.
+/// \return kFALSE if the points were not evaluated, because parallel evaluation
+/// is off or unavailable, or because an evaluation reported an error.
+
+Bool_t RooMinimizerFcn::evalGradientPointsMT(const double *x, const std::vector<Int_t>& pars, const std::vector<double>& lo,
+                                             const std::vector<double>& hi, std::vector<double>& values) const
+{
+#ifdef R__USE_IMT
+  if (_nGradWorkers < 2 || !ROOT::IsImplicitMTEnabled()) {
+    return kFALSE ;
+  }
+
+  if (_gradClones.empty()) {
+    initGradientClones() ;
+  }
+
+  // Bring the clones to x and to the values of the constant parameters
+  for (std::size_t w = 0; w < _gradClones.size(); ++w) {
+    const std::vector<RooAbsArg*>& params = _gradCloneParams[w] ;
+    for (Int_t i = 0; i < _nDim; ++i) {
+      if (!params[i]) return kFALSE ;
+      static_cast<RooRealVar*>(params[i])->setVal(x[i]) ;
+    }
+    for (Int_t j = 0; j < _constParamList->getSize(); ++j) {
+      const RooAbsArg* var = _constParamList->at(j) ;
+      RooAbsArg* copy = params[_nDim+j] ;
+      auto realVar = dynamic_cast<const RooAbsRealLValue*>(var) ;
+      auto catVar = dynamic_cast<const RooAbsCategoryLValue*>(var) ;
+      if (realVar && copy) {
+        auto realCopy = static_cast<RooAbsRealLValue*>(copy) ;
+        if (realCopy->getVal() != realVar->getVal()) realCopy->setVal(realVar->getVal()) ;
+      } else if (catVar && copy) {
+        auto catCopy = static_cast<RooAbsCategoryLValue*>(copy) ;
+        if (catCopy->getIndex() != catVar->getIndex()) catCopy->setIndex(catVar->getIndex()) ;
+      }
+    }
+    if (_gradClones[w]->isOffsetting() != _funct->isOffsetting()) {
+      _gradClones[w]->enableOffsetting(_funct->isOffsetting()) ;
+    }
+  }
+
+  const unsigned int nWorkers = _gradClones.size() ;
+  const std::size_t nPoints = values.size() ;
+  std::vector<Int_t> nErrors(nWorkers, 0) ;
+  auto evalPoints = [&](unsigned int w) {
+    RooAbsReal::clearEvalErrorsInThread() ;
+    const std::vector<RooAbsArg*>& params = _gradCloneParams[w] ;
+    // Both points of a parameter are evaluated by the same clone
+    for (std::size_t p = w; p < pars.size(); p += nWorkers) {
+      const Int_t i = pars[p] ;
+      auto par = static_cast<RooRealVar*>(params[i]) ;
+      par->setVal(lo[i]) ;
+      values[2*p] = _gradClones[w]->getVal() ;
+      par->setVal(hi[i]) ;
+      values[2*p+1] = _gradClones[w]->getVal() ;
+      par->setVal(x[i]) ;
+    }
+    nErrors[w] = RooAbsReal::numEvalErrorsInThread() ;
+  } ;
+
+  // Points with errors are evaluated again with DoEval(), which logs the errors
+  const RooAbsReal::ErrorLoggingMode logMode = RooAbsReal::evalErrorLoggingMode() ;
+  RooAbsReal::setEvalErrorLoggingMode(RooAbsReal::Ignore) ;
+  RooAbsReal::setHideOffset(kFALSE) ;
+  if (_gradSerialEval) {
+    // The first evaluations of new clones may still create caches and
+    // normalization integrals, which is not thread safe
+    for (unsigned int w = 0; w < nWorkers; ++w) evalPoints(w) ;
+    _gradSerialEval = kFALSE ;
+  } else {
+    ROOT::TThreadExecutor pool ;
+    pool.Foreach(evalPoints, ROOT::TSeqU(nWorkers)) ;
+  }
+  RooAbsReal::setHideOffset(kTRUE) ;
+  RooAbsReal::setEvalErrorLoggingMode(logMode) ;
+  _evalCounter += nPoints ;
+
+  Bool_t ok = kTRUE ;
+  for (Int_t n : nErrors) {
+    if (n > 0) ok = kFALSE ;
+  }
+  for (double value : values) {
+    if (!std::isfinite(value) || value > 1e30) ok = kFALSE ;
+  }
+  return ok ;
+#else
+  (void)x; (void)pars; (void)lo; (void)hi; (void)values;
+  return kFALSE ;
 #endif
+}
+
 
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create the clones of the function for the gradient workers. Each clone has
+/// its own copy of the whole expression tree, including the parameters and,
+/// for test statistics, the data.
+
+void RooMinimizerFcn::initGradientClones() const
+{
+  clearGradientClones() ;
+
+  for (Int_t w = 0; w < _nGradWorkers; ++w) {
+    auto clone = static_cast<RooAbsReal*>(_funct->cloneTree()) ;
+    std::unique_ptr<RooArgSet> cloneParams(clone->getParameters(RooArgSet())) ;
+
+    // Components of a test statistic may only be created on the first evaluation,
+    // connected to the original parameters. Move them to the parameters of the clone.
+    clone->getVal() ;
+    clone->recursiveRedirectServers(*cloneParams) ;
+    if (_optConst) {
+      clone->constOptimizeTestStatistic(RooAbsArg::Activate) ;
+    }
+
+    std::vector<RooAbsArg*> params ;
+    for (const auto par : _floatParamVec) {
+      params.push_back(cloneParams->find(par->GetName())) ;
+    }
+    for (const auto par : *_constParamList) {
+      params.push_back(cloneParams->find(par->GetName())) ;
+    }
+
+    _gradClones.push_back(clone) ;
+    _gradCloneParams.push_back(params) ;
+  }
+
+  _gradSerialEval = kTRUE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Delete the clones of the function for the gradient workers.
+
+void RooMinimizerFcn::clearGradientClones() const
+{
+  for (auto clone : _gradClones) {
+    delete clone ;
+  }
+  _gradClones.clear() ;
+  _gradCloneParams.clear() ;
+}
+
+#endif
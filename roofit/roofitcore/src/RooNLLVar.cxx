@@ -235,6 +235,10 @@ void RooNLLVar::applyWeightSquared(Bool_t flag)
   } else if ( _gofOpMode==MPMaster) {
     for (Int_t i=0 ; i<_nCPU ; i++)
       _mpfeArray[i]->applyNLLWeightSquared(flag);
+  } else if ( _gofOpMode==MTMaster) {
+    for (Int_t i=0 ; i<_nCPU ; i++)
+      ((RooNLLVar*)_mtArray[i])->applyWeightSquared(flag);
+    setValueDirty();
   } else if ( _gofOpMode==SimMaster) {
     for (Int_t i=0 ; i<_nGof ; i++)
       ((RooNLLVar*)_gofArray[i])->applyWeightSquared(flag);
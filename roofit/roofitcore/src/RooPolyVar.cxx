@@ -26,11 +26,14 @@ Class RooPolyvar implements analytical integrals of all polynomials
 it can define.
 **/
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 #include "RooPolyVar.h"
 #include "RooArgList.h"
 #include "RooMsgService.h"
+#include "BatchHelpers.h"
 //#include "Riostream.h"
 
 #include "TError.h"
@@ -140,6 +143,62 @@ Double_t RooPolyVar::evaluate() const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the polynomial in batches, with the same Horner scheme as evaluate().
+/// Coefficients may be batches, too.
+
+RooSpan<double> RooPolyVar::evaluateBatch(std::size_t begin, std::size_t batchSize) const
+{
+  const RooArgSet* nset = _coefList.nset();
+  std::vector<RooSpan<const double>> batches;
+  batches.reserve(_coefList.size() + 1);
+  batches.push_back(_x.getValBatch(begin, batchSize));
+  for (const auto arg : _coefList) {
+    batches.push_back(static_cast<const RooAbsReal*>(arg)->getValBatch(begin, batchSize, nset));
+  }
+
+  const std::size_t n = BatchHelpers::findSize(batches);
+  if (n == std::numeric_limits<std::size_t>::max()) {
+    return {};
+  }
+
+  auto output = _batchData.makeWritableBatchUnInit(begin, n);
+  const unsigned sz = _coefList.getSize();
+  const int lowestOrder = _lowestOrder;
+  if (!sz) {
+    std::fill(output.begin(), output.end(), lowestOrder ? 1. : 0.);
+    return output;
+  }
+
+  std::vector<BatchHelpers::BracketAdapterWithMask> coefs;
+  coefs.reserve(sz);
+  for (unsigned i = 0; i < sz; ++i) {
+    const auto& coef = static_cast<const RooAbsReal&>(_coefList[i]);
+    coefs.emplace_back(coef.getVal(nset), batches[i + 1]);
+  }
+  const Double_t xVal = _x;
+  const BatchHelpers::BracketAdapterWithMask x(xVal, batches[0]);
+
+  for (std::size_t j = 0; j < n; ++j) { //CHECK_VECTORISE
+    output[j] = coefs[sz - 1][j];
+  }
+  for (unsigned i = sz - 1; i--; ) {
+    const auto& coef = coefs[i];
+    for (std::size_t j = 0; j < n; ++j) { //CHECK_VECTORISE
+      output[j] = coef[j] + x[j] * output[j];
+    }
+  }
+  if (lowestOrder) {
+    for (std::size_t j = 0; j < n; ++j) {
+      output[j] *= std::pow(x[j], lowestOrder);
+    }
+  }
+
+  return output;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Advertise that we can internally integrate over x
 
@@ -26,6 +26,8 @@ A RooProduct represents the product of a given set of RooAbsReal objects.
 
 #include <cmath>
 #include <memory>
+#include <limits>
+#include <vector>
 
 #include "RooProduct.h"
 #include "RooNameReg.h"
@@ -34,6 +36,7 @@ A RooProduct represents the product of a given set of RooAbsReal objects.
 #include "RooErrorHandler.h"
 #include "RooMsgService.h"
 #include "RooTrace.h"
+#include "BatchHelpers.h"
 
 using namespace std ;
 
@@ -379,6 +382,52 @@ Double_t RooProduct::evaluate() const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the product in batches. Factors that do not depend on the
+/// observables of the batch, and the categories, are multiplied as constants.
+
+RooSpan<double> RooProduct::evaluateBatch(std::size_t begin, std::size_t batchSize) const
+{
+  const RooArgSet* nset = _compRSet.nset() ;
+
+  std::vector<RooSpan<const double>> batches;
+  batches.reserve(_compRSet.size());
+  for (const auto item : _compRSet) {
+    batches.push_back(static_cast<const RooAbsReal*>(item)->getValBatch(begin, batchSize, nset));
+  }
+
+  const std::size_t n = BatchHelpers::findSize(batches);
+  if (n == std::numeric_limits<std::size_t>::max()) {
+    return {};
+  }
+
+  auto output = _batchData.makeWritableBatchInit(begin, n, 1.);
+  for (std::size_t k = 0; k < batches.size(); ++k) {
+    const auto& batch = batches[k];
+    if (batch.empty()) {
+      const double val = static_cast<const RooAbsReal&>(_compRSet[k]).getVal(nset);
+      for (std::size_t i = 0; i < n; ++i) { //CHECK_VECTORISE
+        output[i] *= val;
+      }
+    } else {
+      for (std::size_t i = 0; i < n; ++i) { //CHECK_VECTORISE
+        output[i] *= batch[i];
+      }
+    }
+  }
+
+  for (const auto item : _compCSet) {
+    const double val = static_cast<const RooAbsCategory*>(item)->getCurrentIndex();
+    for (std::size_t i = 0; i < n; ++i) { //CHECK_VECTORISE
+      output[i] *= val;
+    }
+  }
+
+  return output;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Forward the plot sampling hint from the p.d.f. that defines the observable obs  
 
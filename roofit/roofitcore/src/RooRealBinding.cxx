@@ -33,7 +33,16 @@ of its servers and present it as a simple array oriented interface.
 #include "RooAbsRealLValue.h"
 #include "RooNameReg.h"
 #include "RooMsgService.h"
+#include "RooAbsCategoryLValue.h"
 
+#include "RConfigure.h"
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#include "TROOT.h"
+#endif
+
+#include <algorithm>
 #include <assert.h>
 
 
@@ -44,6 +53,18 @@ ClassImp(RooRealBinding);
 ;
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Copy of the bound function with its own servers, such that it can be
+/// evaluated in another thread than the original.
+
+struct RooRealBinding::ThreadCopy {
+  std::unique_ptr<RooAbsReal> func;  // Owning clone of the expression tree of the function
+  RooArgSet nset;                    // Normalization set with the observables of func
+  std::unique_ptr<RooRealBinding> binding; // Binding of func to its copies of the variables
+  std::vector<std::pair<const RooAbsArg*,RooAbsArg*>> leaves; // Leaves of the original and of func, other than the variables
+};
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Construct a lightweight function binding of RooAbsReal func to
 /// variables 'vars'.  Use the provided nset as normalization set to
@@ -55,7 +76,8 @@ ClassImp(RooRealBinding);
 /// range.
 
 RooRealBinding::RooRealBinding(const RooAbsReal& func, const RooArgSet &vars, const RooArgSet* nset, Bool_t clipInvalid, const TNamed* rangeName) :
-  RooAbsFunc(vars.getSize()), _func(&func), _vars(0), _nset(nset), _clipInvalid(clipInvalid), _xsave(0), _rangeName(rangeName), _funcSave(0)
+  RooAbsFunc(vars.getSize()), _func(&func), _vars(0), _nset(nset), _clipInvalid(clipInvalid), _xsave(0), _rangeName(rangeName), _funcSave(0),
+  _threadCopyFailed(kFALSE)
 {
   // allocate memory
   _vars= new RooAbsRealLValue*[getDimension()];
@@ -92,7 +114,8 @@ RooRealBinding::RooRealBinding(const RooAbsReal& func, const RooArgSet &vars, co
 
 RooRealBinding::RooRealBinding(const RooRealBinding& other, const RooArgSet* nset) :
   RooAbsFunc(other), _func(other._func), _nset(nset?nset:other._nset), _xvecValid(other._xvecValid),
-  _clipInvalid(other._clipInvalid), _xsave(0), _rangeName(other._rangeName), _funcSave(other._funcSave)
+  _clipInvalid(other._clipInvalid), _xsave(0), _rangeName(other._rangeName), _funcSave(other._funcSave),
+  _threadCopyFailed(kFALSE)
 {
   // allocate memory
   _vars= new RooAbsRealLValue*[getDimension()];
@@ -205,6 +228,131 @@ Double_t RooRealBinding::operator()(const Double_t xvector[]) const
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the bound RooAbsReal at nPoints points, see RooAbsFunc::getValues().
+/// If ROOT's implicit multi-threading is enabled, the points are split in
+/// contiguous ranges that are evaluated in parallel, each by its own copy of
+/// the function. The values are the same as if the points were evaluated
+/// one by one, but the variables of the original function are not modified.
+
+void RooRealBinding::getValues(const Double_t* xvectors, Double_t* values, std::size_t nPoints) const
+{
+#ifdef R__USE_IMT
+  // Function copies evaluating points in a thread do so sequentially
+  static thread_local Bool_t inThreadCopy = kFALSE ;
+  constexpr std::size_t minPointsPerThread = 64 ;
+
+  if (!inThreadCopy && !_threadCopyFailed && ROOT::IsImplicitMTEnabled() && nPoints >= 2 * minPointsPerThread) {
+    const std::size_t nChunks = std::min<std::size_t>(ROOT::GetThreadPoolSize(), nPoints / minPointsPerThread) ;
+
+    // Copying and the first evaluation create RooFit objects, which can only be done in one thread
+    while (!_threadCopyFailed && _threadCopies.size() < nChunks) {
+      auto copy = makeThreadCopy() ;
+      if (copy) {
+        (*copy->binding)(xvectors) ;
+        _threadCopies.push_back(std::move(copy)) ;
+      } else {
+        _threadCopyFailed = kTRUE ;
+      }
+    }
+
+    if (!_threadCopyFailed && nChunks > 1) {
+      for (std::size_t i = 0; i < nChunks; ++i) {
+        syncThreadCopy(*_threadCopies[i]) ;
+      }
+
+      auto evalChunk = [&](unsigned int chunk) {
+        inThreadCopy = kTRUE ;
+        const RooRealBinding& binding = *_threadCopies[chunk]->binding ;
+        const std::size_t begin = nPoints * chunk / nChunks ;
+        const std::size_t end = nPoints * (chunk + 1) / nChunks ;
+        for (std::size_t i = begin; i < end; ++i) {
+          values[i] = binding(xvectors + i * _dimension) ;
+        }
+        inThreadCopy = kFALSE ;
+      } ;
+
+      ROOT::TThreadExecutor pool ;
+      pool.Foreach(evalChunk, ROOT::TSeqU(nChunks)) ;
+      _ncall += nPoints ;
+      return ;
+    }
+  }
+#endif
+
+  RooAbsFunc::getValues(xvectors, values, nPoints) ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create a copy of the bound function and of all its servers, bound to the
+/// copies of the variables of this binding. Return null if the variables
+/// cannot be found in the copy.
+
+std::unique_ptr<RooRealBinding::ThreadCopy> RooRealBinding::makeThreadCopy() const
+{
+  std::unique_ptr<ThreadCopy> copy(new ThreadCopy) ;
+  copy->func.reset(static_cast<RooAbsReal*>(_func->cloneTree())) ;
+
+  RooArgSet nodes ;
+  copy->func->treeNodeServerList(&nodes) ;
+
+  RooArgSet vars ;
+  for (UInt_t i = 0; i < getDimension(); ++i) {
+    auto var = dynamic_cast<RooAbsRealLValue*>(nodes.find(_vars[i]->GetName())) ;
+    if (!var || !vars.add(*var)) {
+      return nullptr ;
+    }
+  }
+
+  if (_nset) {
+    for (const auto arg : *_nset) {
+      RooAbsArg* node = nodes.find(arg->GetName()) ;
+      copy->nset.add(node ? *node : *arg) ;
+    }
+  }
+
+  RooArgSet leaves ;
+  _func->leafNodeServerList(&leaves) ;
+  for (const auto leaf : leaves) {
+    if (vars.find(leaf->GetName())) continue ;
+    RooAbsArg* node = nodes.find(leaf->GetName()) ;
+    if (node) {
+      copy->leaves.emplace_back(leaf, node) ;
+    }
+  }
+
+  copy->binding.reset(new RooRealBinding(*copy->func, vars, _nset ? &copy->nset : nullptr, _clipInvalid, _rangeName)) ;
+  if (!copy->binding->isValid()) {
+    return nullptr ;
+  }
+
+  return copy ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy the values and constant flags of the leaves of the bound function,
+/// other than the bound variables, to the leaves of the given copy.
+
+void RooRealBinding::syncThreadCopy(const ThreadCopy& copy) const
+{
+  for (const auto& leaf : copy.leaves) {
+    if (leaf.first->isConstant() != leaf.second->isConstant()) {
+      leaf.second->setAttribute("Constant", leaf.first->isConstant()) ;
+      leaf.second->setValueDirty() ;
+    }
+    if (leaf.second->isIdentical(*leaf.first, kTRUE)) continue ;
+
+    if (auto real = dynamic_cast<RooAbsRealLValue*>(leaf.second)) {
+      real->setVal(static_cast<const RooAbsReal*>(leaf.first)->getVal()) ;
+    } else if (auto cat = dynamic_cast<RooAbsCategoryLValue*>(leaf.second)) {
+      cat->setIndex(static_cast<const RooAbsCategory*>(leaf.first)->getCurrentIndex()) ;
+    }
+  }
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return lower limit on i-th variable 
 
@@ -60,9 +60,12 @@ to the fractions of the various functions. **This requires setting the last argu
 #include "RooRealIntegral.h"
 #include "RooMsgService.h"
 #include "RooNameReg.h"
+#include "BatchHelpers.h"
 
 #include <algorithm>
 #include <memory>
+#include <limits>
+#include <vector>
 
 using namespace std;
 
@@ -285,6 +288,76 @@ Double_t RooRealSumPdf::evaluate() const
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Calculate the values of a batch of events. The coefficients cannot depend
+/// on the observables (see checkObservables()), so they are evaluated once
+/// per batch, as in evaluate(). The functions are evaluated in batches.
+
+RooSpan<double> RooRealSumPdf::evaluateBatch(std::size_t begin, std::size_t batchSize) const
+{
+  // Selected functions and their coefficients, in the order of evaluate()
+  std::vector<std::pair<const RooAbsReal*, double>> terms;
+  Double_t lastCoef(1) ;
+  auto funcIt = _funcList.begin();
+  for (const auto coefArg : _coefList) {
+    assert(funcIt != _funcList.end());
+    auto func = static_cast<const RooAbsReal*>(*funcIt++);
+    auto coef = static_cast<const RooAbsReal*>(coefArg);
+
+    const Double_t coefVal = coef->getVal() ;
+    if (coefVal) {
+      if (func->isSelectedComp()) {
+        terms.emplace_back(func, coefVal);
+      }
+      lastCoef -= coefVal ;
+    }
+  }
+
+  if (!haveLastCoef()) {
+    assert(funcIt != _funcList.end());
+    auto func = static_cast<const RooAbsReal*>(*funcIt);
+    if (func->isSelectedComp()) {
+      terms.emplace_back(func, lastCoef);
+    }
+
+    if (lastCoef<0 || lastCoef>1) {
+      coutW(Eval) << "RooRealSumPdf::evaluateBatch(" << GetName() 
+		  << ") WARNING: sum of FUNC coefficients not in range [0-1], value=" 
+		  << 1-lastCoef << ". This means that the PDF is not properly normalised. If the PDF was meant to be extended, provide as many coefficients as functions." << endl ;
+    }
+  }
+
+  std::vector<RooSpan<const double>> batches;
+  batches.reserve(terms.size());
+  for (const auto& term : terms) {
+    batches.push_back(term.first->getValBatch(begin, batchSize));
+  }
+
+  const std::size_t n = BatchHelpers::findSize(batches);
+  if (n == std::numeric_limits<std::size_t>::max()) {
+    return {};
+  }
+
+  auto output = _batchData.makeWritableBatchInit(begin, n, 0.);
+  for (std::size_t k = 0; k < terms.size(); ++k) {
+    const double coef = terms[k].second;
+    const BatchHelpers::BracketAdapterWithMask func(terms[k].first->getVal(), batches[k]);
+    for (std::size_t i = 0; i < n; ++i) { //CHECK_VECTORISE
+      output[i] += func[i] * coef;
+    }
+  }
+
+  // Introduce floor if so requested
+  if (_doFloor || _doFloorGlobal) {
+    for (std::size_t i = 0; i < n; ++i) { //CHECK_VECTORISE
+      output[i] = output[i] < 0. ? 0. : output[i];
+    }
+  }
+
+  return output;
+}
+
+
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -970,6 +970,10 @@ void RooVectorDataStore::reserve(Int_t nEvts)
 
 void RooVectorDataStore::append(RooAbsDataStore& other) 
 {
+  // Copy whole columns if the other store has the same layout
+  auto otherVec = dynamic_cast<RooVectorDataStore*>(&other) ;
+  if (otherVec && appendColumnsFrom(*otherVec)) return ;
+
   Int_t nevt = other.numEntries() ;
   reserve(nevt + numEntries());
   for (int i=0 ; i<nevt ; i++) {  
@@ -984,6 +988,241 @@ void RooVectorDataStore::append(RooAbsDataStore& other)
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Append the entries of another vector store column by column. This is only done if
+/// both stores hold the same value and category columns, no errors are stored, and
+/// the other store is not weighted by an external array or a different weight variable.
+/// \return False if the layouts don't match and nothing was appended.
+
+Bool_t RooVectorDataStore::appendColumnsFrom(const RooVectorDataStore& other)
+{
+  if (_cache || !_realfStoreList.empty() || !other._realfStoreList.empty() || other._extWgtArray) return kFALSE ;
+  if (_realStoreList.size() != other._realStoreList.size() || _catStoreList.size() != other._catStoreList.size()) return kFALSE ;
+  if (_wgtVar && (!other._wgtVar || _wgtVar->namePtr() != other._wgtVar->namePtr())) return kFALSE ;
+  if (!_wgtVar && other._wgtVar) return kFALSE ;
+
+  std::vector<const RealVector*> realSources ;
+  for (auto realVec : _realStoreList) {
+    auto match = std::find_if(other._realStoreList.begin(), other._realStoreList.end(), [realVec](const RealVector* otherVec) {
+      return otherVec->bufArg()->namePtr() == realVec->bufArg()->namePtr() ;
+    }) ;
+    if (match == other._realStoreList.end()) return kFALSE ;
+    realSources.push_back(*match) ;
+  }
+
+  std::vector<const CatVector*> catSources ;
+  for (auto catVec : _catStoreList) {
+    auto match = std::find_if(other._catStoreList.begin(), other._catStoreList.end(), [catVec](const CatVector* otherVec) {
+      return otherVec->bufArg()->namePtr() == catVec->bufArg()->namePtr() ;
+    }) ;
+    if (match == other._catStoreList.end()) return kFALSE ;
+    catSources.push_back(*match) ;
+  }
+
+  const std::size_t firstEntry = size() ;
+  for (std::size_t i=0 ; i < _realStoreList.size() ; ++i) {
+    auto& vec = _realStoreList[i]->_vec ;
+    vec.insert(vec.end(), realSources[i]->_vec.begin(), realSources[i]->_vec.end()) ;
+  }
+  for (std::size_t i=0 ; i < _catStoreList.size() ; ++i) {
+    auto& vec = _catStoreList[i]->_vec ;
+    vec.insert(vec.end(), catSources[i]->_vec.begin(), catSources[i]->_vec.end()) ;
+  }
+  addToSumWeight(firstEntry) ;
+
+  return kTRUE ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Find the position in `vars` of every column of this store, ordered as the
+/// real, full real and category columns. All columns need to be given, and every
+/// element of `vars` must be a column of this store.
+/// \return The positions, or an empty vector in case of errors.
+
+std::vector<std::size_t> RooVectorDataStore::columnPositions(const RooArgList& vars, std::size_t nColumns, const char* caller) const
+{
+  if (std::size_t(vars.getSize()) != nColumns) {
+    coutE(InputArguments) << "RooVectorDataStore::" << caller << "(" << GetName() << ") " << vars.getSize()
+                          << " variables were given for " << nColumns << " columns" << endl ;
+    return {} ;
+  }
+  if (_cache) {
+    coutE(InputArguments) << "RooVectorDataStore::" << caller << "(" << GetName()
+                          << ") cannot add entries while a cache is attached" << endl ;
+    return {} ;
+  }
+
+  std::vector<std::size_t> positions ;
+  std::vector<bool> used(nColumns, false) ;
+  auto findPosition = [&](const RooAbsArg* arg) {
+    const std::size_t pos = vars.index(arg->GetName()) ;
+    if (pos >= nColumns) {
+      coutE(InputArguments) << "RooVectorDataStore::" << caller << "(" << GetName() << ") no column given for "
+                            << arg->GetName() << endl ;
+      return false ;
+    }
+    positions.push_back(pos) ;
+    used[pos] = true ;
+    return true ;
+  } ;
+
+  for (auto realVec : _realStoreList) {
+    if (!findPosition(realVec->bufArg())) return {} ;
+  }
+  for (auto fullVec : _realfStoreList) {
+    if (!findPosition(fullVec->bufArg())) return {} ;
+  }
+  for (auto catVec : _catStoreList) {
+    if (!findPosition(catVec->bufArg())) return {} ;
+  }
+
+  for (std::size_t i=0 ; i < nColumns ; ++i) {
+    if (!used[i]) {
+      coutE(InputArguments) << "RooVectorDataStore::" << caller << "(" << GetName() << ") " << vars[i].GetName()
+                            << " is not a column of this store" << endl ;
+      return {} ;
+    }
+  }
+
+  return positions ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add entries to this store from whole columns, e.g. arrays that were read with
+/// RDataFrame or that come from numpy. Each column is copied in one go, which is
+/// much faster than setting the variables and calling fill() for every entry.
+/// \param[in] vars The variables that the columns belong to. All variables of the store,
+/// including the weight variable, need to be given.
+/// \param[in] columns One column of values for each variable in `vars`. All need to have
+/// the same length. Categories are given by their state index.
+/// Errors of variables that store errors are set to the current errors of the variables.
+/// \return True in case of errors.
+
+Bool_t RooVectorDataStore::fillFromColumns(const RooArgList& vars, const std::vector<RooSpan<const double>>& columns)
+{
+  const std::vector<std::size_t> positions = columnPositions(vars, columns.size(), "fillFromColumns") ;
+  if (positions.empty()) return kTRUE ;
+
+  const std::size_t nEntries = columns.front().size() ;
+  for (std::size_t i=0 ; i < columns.size() ; ++i) {
+    if (columns[i].size() != nEntries) {
+      coutE(InputArguments) << "RooVectorDataStore::fillFromColumns(" << GetName() << ") column of " << vars[i].GetName()
+                            << " has " << columns[i].size() << " entries instead of " << nEntries << endl ;
+      return kTRUE ;
+    }
+  }
+
+  const std::size_t firstEntry = size() ;
+  auto pos = positions.begin() ;
+  for (auto realVec : _realStoreList) {
+    const auto& column = columns[*pos++] ;
+    realVec->_vec.insert(realVec->_vec.end(), column.begin(), column.end()) ;
+  }
+  for (auto fullVec : _realfStoreList) {
+    const auto& column = columns[*pos++] ;
+    fullVec->_vec.insert(fullVec->_vec.end(), column.begin(), column.end()) ;
+  }
+  for (auto catVec : _catStoreList) {
+    const auto& column = columns[*pos++] ;
+    catVec->_vec.reserve(catVec->_vec.size() + nEntries) ;
+    for (double index : column) {
+      catVec->_vec.push_back(static_cast<RooAbsCategory::value_type>(index)) ;
+    }
+  }
+  padErrorColumns() ;
+  addToSumWeight(firstEntry) ;
+
+  return kFALSE ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Like fillFromColumns(), but take ownership of the columns. If the store is empty,
+/// the columns of real-valued variables are moved into the store without copying,
+/// so a vector that e.g. was returned by RDataFrame's Take() is used as it is.
+/// \return True in case of errors. In that case, the columns are left untouched.
+
+Bool_t RooVectorDataStore::adoptColumns(const RooArgList& vars, std::vector<std::vector<double>>&& columns)
+{
+  if (size() != 0) {
+    std::vector<RooSpan<const double>> spans(columns.begin(), columns.end()) ;
+    return fillFromColumns(vars, spans) ;
+  }
+
+  const std::vector<std::size_t> positions = columnPositions(vars, columns.size(), "adoptColumns") ;
+  if (positions.empty()) return kTRUE ;
+
+  const std::size_t nEntries = columns.front().size() ;
+  for (std::size_t i=0 ; i < columns.size() ; ++i) {
+    if (columns[i].size() != nEntries) {
+      coutE(InputArguments) << "RooVectorDataStore::adoptColumns(" << GetName() << ") column of " << vars[i].GetName()
+                            << " has " << columns[i].size() << " entries instead of " << nEntries << endl ;
+      return kTRUE ;
+    }
+  }
+
+  auto pos = positions.begin() ;
+  for (auto realVec : _realStoreList) {
+    realVec->_vec = std::move(columns[*pos++]) ;
+  }
+  for (auto fullVec : _realfStoreList) {
+    fullVec->_vec = std::move(columns[*pos++]) ;
+  }
+  for (auto catVec : _catStoreList) {
+    const auto& column = columns[*pos++] ;
+    catVec->_vec.assign(column.begin(), column.end()) ;
+  }
+  padErrorColumns() ;
+  addToSumWeight(0) ;
+
+  return kFALSE ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Bring the error columns of full real vectors to the length of their value
+/// columns, using the current errors of the variables.
+
+void RooVectorDataStore::padErrorColumns()
+{
+  for (auto fullVec : _realfStoreList) {
+    const std::size_t n = fullVec->_vec.size() ;
+    if (fullVec->_vecE) fullVec->_vecE->resize(n, *fullVec->_bufE) ;
+    if (fullVec->_vecEL) fullVec->_vecEL->resize(n, *fullVec->_bufEL) ;
+    if (fullVec->_vecEH) fullVec->_vecEH->resize(n, *fullVec->_bufEH) ;
+  }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the weights of all entries starting at `firstEntry` to the sum of weights,
+/// in the same way as fill() does.
+
+void RooVectorDataStore::addToSumWeight(std::size_t firstEntry)
+{
+  const std::vector<double>* weights = nullptr ;
+  if (_wgtVar) {
+    for (auto realVec : _realStoreList) {
+      if (realVec->bufArg()->namePtr() == _wgtVar->namePtr()) weights = &realVec->_vec ;
+    }
+    for (auto fullVec : _realfStoreList) {
+      if (fullVec->bufArg()->namePtr() == _wgtVar->namePtr()) weights = &fullVec->_vec ;
+    }
+  }
+
+  // use Kahan's algorithm to sum up weights to avoid loss of precision
+  const std::size_t nEntries = size() ;
+  for (std::size_t i=firstEntry ; i < nEntries ; ++i) {
+    Double_t y = (weights ? (*weights)[i] : 1.) - _sumWeightCarry;
+    Double_t t = _sumWeight + y;
+    _sumWeightCarry = (t - _sumWeight) - y;
+    _sumWeight = t;
+  }
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 
 void RooVectorDataStore::reset() 
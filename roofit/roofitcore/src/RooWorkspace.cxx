@@ -43,6 +43,23 @@ instructions. When suspecting to have run out of stack memory, check
 ulimit -s
 ```
 and try reading again.
+
+### Indexed workspaces
+A workspace written with writeToFile() or TObject::Write() is streamed as a single object,
+so opening it reads every component and dataset. For large workspaces of which a job only
+needs a small part, writeIndexedToFile() stores each component and dataset under its own key
+in a directory named after the workspace. A workspace opened from there with openIndexed()
+initially only holds the named sets, snapshots, generic objects and class code. Components
+and datasets are read when they are first requested by name, e.g. through `pdf()`, `function()`
+or `data()`, together with the components they depend on:
+```
+w.writeIndexedToFile("ws.root");
+...
+std::unique_ptr<RooWorkspace> w2(RooWorkspace::openIndexed("ws.root", "w"));
+RooAbsPdf* model = w2->pdf("model_channel1"); // Reads only this channel
+```
+Accessors that list the full content, like components(), allPdfs() or Print(), load
+everything that is left in the file.
 **/
 
 #include "RooWorkspace.h"
@@ -52,6 +69,7 @@ and try reading again.
 #include "RooAbsPdf.h"
 #include "RooRealVar.h"
 #include "RooCategory.h"
+#include "RooProdPdf.h"
 #include "RooAbsData.h"
 #include "RooCmdConfig.h"
 #include "RooMsgService.h"
@@ -71,6 +89,7 @@ and try reading again.
 #include "RooAbsOptTestStatistic.h"
 #include "TROOT.h"
 #include "TFile.h"
+#include "TKey.h"
 #include "TH1.h"
 #include "TClass.h"
 #include "strlcpy.h"
@@ -78,6 +97,7 @@ and try reading again.
 #include <map>
 #include <sstream>
 #include <string>
+#include <vector>
 #include <iostream>
 #include <fstream>
 #include <cstring>
@@ -179,6 +199,8 @@ RooWorkspace::RooWorkspace(const char* name, Bool_t doCINTExport)  :
 RooWorkspace::RooWorkspace(const RooWorkspace& other) :
   TNamed(other), _uuid(other._uuid), _classes(other._classes,this), _dir(nullptr), _factory(nullptr), _doExport(kFALSE), _openTrans(kFALSE)
 {
+  other.loadAllIndexed() ;
+
   // Copy owned nodes
   other._allOwnedNodes.snapshot(_allOwnedNodes,kTRUE) ;
 
@@ -452,7 +474,7 @@ Bool_t RooWorkspace::import(const RooAbsArg& inArg,
   }
 
   // Scan for overlaps with current contents
-  RooAbsArg* wsarg = _allOwnedNodes.find(inArg.GetName()) ;
+  RooAbsArg* wsarg = arg(inArg.GetName()) ;
 
   // Check for factory specification match
   const char* tagIn = inArg.getStringAttribute("factory_tag") ;
@@ -489,7 +511,7 @@ Bool_t RooWorkspace::import(const RooAbsArg& inArg,
   }
 
   for (const auto branch : branchSet) {
-    RooAbsArg* wsbranch = _allOwnedNodes.find(branch->GetName()) ;
+    RooAbsArg* wsbranch = arg(branch->GetName()) ;
     if (wsbranch && wsbranch!=branch && !branch->getAttribute("RooWorkspace::Recycle") && !useExistingNodes) {
       conflictNodes.add(*branch) ;
     }
@@ -547,21 +569,21 @@ Bool_t RooWorkspace::import(const RooAbsArg& inArg,
     for (const auto cnode : conflictNodes) {
 
       string origName = cnode->GetName() ;
-      RooAbsArg* wsnode = _allOwnedNodes.find(origName.c_str()) ;
+      RooAbsArg* wsnode = arg(origName.c_str()) ;
       if (wsnode) {
 
         if (!wsnode->getStringAttribute("origName")) {
           wsnode->setStringAttribute("origName",wsnode->GetName()) ;
         }
 
-        if (!_allOwnedNodes.find(Form("%s_%s",cnode->GetName(),suffix))) {
+        if (!arg(Form("%s_%s",cnode->GetName(),suffix))) {
           wsnode->SetName(Form("%s_%s",cnode->GetName(),suffix)) ;
           wsnode->SetTitle(Form("%s (%s)",cnode->GetTitle(),suffix)) ;
         } else {
           // Name with suffix already taken, add additional suffix
           for (unsigned int n=1; true; ++n) {
             string newname = Form("%s_%s_%d",cnode->GetName(),suffix,n) ;
-            if (!_allOwnedNodes.find(newname.c_str())) {
+            if (!arg(newname.c_str())) {
               wsnode->SetName(newname.c_str()) ;
               wsnode->SetTitle(Form("%s (%s %d)",cnode->GetTitle(),suffix,n)) ;
               break ;
@@ -620,7 +642,7 @@ Bool_t RooWorkspace::import(const RooAbsArg& inArg,
   RooArgSet conflictNodes2 ;
   RooArgSet branchSet2 ;
   for (const auto branch2 : branchSet2) {
-    if (_allOwnedNodes.find(branch2->GetName())) {
+    if (arg(branch2->GetName())) {
       conflictNodes2.add(*branch2) ;
     }
   }
@@ -657,7 +679,7 @@ Bool_t RooWorkspace::import(const RooAbsArg& inArg,
     _eocache.importCacheObjects(oldCache,node->GetName(),kTRUE) ;
 
     // Check if node is already in workspace (can only happen for variables or identical instances, unless RecycleConflictNodes is specified)
-    RooAbsArg* wsnode = _allOwnedNodes.find(node->GetName()) ;
+    RooAbsArg* wsnode = arg(node->GetName()) ;
 
     if (wsnode) {
       // Do not import node, add not to list of nodes that require reconnection
@@ -666,7 +688,7 @@ Bool_t RooWorkspace::import(const RooAbsArg& inArg,
 			          << "::" << node->GetName() << " for import of " << cloneTop2->IsA()->GetName() << "::"
 			          << cloneTop2->GetName() << endl ;
       }
-      recycledNodes.add(*_allOwnedNodes.find(node->GetName())) ;
+      recycledNodes.add(*arg(node->GetName())) ;
 
       // Delete clone of incoming node
       nodesToBeDeleted.addOwned(*node) ;
@@ -1176,6 +1198,13 @@ Bool_t RooWorkspace::saveSnapshot(const char* name, const char* paramNames)
 
 Bool_t RooWorkspace::saveSnapshot(const char* name, const RooArgSet& params, Bool_t importValues)
 {
+  if (_indexDir) {
+    // Parameters that are still in the file would otherwise be missing from the snapshot
+    for (const auto param : params) {
+      arg(param->GetName()) ;
+    }
+  }
+
   RooArgSet* actualParams = (RooArgSet*) _allOwnedNodes.selectCommon(params) ;
   RooArgSet* snapshot = (RooArgSet*) actualParams->snapshot() ;
   delete actualParams ;
@@ -1213,6 +1242,13 @@ Bool_t RooWorkspace::loadSnapshot(const char* name)
     return kFALSE ;
   }
 
+  if (_indexDir) {
+    // Parameters that are still in the file would otherwise miss the snapshot values
+    for (const auto snapArg : *snap) {
+      arg(snapArg->GetName()) ;
+    }
+  }
+
   RooArgSet* actualParams = (RooArgSet*) _allOwnedNodes.selectCommon(*snap) ;
   *actualParams = *snap ;
   delete actualParams ;
@@ -1276,7 +1312,7 @@ const RooArgSet* RooWorkspace::getSnapshot(const char* name) const
 
 RooAbsPdf* RooWorkspace::pdf(const char* name) const
 {
-  return dynamic_cast<RooAbsPdf*>(_allOwnedNodes.find(name)) ;
+  return dynamic_cast<RooAbsPdf*>(arg(name)) ;
 }
 
 
@@ -1285,7 +1321,7 @@ RooAbsPdf* RooWorkspace::pdf(const char* name) const
 
 RooAbsReal* RooWorkspace::function(const char* name) const
 {
-  return dynamic_cast<RooAbsReal*>(_allOwnedNodes.find(name)) ;
+  return dynamic_cast<RooAbsReal*>(arg(name)) ;
 }
 
 
@@ -1294,7 +1330,7 @@ RooAbsReal* RooWorkspace::function(const char* name) const
 
 RooRealVar* RooWorkspace::var(const char* name) const
 {
-  return dynamic_cast<RooRealVar*>(_allOwnedNodes.find(name)) ;
+  return dynamic_cast<RooRealVar*>(arg(name)) ;
 }
 
 
@@ -1303,7 +1339,7 @@ RooRealVar* RooWorkspace::var(const char* name) const
 
 RooCategory* RooWorkspace::cat(const char* name) const
 {
-  return dynamic_cast<RooCategory*>(_allOwnedNodes.find(name)) ;
+  return dynamic_cast<RooCategory*>(arg(name)) ;
 }
 
 
@@ -1312,7 +1348,7 @@ RooCategory* RooWorkspace::cat(const char* name) const
 
 RooAbsCategory* RooWorkspace::catfunc(const char* name) const
 {
-  return dynamic_cast<RooAbsCategory*>(_allOwnedNodes.find(name)) ;
+  return dynamic_cast<RooAbsCategory*>(arg(name)) ;
 }
 
 
@@ -1322,7 +1358,11 @@ RooAbsCategory* RooWorkspace::catfunc(const char* name) const
 
 RooAbsArg* RooWorkspace::arg(const char* name) const
 {
-  return _allOwnedNodes.find(name) ;
+  RooAbsArg* ret = _allOwnedNodes.find(name) ;
+  if (!ret && _indexDir) {
+    ret = loadIndexedArg(name) ;
+  }
+  return ret ;
 }
 
 
@@ -1367,7 +1407,11 @@ RooAbsArg* RooWorkspace::fundArg(const char* name) const
 
 RooAbsData* RooWorkspace::data(const char* name) const
 {
-  return (RooAbsData*)_dataList.FindObject(name) ;
+  RooAbsData* ret = (RooAbsData*)_dataList.FindObject(name) ;
+  if (!ret && _indexDir) {
+    ret = loadIndexedData(name, kFALSE) ;
+  }
+  return ret ;
 }
 
 
@@ -1376,7 +1420,11 @@ RooAbsData* RooWorkspace::data(const char* name) const
 
 RooAbsData* RooWorkspace::embeddedData(const char* name) const
 {
-  return (RooAbsData*)_embeddedDataList.FindObject(name) ;
+  RooAbsData* ret = (RooAbsData*)_embeddedDataList.FindObject(name) ;
+  if (!ret && _indexDir) {
+    ret = loadIndexedData(name, kTRUE) ;
+  }
+  return ret ;
 }
 
 
@@ -1387,6 +1435,8 @@ RooAbsData* RooWorkspace::embeddedData(const char* name) const
 
 RooArgSet RooWorkspace::allVars() const
 {
+  loadAllIndexed() ;
+
   RooArgSet ret ;
 
   // Split list of components in pdfs, functions and variables
@@ -1408,6 +1458,8 @@ RooArgSet RooWorkspace::allVars() const
 
 RooArgSet RooWorkspace::allCats() const
 {
+  loadAllIndexed() ;
+
   RooArgSet ret ;
 
   // Split list of components in pdfs, functions and variables
@@ -1430,6 +1482,8 @@ RooArgSet RooWorkspace::allCats() const
 
 RooArgSet RooWorkspace::allFunctions() const
 {
+  loadAllIndexed() ;
+
   RooArgSet ret ;
 
   // Split list of components in pdfs, functions and variables
@@ -1453,6 +1507,8 @@ RooArgSet RooWorkspace::allFunctions() const
 
 RooArgSet RooWorkspace::allCatFunctions() const
 {
+  loadAllIndexed() ;
+
   RooArgSet ret ;
 
   // Split list of components in pdfs, functions and variables
@@ -1474,6 +1530,8 @@ RooArgSet RooWorkspace::allCatFunctions() const
 
 RooArgSet RooWorkspace::allResolutionModels() const
 {
+  loadAllIndexed() ;
+
   RooArgSet ret ;
 
   // Split list of components in pdfs, functions and variables
@@ -1495,6 +1553,8 @@ RooArgSet RooWorkspace::allResolutionModels() const
 
 RooArgSet RooWorkspace::allPdfs() const
 {
+  loadAllIndexed() ;
+
   RooArgSet ret ;
 
   // Split list of components in pdfs, functions and variables
@@ -1516,6 +1576,8 @@ RooArgSet RooWorkspace::allPdfs() const
 
 list<RooAbsData*> RooWorkspace::allData() const
 {
+  loadAllIndexed() ;
+
   list<RooAbsData*> ret ;
   TIterator* iter = _dataList.MakeIterator() ;
   RooAbsData* dat ;
@@ -1532,6 +1594,8 @@ list<RooAbsData*> RooWorkspace::allData() const
 
 list<RooAbsData*> RooWorkspace::allEmbeddedData() const
 {
+  loadAllIndexed() ;
+
   list<RooAbsData*> ret ;
   TIterator* iter = _embeddedDataList.MakeIterator() ;
   RooAbsData* dat ;
@@ -2160,6 +2224,372 @@ Bool_t RooWorkspace::writeToFile(const char* fileName, Bool_t recreate)
 
 
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Replace the elements of a set by the objects that `lookup` returns for their
+/// names, or by clones of them if the set owns its elements. Elements for which
+/// `lookup` returns null are kept.
+
+template<class Lookup>
+void replaceByName(RooArgSet& set, Lookup lookup)
+{
+  const std::vector<RooAbsArg*> elements(set.begin(), set.end()) ;
+  for (const auto elem : elements) {
+    RooAbsArg* replacement = lookup(elem->GetName()) ;
+    if (!replacement || replacement == elem) continue ;
+    if (set.isOwning()) {
+      // Owning sets cannot replace elements, hand over ownership temporarily
+      set.releaseOwnership() ;
+      set.replace(*elem, *static_cast<RooAbsArg*>(replacement->clone(replacement->GetName()))) ;
+      set.takeOwnership() ;
+      delete elem ;
+    } else {
+      set.replace(*elem, *replacement) ;
+    }
+  }
+}
+
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the normalization sets that the given component keeps outside of its
+/// proxies. Their observables are not connected by redirectServers(), so the
+/// indexed persistence replaces them by name.
+
+std::vector<RooArgSet*> RooWorkspace::normSetsOutsideProxies(RooAbsArg& node)
+{
+  std::vector<RooArgSet*> nsets ;
+  if (auto prod = dynamic_cast<RooProdPdf*>(&node)) {
+    RooFIter niter = prod->_pdfNSetList.fwdIterator() ;
+    RooArgSet* nset ;
+    while ((nset = (RooArgSet*)niter.next())) {
+      nsets.push_back(nset) ;
+    }
+    nsets.push_back(&prod->_defNormSet) ;
+  }
+  return nsets ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Save this workspace into the given file such that it can be opened with openIndexed().
+/// A directory with the name of the workspace is created in the file. Each component and
+/// each dataset is written to it under its own key, so that it can be read separately
+/// from the rest of the workspace. The servers of a component are not written along with
+/// it, only their names are, so every component is stored only once.
+/// Named sets, snapshots, generic objects and the class code repository are written
+/// together with the (otherwise empty) workspace object.
+/// \return kTRUE in case of errors
+
+Bool_t RooWorkspace::writeIndexedToFile(const char* fileName, Bool_t recreate)
+{
+  loadAllIndexed() ;
+
+  TFile f(fileName,recreate?"RECREATE":"UPDATE") ;
+  if (f.IsZombie()) {
+    coutE(InputArguments) << "RooWorkspace::writeIndexedToFile(" << GetName() << ") ERROR opening file " << fileName << endl ;
+    return kTRUE ;
+  }
+  if (f.GetKey(GetName())) {
+    coutE(InputArguments) << "RooWorkspace::writeIndexedToFile(" << GetName() << ") ERROR file " << fileName
+			  << " already contains an object named " << GetName() << endl ;
+    return kTRUE ;
+  }
+
+  TDirectory* wsDir = f.mkdir(GetName(),GetTitle()) ;
+  TDirectory* compDir = wsDir->mkdir("components") ;
+
+  // Detach all clients while writing, such that references to components that a class keeps
+  // outside of its proxies do not drag the graph above that component into the written key.
+  // The workspace streamer does the same for clients outside of the workspace.
+  struct ClientLists {
+    RooAbsArg::RefCountList_t clients, valueClients, shapeClients ;
+  } ;
+  std::vector<ClientLists> savedClients(_allOwnedNodes.size()) ;
+  std::size_t iNode = 0 ;
+  for (const auto node : _allOwnedNodes) {
+    std::swap(node->_clientList, savedClients[iNode].clients) ;
+    std::swap(node->_clientListValue, savedClients[iNode].valueClients) ;
+    std::swap(node->_clientListShape, savedClients[iNode].shapeClients) ;
+    ++iNode ;
+  }
+
+  // Placeholders that only carry the names of the components. Components are written connected
+  // to these instead of their servers, and normalization sets kept outside of proxies hold copies
+  // of them, so no copies of the actual leaves are written either.
+  // The placeholders must outlive the copies that are connected to them.
+  RooArgSet placeholders ;
+  placeholders.useHashMapForFind(true) ;
+  for (const auto node : _allOwnedNodes) {
+    if (dynamic_cast<RooAbsCategory*>(node)) {
+      placeholders.addOwned(*new RooCategory(node->GetName(), node->GetTitle())) ;
+    } else {
+      placeholders.addOwned(*new RooRealVar(node->GetName(), node->GetTitle(), 0.)) ;
+    }
+  }
+
+  for (const auto node : _allOwnedNodes) {
+    if (node->servers().empty()) {
+      compDir->WriteTObject(node, node->GetName()) ;
+      continue ;
+    }
+
+    std::unique_ptr<RooAbsArg> clone(static_cast<RooAbsArg*>(node->clone(node->GetName()))) ;
+    clone->redirectServers(placeholders, kTRUE) ;
+    for (const auto nset : normSetsOutsideProxies(*clone)) {
+      replaceByName(*nset, [&](const char* obsName) { return placeholders.find(obsName) ; }) ;
+    }
+    compDir->WriteTObject(clone.get(), node->GetName()) ;
+  }
+
+  iNode = 0 ;
+  for (const auto node : _allOwnedNodes) {
+    std::swap(node->_clientList, savedClients[iNode].clients) ;
+    std::swap(node->_clientListValue, savedClients[iNode].valueClients) ;
+    std::swap(node->_clientListShape, savedClients[iNode].shapeClients) ;
+    ++iNode ;
+  }
+  RooAbsArg::invalidateValueClientClosures() ;
+
+  TObject* obj ;
+  TDirectory* dataDir = wsDir->mkdir("data") ;
+  std::unique_ptr<TIterator> iter(_dataList.MakeIterator()) ;
+  while ((obj = iter->Next())) {
+    dataDir->WriteTObject(obj, obj->GetName()) ;
+  }
+  TDirectory* embeddedDataDir = wsDir->mkdir("embeddedData") ;
+  iter.reset(_embeddedDataList.MakeIterator()) ;
+  while ((obj = iter->Next())) {
+    embeddedDataDir->WriteTObject(obj, obj->GetName()) ;
+  }
+
+  // Named sets are stored as lists of names, and filled when the workspace is opened
+  TList sets ;
+  sets.SetOwner() ;
+  for (const auto& namedSet : _namedSets) {
+    std::string contents ;
+    for (const auto setArg : namedSet.second) {
+      if (!contents.empty()) contents += "," ;
+      contents += setArg->GetName() ;
+    }
+    sets.Add(new TNamed(namedSet.first.c_str(), contents.c_str())) ;
+  }
+  wsDir->WriteTObject(&sets, "sets", "SingleKey") ;
+
+  // Everything else goes with the workspace object itself
+  RooWorkspace skeleton(GetName(), GetTitle()) ;
+  skeleton._uuid = _uuid ;
+  skeleton._classes = CodeRepo(_classes, &skeleton) ;
+  iter.reset(_snapshots.MakeIterator()) ;
+  while ((obj = iter->Next())) {
+    auto snap = static_cast<RooArgSet*>(obj) ;
+    RooArgSet* snapClone = (RooArgSet*) snap->snapshot() ;
+    snapClone->setName(snap->GetName()) ;
+    skeleton._snapshots.Add(snapClone) ;
+  }
+  iter.reset(_genObjects.MakeIterator()) ;
+  while ((obj = iter->Next())) {
+    TObject* theClone = obj->Clone() ;
+    auto handle = dynamic_cast<RooWorkspaceHandle*>(theClone) ;
+    if (handle) {
+      handle->ReplaceWS(&skeleton) ;
+    }
+    skeleton._genObjects.Add(theClone) ;
+  }
+  wsDir->WriteTObject(&skeleton, GetName()) ;
+
+  return kFALSE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Open a workspace that was written with writeIndexedToFile(). Only the index of its
+/// components and datasets is read, together with named sets, snapshots, generic objects
+/// and the class code repository. Components and datasets are read from the file when they
+/// are first accessed, see the class documentation. The file stays open as long as the
+/// workspace exists.
+/// \param[in] fileName Name of the file to read from.
+/// \param[in] name Name of the workspace.
+/// \return New workspace that is owned by the caller, or a null pointer in case of errors.
+
+RooWorkspace* RooWorkspace::openIndexed(const char* fileName, const char* name)
+{
+  std::unique_ptr<TFile> file(TFile::Open(fileName)) ;
+  if (!file || file->IsZombie()) {
+    oocoutE((TObject*)0,InputArguments) << "RooWorkspace::openIndexed(" << name << ") ERROR opening file " << fileName << endl ;
+    return nullptr ;
+  }
+
+  TDirectory* wsDir = file->GetDirectory(name) ;
+  RooWorkspace* ws = nullptr ;
+  if (wsDir) {
+    wsDir->GetObject(name, ws) ;
+  }
+  if (!ws) {
+    oocoutE((TObject*)0,InputArguments) << "RooWorkspace::openIndexed(" << name << ") ERROR: file " << fileName
+					 << " does not contain an indexed workspace named " << name << endl ;
+    return nullptr ;
+  }
+
+  ws->_indexFile = std::move(file) ;
+  ws->_indexDir = wsDir ;
+
+  // Named sets only read the components they contain
+  TList* sets = nullptr ;
+  wsDir->GetObject("sets", sets) ;
+  if (sets) {
+    for (auto setObj : *sets) {
+      RooArgSet content ;
+      for (const std::string& token : RooHelpers::tokenise(setObj->GetTitle(), ",", false)) {
+        RooAbsArg* setArg = ws->arg(token.c_str()) ;
+        if (setArg) {
+          content.add(*setArg) ;
+        }
+      }
+      ws->defineSetInternal(setObj->GetName(), content) ;
+    }
+    sets->Delete() ;
+    delete sets ;
+  }
+
+  return ws ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read the component with the given name from the file of an indexed workspace,
+/// together with all its servers that have not been read yet.
+/// \return The component, or a null pointer if the index doesn't have it.
+
+RooAbsArg* RooWorkspace::loadIndexedArg(const char* name) const
+{
+  TDirectory* compDir = _indexDir->GetDirectory("components") ;
+  TKey* key = compDir ? compDir->GetKey(name) : nullptr ;
+  if (!key) {
+    return nullptr ;
+  }
+
+  auto node = dynamic_cast<RooAbsArg*>(key->ReadObj()) ;
+  if (!node) {
+    coutE(ObjectHandling) << "RooWorkspace::loadIndexedArg(" << GetName() << ") ERROR reading component " << name << endl ;
+    return nullptr ;
+  }
+
+  // The servers were written as placeholders that only carry a name. Connect the
+  // component to the components of this workspace with the same names instead.
+  const std::vector<RooAbsArg*> placeholders(node->servers().begin(), node->servers().end()) ;
+  for (const auto placeholder : placeholders) {
+    if (!arg(placeholder->GetName())) {
+      coutE(ObjectHandling) << "RooWorkspace::loadIndexedArg(" << GetName() << ") ERROR server " << placeholder->GetName()
+			    << " of component " << name << " is missing in the workspace" << endl ;
+      delete node ;
+      for (const auto ph : placeholders) {
+        delete ph ;
+      }
+      return nullptr ;
+    }
+  }
+  node->redirectServers(_allOwnedNodes, kTRUE) ;
+  for (const auto placeholder : placeholders) {
+    delete placeholder ;
+  }
+
+  // Normalization sets were written with copies of the placeholders as well. Their
+  // observables are usually not servers, so they may still have to be read.
+  for (const auto nset : normSetsOutsideProxies(*node)) {
+    replaceByName(*nset, [&](const char* obsName) { return arg(obsName) ; }) ;
+  }
+
+  node->ioStreamerPass2() ;
+  RooAbsArg::ioStreamerPass2Finalize() ;
+
+  auto self = const_cast<RooWorkspace*>(this) ;
+  node->setExpensiveObjectCache(self->_eocache) ;
+  node->setWorkspace(*self) ;
+  self->_allOwnedNodes.addOwned(*node) ;
+  if (_dir) {
+    _dir->InternalAppend(node) ;
+  }
+  if (_doExport) {
+    self->exportObj(node) ;
+  }
+
+  return node ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read the dataset with the given name from the file of an indexed workspace.
+/// \return The dataset, or a null pointer if the index doesn't have it.
+
+RooAbsData* RooWorkspace::loadIndexedData(const char* name, Bool_t embedded) const
+{
+  TDirectory* dataDir = _indexDir->GetDirectory(embedded ? "embeddedData" : "data") ;
+  TKey* key = dataDir ? dataDir->GetKey(name) : nullptr ;
+  if (!key) {
+    return nullptr ;
+  }
+
+  auto data = dynamic_cast<RooAbsData*>(key->ReadObj()) ;
+  if (!data) {
+    coutE(ObjectHandling) << "RooWorkspace::loadIndexedData(" << GetName() << ") ERROR reading dataset " << name << endl ;
+    return nullptr ;
+  }
+
+  auto self = const_cast<RooWorkspace*>(this) ;
+  (embedded ? self->_embeddedDataList : self->_dataList).Add(data) ;
+  if (_dir) {
+    _dir->InternalAppend(data) ;
+  }
+  if (_doExport) {
+    self->exportObj(data) ;
+  }
+  for (const auto obs : *data->get()) {
+    obs->setExpensiveObjectCache(self->_eocache) ;
+  }
+
+  return data ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read all components and datasets of an indexed workspace that have not been
+/// accessed yet. Does nothing for other workspaces.
+
+void RooWorkspace::loadAllIndexed() const
+{
+  if (!_indexDir) {
+    return ;
+  }
+
+  if (TDirectory* compDir = _indexDir->GetDirectory("components")) {
+    for (auto key : *compDir->GetListOfKeys()) {
+      if (!_allOwnedNodes.find(key->GetName())) {
+        loadIndexedArg(key->GetName()) ;
+      }
+    }
+  }
+  for (Bool_t embedded : {kFALSE, kTRUE}) {
+    TDirectory* dataDir = _indexDir->GetDirectory(embedded ? "embeddedData" : "data") ;
+    if (!dataDir) continue ;
+    const RooLinkedList& dataList = embedded ? _embeddedDataList : _dataList ;
+    for (auto key : *dataDir->GetListOfKeys()) {
+      if (!dataList.FindObject(key->GetName())) {
+        loadIndexedData(key->GetName(), embedded) ;
+      }
+    }
+  }
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return instance to factory tool
 
@@ -2202,6 +2632,8 @@ void RooWorkspace::Print(Option_t* opts) const
      verbose = kTRUE;
   }
 
+  loadAllIndexed() ;
+
   cout << endl << "RooWorkspace(" << GetName() << ") " << GetTitle() << " contents" << endl << endl  ;
 
   RooAbsArg* parg ;
@@ -2621,6 +3053,9 @@ void RooWorkspace::Streamer(TBuffer &R__b)
 
    } else {
 
+     // Components of an indexed workspace that are still in the file need to be written as well
+     loadAllIndexed() ;
+
      // Make lists of external clients of WS objects, and remove those links temporarily
 
      map<RooAbsArg*,vector<RooAbsArg *> > extClients, extValueClients, extShapeClients ;
@@ -2654,6 +3089,7 @@ void RooWorkspace::Streamer(TBuffer &R__b)
 
            bufferVec.insert(bufferVec.end(), refCount, vclient);
            tmparg->_clientListValue.Remove(vclient, true);
+           RooAbsArg::invalidateValueClientClosures();
          }
        }
 
@@ -2689,6 +3125,7 @@ void RooWorkspace::Streamer(TBuffer &R__b)
      for (auto iterx : extValueClients) {
        for (auto client : iterx.second) {
          iterx.first->_clientListValue.Add(client);
+         RooAbsArg::invalidateValueClientClosures();
        }
      }
 
@@ -0,0 +1,111 @@
+// Tests for the evaluation of numeric integrals with implicit multi-threading
+
+#include "RooRealVar.h"
+#include "RooRealProxy.h"
+#include "RooFormulaVar.h"
+#include "RooNumIntConfig.h"
+#include "RooRandom.h"
+#include "RooMsgService.h"
+
+#include "TROOT.h"
+#include "TRandom.h"
+#include "TMath.h"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <cmath>
+#include <memory>
+
+namespace {
+
+/// Gaussian-like integrand that counts how often this instance was evaluated.
+/// Copies start counting from zero.
+class CountingFunc : public RooAbsReal {
+public:
+  CountingFunc(const char* name, RooAbsReal& x, RooAbsReal& s) :
+    RooAbsReal(name, name), _x("x", "x", this, x), _s("s", "s", this, s) {}
+  CountingFunc(const CountingFunc& other, const char* name = nullptr) :
+    RooAbsReal(other, name), _x("x", this, other._x), _s("s", this, other._s) {}
+  TObject* clone(const char* newname) const override { return new CountingFunc(*this, newname); }
+
+  mutable std::atomic<long> _nEval{0};
+
+protected:
+  Double_t evaluate() const override {
+    ++_nEval;
+    return std::exp(-0.5 * _x * _x / (_s * _s)) * (1 + 0.1 * _x);
+  }
+
+private:
+  RooRealProxy _x;
+  RooRealProxy _s;
+};
+
+}
+
+// Integrand points evaluated in threads must give the same integral as sequential evaluation
+TEST(RooRealBinding, ParallelIntegration1D)
+{
+  RooMsgService::instance().setGlobalKillBelow(RooFit::WARNING);
+
+  RooRealVar x("x", "x", -5, 5);
+  RooRealVar s("s", "s", 1., 0.5, 2.);
+  CountingFunc f("f", x, s);
+
+  // Points are only evaluated in threads from 128 points per call. Fix the
+  // number of Romberg steps, so that the last ones evaluate 512 and 1024 points.
+  RooNumIntConfig cfg(*RooAbsReal::defaultIntegratorConfig());
+  cfg.method1D().setLabel("RooIntegrator1D");
+  cfg.getConfigSection("RooIntegrator1D").setRealValue("fixSteps", 12);
+
+  std::unique_ptr<RooAbsReal> serial(f.createIntegral(x, cfg));
+  const double serialVal = serial->getVal();
+  EXPECT_GT(f._nEval, 1024);
+
+  ROOT::EnableImplicitMT(4);
+  std::unique_ptr<RooAbsReal> parallel(f.createIntegral(x, cfg));
+  const long nEvalBefore = f._nEval;
+  EXPECT_DOUBLE_EQ(parallel->getVal(), serialVal);
+  // The large steps are evaluated by copies of the function, not by the original
+  EXPECT_LT(f._nEval - nEvalBefore, 512);
+
+  // Parameters are propagated to the copies evaluating the function in threads
+  s.setVal(1.5);
+  const double parallelVal = parallel->getVal();
+  ROOT::DisableImplicitMT();
+  EXPECT_DOUBLE_EQ(parallelVal, serial->getVal());
+}
+
+TEST(RooMCIntegrator, ParallelIntegration2D)
+{
+  RooMsgService::instance().setGlobalKillBelow(RooFit::WARNING);
+
+  RooRealVar x("x", "x", -5, 5);
+  RooRealVar y("y", "y", -5, 5);
+  RooRealVar s("s", "s", 1., 0.5, 2.);
+  RooFormulaVar f("f", "exp(-0.5*(x*x+y*y)/(s*s))", RooArgList(x, y, s));
+
+  RooNumIntConfig cfg(*RooAbsReal::defaultIntegratorConfig());
+  cfg.method2D().setLabel("RooMCIntegrator");
+  cfg.getConfigSection("RooMCIntegrator").setCatLabel("genType", "PseudoRandom");
+
+  auto integrate = [&](RooAbsReal& integral) {
+    RooRandom::randomGenerator()->SetSeed(1234);
+    integral.setValueDirty();
+    return integral.getVal();
+  };
+
+  std::unique_ptr<RooAbsReal> serial(f.createIntegral(RooArgSet(x, y), cfg));
+  const double serialVal = integrate(*serial);
+  EXPECT_NEAR(serialVal, 2. * TMath::Pi(), 0.01 * 2. * TMath::Pi());
+
+  ROOT::EnableImplicitMT(4);
+  std::unique_ptr<RooAbsReal> parallel(f.createIntegral(RooArgSet(x, y), cfg));
+  EXPECT_DOUBLE_EQ(integrate(*parallel), serialVal);
+
+  s.setVal(1.5);
+  const double parallelVal = integrate(*parallel);
+  ROOT::DisableImplicitMT();
+  EXPECT_DOUBLE_EQ(parallelVal, integrate(*serial));
+}
@@ -2,15 +2,22 @@
 // Author: Stephan Hageboeck, CERN 05/2020
 
 #include "RooRealVar.h"
+#include "RooFormulaVar.h"
+#include "RooProduct.h"
+#include "RooAddition.h"
+#include "RooPolyVar.h"
 #include "RooDataSet.h"
 #include "RooHelpers.h"
 #include "RooGlobalFunc.h"
 
 #include "TTree.h"
 #include "TFile.h"
+#include "TRandom3.h"
 #include "gtest/gtest.h"
 
+#include <cmath>
 #include <memory>
+#include <vector>
 
 // ROOT-6882: Cannot read from ULong64_t branches.
 TEST(RooAbsReal, ReadFromTree)
@@ -48,3 +55,89 @@ TEST(RooAbsReal, ReadFromTree)
   EXPECT_EQ(msgs.find(std::string(a.GetName()) + targetMsg), std::string::npos) << "Expect not to see INFO messages for conversion of double branch to double.";
 }
 
+
+// Value changes of leaves need to reach all clients, also if they are connected
+// through several paths, and also after the structure of the graph has changed.
+TEST(RooAbsReal, DirtyPropagationAfterStructureChange)
+{
+  RooRealVar x("x", "x", 1., -10., 10.);
+  RooRealVar y("y", "y", 3., -10., 10.);
+  RooFormulaVar a("a", "x+1", RooArgList(x));
+  RooFormulaVar b("b", "2*x", RooArgList(x));
+  RooFormulaVar c("c", "a*b", RooArgList(a, b));
+
+  EXPECT_DOUBLE_EQ(c.getVal(), 4.);
+  x.setVal(2.);
+  EXPECT_DOUBLE_EQ(c.getVal(), 12.);
+
+  // Make a depend on y instead of x
+  y.setAttribute("ORIGNAME:x");
+  a.redirectServers(RooArgSet(y), false, true);
+  EXPECT_DOUBLE_EQ(c.getVal(), 16.);
+  y.setVal(5.);
+  EXPECT_DOUBLE_EQ(c.getVal(), 24.);
+  x.setVal(3.);
+  EXPECT_DOUBLE_EQ(c.getVal(), 36.);
+
+  // Clients that don't propagate dirty flags stop the propagation, until they are switched back
+  b.setOperMode(RooAbsArg::AClean);
+  x.setVal(4.);
+  EXPECT_DOUBLE_EQ(c.getVal(), 36.);
+  b.setOperMode(RooAbsArg::Auto);
+  b.setValueDirty();
+  EXPECT_DOUBLE_EQ(c.getVal(), 48.);
+  x.setVal(1.);
+  EXPECT_DOUBLE_EQ(c.getVal(), 12.);
+}
+
+
+/// Evaluate `func` in batches over `data` and compare with getVal() for each event.
+static void checkBatchAgainstGetVal(RooAbsReal& func, RooDataSet& data, RooArgSet& vars)
+{
+  std::unique_ptr<RooArgSet> observables(func.getObservables(data));
+  data.attachBuffers(*observables);
+  auto batch = func.getValBatch(0, data.numEntries(), observables.get());
+  ASSERT_EQ(batch.size(), static_cast<std::size_t>(data.numEntries())) << func.GetName();
+  std::vector<double> values(batch.begin(), batch.end());
+  data.resetBuffers();
+
+  for (int i = 0; i < data.numEntries(); ++i) {
+    vars.assignValueOnly(*data.get(i));
+    const double ref = func.getVal();
+    EXPECT_NEAR(values[i], ref, 1.E-13 * std::max(1., std::abs(ref))) << func.GetName() << " at event " << i;
+  }
+}
+
+/// Batch evaluation of the utility functions, with terms that do and do not
+/// depend on the observables, has to give the same values as getVal().
+TEST(RooAbsReal, BatchEvaluationOfUtilityFunctions)
+{
+  RooRealVar x("x", "x", -5., 5.);
+  RooRealVar y("y", "y", 0.5, 3.);
+  RooRealVar a("a", "a", 1.3);
+  RooRealVar a0("a0", "a0", 0.5);
+  RooRealVar a1("a1", "a1", -1.2);
+  RooRealVar a2("a2", "a2", 0.25);
+
+  RooArgSet vars(x, y);
+  RooDataSet data("data", "data", vars);
+  TRandom3 rng(4711);
+  for (int i = 0; i < 1000; ++i) {
+    x.setVal(rng.Uniform(-5., 5.));
+    y.setVal(rng.Uniform(0.5, 3.));
+    data.add(vars);
+  }
+
+  RooProduct product("product", "product", RooArgList(x, y, a));
+  RooAddition addition("addition", "addition", RooArgList(x, y, a));
+  RooPolyVar poly("poly", "poly", x, RooArgList(a0, a1, a2));
+  RooPolyVar polyLowestOrder("polyLowestOrder", "polyLowestOrder", x, RooArgList(a1, a2), 1);
+  RooFormulaVar formula("formula", "a*sin(x) + y*y - a0", RooArgList(x, y, a, a0));
+  // Composite: batches of the components feed the batches of the outer function
+  RooProduct composite("composite", "composite", RooArgList(formula, addition, poly));
+
+  for (RooAbsReal* func : std::initializer_list<RooAbsReal*>{&product, &addition, &poly, &polyLowestOrder,
+                                                           &formula, &composite}) {
+    checkBatchAgainstGetVal(*func, data, vars);
+  }
+}
@@ -5,7 +5,14 @@
 #include "RooGlobalFunc.h"
 #include "RooRealVar.h"
 #include "RooHelpers.h"
+#include "RooDataSet.h"
+#include "RooHistFunc.h"
+#include "RooHistPdf.h"
+#include "RooRealSumPdf.h"
+#include "RooBinning.h"
 #include "TH1D.h"
+#include "TH2D.h"
+#include "TRandom3.h"
 
 #include "gtest/gtest.h"
 
@@ -22,3 +29,83 @@ TEST(RooDataHist, BinningRangeCheck_8163)
   RooDataHist dataHist("dataHist", "", RooArgList(x), &hist);
   EXPECT_TRUE(hijack.str().empty()) << "Messages issued were: " << hijack.str();
 }
+
+
+/// The batch bin lookup has to find the same bins as weight().
+TEST(RooDataHist, BatchWeights)
+{
+  RooRealVar x("x", "x", 0., 10.);
+  RooRealVar y("y", "y", -1., 1.);
+  const double yEdges[] = {-1., -0.5, -0.2, 0., 0.1, 0.5, 1.};
+  y.setBinning(RooBinning(6, yEdges));
+  x.setBins(20);
+
+  TH2D hist("hist2", "", 20, 0., 10., 6, yEdges);
+  TRandom3 rng(1337);
+  for (int i = 0; i < 2000; ++i)
+    hist.Fill(rng.Uniform(0., 10.), rng.Uniform(-1., 1.), rng.Uniform(0.5, 1.5));
+  RooDataHist dataHist("dataHist2", "", RooArgList(x, y), &hist);
+
+  constexpr std::size_t n = 500;
+  std::vector<double> xVals(n), yVals(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    xVals[i] = rng.Uniform(-1., 11.);
+    yVals[i] = rng.Uniform(-1.2, 1.2);
+  }
+
+  const RooArgSet obs(x, y);
+  for (bool correctForBinSize : {false, true}) {
+    std::vector<double> batch(n);
+    dataHist.weights(batch.data(), n, obs, {RooSpan<const double>(xVals), RooSpan<const double>(yVals)},
+                     correctForBinSize);
+    for (std::size_t i = 0; i < n; ++i) {
+      // setVal() clips to the range, which selects the same bins as the clamping of binNumber()
+      x.setVal(xVals[i]);
+      y.setVal(yVals[i]);
+      EXPECT_EQ(batch[i], dataHist.weight(RooArgSet(x, y), 0, correctForBinSize))
+          << "at x=" << xVals[i] << " y=" << yVals[i];
+    }
+  }
+}
+
+/// A template model evaluated in batches has to give the same values as
+/// event-by-event evaluation.
+TEST(RooDataHist, TemplateModelBatchEvaluation)
+{
+  RooRealVar x("x", "x", 0., 10.);
+  x.setBins(10);
+
+  TH1D h1("h1", "", 10, 0., 10.);
+  TH1D h2("h2", "", 10, 0., 10.);
+  for (int i = 1; i <= 10; ++i) {
+    h1.SetBinContent(i, i);
+    h2.SetBinContent(i, 11 - i);
+  }
+  RooDataHist dh1("dh1", "", x, &h1);
+  RooDataHist dh2("dh2", "", x, &h2);
+  RooHistFunc f1("f1", "", x, dh1);
+  RooHistFunc f2("f2", "", x, dh2);
+  RooHistPdf p1("p1", "", x, dh1);
+  RooRealVar c1("c1", "", 0.3, 0., 1.);
+  RooRealSumPdf sum("sum", "", RooArgList(f1, f2), RooArgList(c1));
+
+  RooDataSet data("data", "", x);
+  for (int i = 0; i < 100; ++i) {
+    x.setVal(0.05 + 0.1 * i);
+    data.add(x);
+  }
+
+  for (RooAbsReal* func : std::initializer_list<RooAbsReal*>{&f1, &p1, &sum}) {
+    std::unique_ptr<RooArgSet> observables(func->getObservables(data));
+    data.attachBuffers(*observables);
+    auto batch = func->getValBatch(0, data.numEntries(), observables.get());
+    ASSERT_EQ(batch.size(), static_cast<std::size_t>(data.numEntries())) << func->GetName();
+
+    std::vector<double> values(batch.begin(), batch.end());
+    data.resetBuffers();
+    for (int i = 0; i < data.numEntries(); ++i) {
+      x.setVal(0.05 + 0.1 * i);
+      EXPECT_DOUBLE_EQ(values[i], func->getVal(x)) << func->GetName() << " at x=" << x.getVal();
+    }
+  }
+}
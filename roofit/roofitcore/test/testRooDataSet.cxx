@@ -2,8 +2,11 @@
 // Authors: Stephan Hageboeck, CERN  04/2020
 
 #include "RooDataSet.h"
+#include "RooAbsDataStore.h"
 #include "RooDataHist.h"
 #include "RooRealVar.h"
+#include "RooCategory.h"
+#include "RooGlobalFunc.h"
 #include "RooHelpers.h"
 
 #include <TFile.h>
@@ -189,3 +192,48 @@ TEST(RooDataSet, IsOnHeap) {
   RooDataSet setStack;
   EXPECT_FALSE(setStack.IsOnHeap());
 }
+
+/// Datasets can be filled from whole columns of values, and adopt columns without copying.
+TEST(RooDataSet, FillFromColumns) {
+  RooRealVar x("x", "x", 0., 10.);
+  RooRealVar w("w", "w", 0., 10.);
+  RooCategory cat("cat", "cat", {{"a", 0}, {"b", 1}});
+
+  const std::vector<double> xValues{1., 2., 3.};
+  const std::vector<double> catValues{0., 1., 1.};
+  const std::vector<double> weights{0.5, 1., 2.};
+
+  RooDataSet data("data", "data", RooArgSet(x, cat, w), RooFit::WeightVar(w));
+  ASSERT_FALSE(data.fillFromColumns(RooArgList(x, cat, w), {xValues, catValues, weights}));
+  EXPECT_EQ(data.numEntries(), 3);
+  EXPECT_DOUBLE_EQ(data.sumEntries(), 3.5);
+  for (int i = 0; i < 3; ++i) {
+    const RooArgSet* row = data.get(i);
+    EXPECT_DOUBLE_EQ(row->getRealValue("x"), xValues[i]);
+    EXPECT_EQ(row->getCatIndex("cat"), catValues[i]);
+    EXPECT_DOUBLE_EQ(data.weight(), weights[i]);
+  }
+
+  {
+    // All columns need to be given
+    RooHelpers::HijackMessageStream hijack(RooFit::ERROR, RooFit::InputArguments);
+    EXPECT_TRUE(data.fillFromColumns(RooArgList(x, cat), {xValues, catValues}));
+    EXPECT_EQ(data.numEntries(), 3);
+  }
+
+  RooDataSet unweighted("unweighted", "unweighted", RooArgSet(x, cat));
+  std::vector<std::vector<double>> columns{xValues, catValues};
+  const double* xStorage = columns[0].data();
+  ASSERT_FALSE(unweighted.adoptColumns(RooArgList(x, cat), std::move(columns)));
+  EXPECT_EQ(unweighted.numEntries(), 3);
+  EXPECT_DOUBLE_EQ(unweighted.sumEntries(), 3.);
+  EXPECT_EQ(unweighted.store()->getBatch(0, 3)[0].data(), xStorage);
+
+  // Appending datasets with the same layout copies whole columns
+  RooDataSet appended("appended", "appended", RooArgSet(x, cat));
+  appended.append(unweighted);
+  appended.append(unweighted);
+  EXPECT_EQ(appended.numEntries(), 6);
+  EXPECT_DOUBLE_EQ(appended.get(4)->getRealValue("x"), 2.);
+  EXPECT_EQ(appended.get(5)->getCatIndex("cat"), 1);
+}
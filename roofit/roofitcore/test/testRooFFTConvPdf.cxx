@@ -0,0 +1,67 @@
+// Tests for the RooFFTConvPdf
+
+#include "RooFFTConvPdf.h"
+#include "RooRealVar.h"
+#include "RooGaussian.h"
+#include "RooHelpers.h"
+
+#include "gtest/gtest.h"
+
+// When only the parameters of one input change, the other input is not sampled again.
+// The result needs to be identical to a convolution that samples both inputs.
+TEST(RooFFTConvPdf, ResampleOnlyChangedInput)
+{
+  RooHelpers::LocalChangeMsgLevel changeMsgLvl(RooFit::WARNING);
+
+  RooRealVar x("x", "x", -10., 10.);
+  RooRealVar y("y", "y", -1., 1.);
+  x.setBins(1000, "cache");
+  y.setBins(5, "cache");
+
+  // pdf1 depends on y, so the cache has one slice for each bin of y
+  RooRealVar sigma("sigma", "sigma", 1., 0.1, 5.);
+  RooGaussian pdf1("pdf1", "pdf1", x, y, sigma);
+  RooRealVar mean("mean", "mean", 0., -1., 1.);
+  RooRealVar res("res", "res", 0.5, 0.1, 5.);
+  RooGaussian pdf2("pdf2", "pdf2", x, mean, res);
+
+  RooFFTConvPdf conv("conv", "conv", x, pdf1, pdf2);
+  conv.setCacheObservables(RooArgSet(y));
+  const RooArgSet nset(x, y);
+
+  int i = 0;
+  auto compareToFreshConvolution = [&]() {
+    RooFFTConvPdf fresh(Form("fresh%d", i++), "fresh", x, pdf1, pdf2);
+    fresh.setCacheObservables(RooArgSet(y));
+    fresh.setBufferStrategy(conv.bufferStrategy());
+    for (double xVal : {-3., -0.7, 0., 1.1, 4.}) {
+      for (double yVal : {-0.8, 0., 0.6}) {
+        x.setVal(xVal);
+        y.setVal(yVal);
+        EXPECT_DOUBLE_EQ(conv.getVal(nset), fresh.getVal(nset)) << "x=" << xVal << " y=" << yVal;
+      }
+    }
+  };
+
+  compareToFreshConvolution();
+  sigma.setVal(1.5);
+  compareToFreshConvolution();
+  res.setVal(0.8);
+  compareToFreshConvolution();
+  mean.setVal(0.3);
+  sigma.setVal(0.7);
+  compareToFreshConvolution();
+
+  // The buffer content matters for wide inputs. Changing how it is filled
+  // needs to discard the stored samplings of both inputs.
+  sigma.setVal(4.);
+  compareToFreshConvolution();
+  x.setVal(8.);
+  y.setVal(0.);
+  const double extendVal = conv.getVal(nset);
+  conv.setBufferStrategy(RooFFTConvPdf::Flat);
+  x.setVal(8.);
+  y.setVal(0.);
+  EXPECT_NE(conv.getVal(nset), extendVal);
+  compareToFreshConvolution();
+}
@@ -0,0 +1,188 @@
+// Tests for the parallel gradient evaluation of RooMinimizer
+
+#include "RooRealVar.h"
+#include "RooCategory.h"
+#include "RooGaussian.h"
+#include "RooPolynomial.h"
+#include "RooSimultaneous.h"
+#include "RooDataSet.h"
+#include "RooAbsReal.h"
+#include "RooMinimizer.h"
+#include "RooGlobalFunc.h"
+#include "RooMsgService.h"
+
+#include "TROOT.h"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace {
+
+// Fit nll twice from the same start values, with and without parallel gradient,
+// and check that both fits converge to the same minimum.
+void checkParallelGradientFit(RooAbsReal& nll, const std::vector<RooRealVar*>& params)
+{
+  std::vector<double> start;
+  for (auto par : params) start.push_back(par->getVal());
+
+  RooMinimizer m(nll);
+  m.setPrintLevel(-1);
+  ASSERT_EQ(m.migrad(), 0);
+  ASSERT_EQ(m.hesse(), 0);
+  std::vector<double> refVal, refErr;
+  for (auto par : params) {
+    refVal.push_back(par->getVal());
+    refErr.push_back(par->getError());
+  }
+
+  for (std::size_t i = 0; i < params.size(); ++i) params[i]->setVal(start[i]);
+
+  RooMinimizer mMT(nll);
+  mMT.setPrintLevel(-1);
+  mMT.setParallelGradient(4);
+  ASSERT_EQ(mMT.migrad(), 0);
+  ASSERT_EQ(mMT.hesse(), 0);
+  for (std::size_t i = 0; i < params.size(); ++i) {
+    EXPECT_NEAR(params[i]->getVal(), refVal[i], 0.01 * refErr[i]) << params[i]->GetName();
+    EXPECT_NEAR(params[i]->getError(), refErr[i], 0.01 * refErr[i]) << params[i]->GetName();
+  }
+}
+
+}
+
+TEST(RooMinimizerMT, ParallelGradient)
+{
+  RooMsgService::instance().setGlobalKillBelow(RooFit::WARNING);
+  ROOT::EnableImplicitMT(4);
+
+  RooRealVar x("x", "x", -10, 10);
+  RooRealVar mean("mean", "mean", 0, -5, 5);
+  RooRealVar sigma("sigma", "sigma", 2, 0.1, 10);
+  RooGaussian gauss("gauss", "gauss", x, mean, sigma);
+
+  std::unique_ptr<RooDataSet> data(gauss.generate(x, 1000));
+  mean.setVal(0.5);
+  sigma.setVal(3.);
+
+  std::unique_ptr<RooAbsReal> nll(gauss.createNLL(*data));
+  checkParallelGradientFit(*nll, {&mean, &sigma});
+
+  ROOT::DisableImplicitMT();
+}
+
+TEST(RooMinimizerMT, ParallelGradientSimultaneous)
+{
+  RooMsgService::instance().setGlobalKillBelow(RooFit::WARNING);
+  ROOT::EnableImplicitMT(4);
+
+  RooRealVar x("x", "x", -10, 10);
+  RooRealVar mean("mean", "mean", 0, -5, 5);
+  RooRealVar sigmaA("sigmaA", "sigmaA", 2, 0.1, 10);
+  RooRealVar sigmaB("sigmaB", "sigmaB", 1, 0.1, 10);
+  RooGaussian gaussA("gaussA", "gaussA", x, mean, sigmaA);
+  RooGaussian gaussB("gaussB", "gaussB", x, mean, sigmaB);
+
+  RooCategory channel("channel", "channel");
+  channel.defineType("A");
+  channel.defineType("B");
+  RooSimultaneous sim("sim", "sim", channel);
+  sim.addPdf(gaussA, "A");
+  sim.addPdf(gaussB, "B");
+
+  std::unique_ptr<RooDataSet> data(sim.generate(RooArgSet(x, channel), 2000));
+  mean.setVal(0.5);
+  sigmaA.setVal(3.);
+  sigmaB.setVal(0.5);
+
+  std::unique_ptr<RooAbsReal> nll(sim.createNLL(*data));
+  checkParallelGradientFit(*nll, {&mean, &sigmaA, &sigmaB});
+
+  ROOT::DisableImplicitMT();
+}
+
+// The clones evaluating the gradient need to see new data of the function
+TEST(RooMinimizerMT, ParallelGradientNewData)
+{
+  RooMsgService::instance().setGlobalKillBelow(RooFit::WARNING);
+  ROOT::EnableImplicitMT(4);
+
+  RooRealVar x("x", "x", -10, 10);
+  RooRealVar mean("mean", "mean", 0, -5, 5);
+  RooRealVar sigma("sigma", "sigma", 2, 0.1, 10);
+  RooGaussian gauss("gauss", "gauss", x, mean, sigma);
+
+  std::unique_ptr<RooDataSet> data(gauss.generate(x, 1000));
+  mean.setVal(1.);
+  std::unique_ptr<RooDataSet> toy(gauss.generate(x, 1000));
+
+  std::unique_ptr<RooAbsReal> nll(gauss.createNLL(*data));
+  RooMinimizer mMT(*nll);
+  mMT.setPrintLevel(-1);
+  mMT.setParallelGradient(4);
+  mean.setVal(0.5);
+  sigma.setVal(3.);
+  ASSERT_EQ(mMT.migrad(), 0);
+
+  nll->setData(*toy);
+  mean.setVal(0.5);
+  sigma.setVal(3.);
+  ASSERT_EQ(mMT.migrad(), 0);
+  ASSERT_EQ(mMT.hesse(), 0);
+  const double meanVal = mean.getVal();
+  const double meanErr = mean.getError();
+  const double sigmaVal = sigma.getVal();
+
+  std::unique_ptr<RooAbsReal> nllToy(gauss.createNLL(*toy));
+  RooMinimizer m(*nllToy);
+  m.setPrintLevel(-1);
+  mean.setVal(0.5);
+  sigma.setVal(3.);
+  ASSERT_EQ(m.migrad(), 0);
+  ASSERT_EQ(m.hesse(), 0);
+  EXPECT_NEAR(meanVal, mean.getVal(), 0.01 * mean.getError());
+  EXPECT_NEAR(meanErr, mean.getError(), 0.01 * mean.getError());
+  EXPECT_NEAR(sigmaVal, sigma.getVal(), 0.01 * sigma.getError());
+
+  ROOT::DisableImplicitMT();
+}
+
+// Points with evaluation errors are evaluated again without the clones,
+// and the result is the same as for a sequential gradient
+TEST(RooMinimizerMT, ParallelGradientEvalErrors)
+{
+  RooMsgService::instance().setGlobalKillBelow(RooFit::FATAL);
+  ROOT::EnableImplicitMT(4);
+
+  // The pdf is negative for x < -1/a1 if a1 > 1
+  RooRealVar x("x", "x", -1, 1);
+  RooRealVar a1("a1", "a1", 0.5, -5, 5);
+  RooPolynomial poly("poly", "poly", x, RooArgList(a1));
+
+  std::unique_ptr<RooDataSet> data(poly.generate(x, 1000));
+  std::unique_ptr<RooAbsReal> nll(poly.createNLL(*data));
+
+  RooMinimizer m(*nll);
+  RooMinimizerFcn serial(nll.get(), &m);
+  RooMinimizerFcn parallel(nll.get(), &m);
+  parallel.SetParallelGradient(4);
+
+  const RooAbsReal::ErrorLoggingMode logMode = RooAbsReal::evalErrorLoggingMode();
+  RooAbsReal::setEvalErrorLoggingMode(RooAbsReal::CollectErrors);
+
+  for (double a1Val : {0.3, 0.4, 1.5, 0.6}) {
+    double grad = 0.;
+    double gradMT = 0.;
+    serial.Gradient(&a1Val, &grad);
+    parallel.Gradient(&a1Val, &gradMT);
+    EXPECT_NEAR(gradMT, grad, 1.E-8 * std::abs(grad)) << "a1=" << a1Val;
+    EXPECT_EQ(RooAbsReal::numEvalErrors(), 0) << "a1=" << a1Val;
+  }
+  EXPECT_GT(serial.GetNumInvalidNLL(), 0);
+  EXPECT_EQ(parallel.GetNumInvalidNLL(), serial.GetNumInvalidNLL());
+
+  RooAbsReal::setEvalErrorLoggingMode(logMode);
+  ROOT::DisableImplicitMT();
+}
@@ -0,0 +1,118 @@
+// Tests for the multi-threaded evaluation of test statistics
+
+#include "RooRealVar.h"
+#include "RooCategory.h"
+#include "RooGaussian.h"
+#include "RooSimultaneous.h"
+#include "RooDataSet.h"
+#include "RooAbsReal.h"
+#include "RooGlobalFunc.h"
+#include "RooMsgService.h"
+#include "RooHelpers.h"
+
+#include "TROOT.h"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <memory>
+
+namespace {
+
+void checkNLLValues(RooAbsPdf& pdf, RooDataSet& data, RooDataSet& otherData, RooRealVar& mean, RooRealVar& sigma,
+                    RooFit::MPSplit strategy)
+{
+  std::unique_ptr<RooAbsReal> nll(pdf.createNLL(data));
+  std::unique_ptr<RooAbsReal> nllMT(pdf.createNLL(data, RooFit::NumCPU(4, strategy | RooFit::Threads)));
+
+  // The partitions are set up on the first evaluation. Make sure they are
+  // evaluated in threads rather than in forked processes.
+  {
+    RooHelpers::HijackMessageStream hijack(RooFit::INFO, RooFit::Eval);
+    nllMT->getVal();
+    EXPECT_NE(hijack.str().find("partitions for evaluation in parallel threads"), std::string::npos)
+        << "strategy=" << strategy;
+  }
+
+  for (double meanVal : {0.1, -0.3, 0.7}) {
+    mean.setVal(meanVal);
+    const double ref = nll->getVal();
+    EXPECT_NEAR(nllMT->getVal(), ref, 1.E-10 * std::abs(ref)) << "mean=" << meanVal << " strategy=" << strategy;
+  }
+
+  // Constant flags and values of the master parameters reach the partitions
+  const double sigmaVal = sigma.getVal();
+  sigma.setConstant(true);
+  sigma.setVal(1.5 * sigmaVal);
+  EXPECT_NEAR(nllMT->getVal(), nll->getVal(), 1.E-10 * std::abs(nll->getVal())) << "strategy=" << strategy;
+  sigma.setConstant(false);
+  sigma.setVal(sigmaVal);
+  EXPECT_NEAR(nllMT->getVal(), nll->getVal(), 1.E-10 * std::abs(nll->getVal())) << "strategy=" << strategy;
+
+  nll->constOptimizeTestStatistic(RooAbsArg::Activate);
+  nllMT->constOptimizeTestStatistic(RooAbsArg::Activate);
+  mean.setVal(0.2);
+  EXPECT_NEAR(nllMT->getVal(), nll->getVal(), 1.E-10 * std::abs(nll->getVal())) << "strategy=" << strategy;
+
+  // New data is forwarded to all partitions
+  const double oldValue = nllMT->getVal();
+  nll->setData(otherData);
+  nllMT->setData(otherData);
+  EXPECT_NE(nllMT->getVal(), oldValue) << "strategy=" << strategy;
+  EXPECT_NEAR(nllMT->getVal(), nll->getVal(), 1.E-10 * std::abs(nll->getVal())) << "strategy=" << strategy;
+  mean.setVal(-0.1);
+  EXPECT_NEAR(nllMT->getVal(), nll->getVal(), 1.E-10 * std::abs(nll->getVal())) << "strategy=" << strategy;
+}
+
+}
+
+TEST(RooNLLVarMT, SameValueAsSequential)
+{
+  RooMsgService::instance().setGlobalKillBelow(RooFit::WARNING);
+  ROOT::EnableImplicitMT(4);
+
+  RooRealVar x("x", "x", -10, 10);
+  RooRealVar mean("mean", "mean", 0, -5, 5);
+  RooRealVar sigma("sigma", "sigma", 2, 0.1, 10);
+  RooGaussian gauss("gauss", "gauss", x, mean, sigma);
+
+  std::unique_ptr<RooDataSet> data(gauss.generate(x, 1000));
+  std::unique_ptr<RooDataSet> otherData(gauss.generate(x, 800));
+
+  checkNLLValues(gauss, *data, *otherData, mean, sigma, RooFit::BulkPartition);
+  checkNLLValues(gauss, *data, *otherData, mean, sigma, RooFit::Interleave);
+
+  ROOT::DisableImplicitMT();
+}
+
+TEST(RooNLLVarMT, SimultaneousComponents)
+{
+  RooMsgService::instance().setGlobalKillBelow(RooFit::WARNING);
+  ROOT::EnableImplicitMT(4);
+
+  RooRealVar x("x", "x", -10, 10);
+  RooRealVar mean("mean", "mean", 0, -5, 5);
+  RooRealVar sigmaA("sigmaA", "sigmaA", 2, 0.1, 10);
+  RooRealVar sigmaB("sigmaB", "sigmaB", 1, 0.1, 10);
+  RooRealVar sigmaC("sigmaC", "sigmaC", 3, 0.1, 10);
+  RooGaussian gaussA("gaussA", "gaussA", x, mean, sigmaA);
+  RooGaussian gaussB("gaussB", "gaussB", x, mean, sigmaB);
+  RooGaussian gaussC("gaussC", "gaussC", x, mean, sigmaC);
+
+  RooCategory channel("channel", "channel");
+  channel.defineType("A");
+  channel.defineType("B");
+  channel.defineType("C");
+  RooSimultaneous sim("sim", "sim", channel);
+  sim.addPdf(gaussA, "A");
+  sim.addPdf(gaussB, "B");
+  sim.addPdf(gaussC, "C");
+
+  std::unique_ptr<RooDataSet> data(sim.generate(RooArgSet(x, channel), 3000));
+  std::unique_ptr<RooDataSet> otherData(sim.generate(RooArgSet(x, channel), 2000));
+
+  checkNLLValues(sim, *data, *otherData, mean, sigmaB, RooFit::BulkPartition);
+  checkNLLValues(sim, *data, *otherData, mean, sigmaB, RooFit::SimComponents);
+
+  ROOT::DisableImplicitMT();
+}
@@ -6,7 +6,10 @@
 #include "RooGaussian.h"
 #include "RooArgList.h"
 #include "RooRealVar.h"
+#include "RooCategory.h"
 #include "RooAbsReal.h"
+#include "RooAbsPdf.h"
+#include "RooDataSet.h"
 #include "RooStats/ModelConfig.h"
 
 #include "TFile.h"
@@ -14,6 +17,8 @@
 
 #include "gtest/gtest.h"
 
+#include <vector>
+
 using namespace RooStats;
 
 /// ROOT-9777, cloning a RooWorkspace. The ModelConfig did not get updated
@@ -231,3 +236,150 @@ TEST_F(TestRooWorkspaceWithGaussian, HashLookupInWorkspace) {
   EXPECT_FALSE(model_constrained_orig->dependsOn(*ws->var("mu2")));
   EXPECT_NE(ws->pdf("Gauss_editPdf_orig"), nullptr);
 }
+
+
+/// Components of an indexed workspace are read on first access, and need to be
+/// connected to the components that were read before.
+TEST(RooWorkspace, OpenIndexed)
+{
+  const char* filename = "testWorkspaceIndexed.root";
+  double modelVal = 0.;
+  {
+    RooWorkspace w("w");
+    w.factory("Gaussian::g1(x[0,-10,10], m1[-1,-5,5], sigma[1,0.1,10])");
+    w.factory("Gaussian::g2(x, m2[2,-5,5], sigma)");
+    w.factory("SUM::model(f[0.3,0,1]*g1, g2)");
+    w.defineSet("poi", "m1,m2");
+    w.saveSnapshot("shifted", "m1,m2");
+    std::unique_ptr<RooDataSet> data(w.pdf("model")->generate(*w.var("x"), 100));
+    data->SetName("data");
+    w.import(*data);
+    w.var("x")->setVal(0.5);
+    modelVal = w.pdf("model")->getVal(*w.var("x"));
+    w.var("m1")->setVal(0.);
+    w.var("m2")->setVal(0.);
+
+    ASSERT_FALSE(w.writeIndexedToFile(filename));
+  }
+
+  std::unique_ptr<RooWorkspace> w(RooWorkspace::openIndexed(filename, "w"));
+  ASSERT_NE(w, nullptr);
+  EXPECT_TRUE(w->isIndexed());
+
+  // Parameters read before the pdfs that use them. A component that was read has
+  // clients only once the components using it are read as well.
+  ASSERT_NE(w->set("poi"), nullptr);
+  EXPECT_EQ(w->set("poi")->getSize(), 2);
+  EXPECT_DOUBLE_EQ(w->var("m1")->getVal(), 0.);
+  EXPECT_FALSE(w->var("m1")->hasClients());
+  EXPECT_TRUE(w->loadSnapshot("shifted"));
+  EXPECT_DOUBLE_EQ(w->var("m1")->getVal(), -1.);
+
+  // Snapshots of parameters that are not read yet
+  RooRealVar fSnap("f", "f", 0.6);
+  EXPECT_TRUE(w->saveSnapshot("fSnap", RooArgSet(fSnap), kTRUE));
+  ASSERT_EQ(w->getSnapshot("fSnap")->getSize(), 1);
+  EXPECT_DOUBLE_EQ(static_cast<RooRealVar*>(w->getSnapshot("fSnap")->find("f"))->getVal(), 0.6);
+  EXPECT_DOUBLE_EQ(w->var("f")->getVal(), 0.3);
+
+  // Read one channel first, the rest of the model later
+  RooAbsPdf* g1 = w->pdf("g1");
+  ASSERT_NE(g1, nullptr);
+  EXPECT_EQ(g1->findServer("m1"), w->var("m1"));
+  EXPECT_FALSE(g1->hasClients());
+  EXPECT_TRUE(w->var("m1")->hasClients());
+  RooAbsPdf* model = w->pdf("model");
+  ASSERT_NE(model, nullptr);
+  EXPECT_TRUE(model->dependsOn(*g1));
+  EXPECT_EQ(w->pdf("g2")->findServer("sigma"), g1->findServer("sigma"));
+
+  RooRealVar* x = w->var("x");
+  x->setVal(0.5);
+  EXPECT_DOUBLE_EQ(model->getVal(*x), modelVal);
+
+  // Dirty state needs to propagate across components that were read separately
+  w->var("sigma")->setVal(2.);
+  EXPECT_NE(model->getVal(*x), modelVal);
+  w->var("sigma")->setVal(1.);
+  EXPECT_DOUBLE_EQ(model->getVal(*x), modelVal);
+
+  EXPECT_TRUE(w->loadSnapshot("fSnap"));
+  EXPECT_NE(model->getVal(*x), modelVal);
+  w->var("f")->setVal(0.3);
+  EXPECT_DOUBLE_EQ(model->getVal(*x), modelVal);
+
+  // The dataset is only read now
+  const Long64_t bytesRead = TFile::GetFileBytesRead();
+  RooAbsData* data = w->data("data");
+  ASSERT_NE(data, nullptr);
+  EXPECT_GT(TFile::GetFileBytesRead(), bytesRead);
+  EXPECT_EQ(data->numEntries(), 100);
+  EXPECT_EQ(w->data("nonexistent"), nullptr);
+  EXPECT_EQ(w->components().getSize(), 8);
+
+  w.reset();
+  gSystem->Unlink(filename);
+}
+
+
+/// Products with conditional terms keep observables outside of their proxies. After reading,
+/// these need to be the observables of the workspace, and the model needs to give the same values.
+TEST(RooWorkspace, OpenIndexedProdSimultaneous)
+{
+  const char* filename = "testWorkspaceIndexedSim.root";
+
+  auto evaluate = [](RooWorkspace& ws) {
+    RooArgSet obs(*ws.var("x"), *ws.var("y"), *ws.cat("channel"));
+    std::vector<double> values;
+    for (const char* channel : {"A", "B"}) {
+      for (double xVal : {-1., 0.5}) {
+        for (double yVal : {-2., 1.}) {
+          ws.cat("channel")->setLabel(channel);
+          ws.var("x")->setVal(xVal);
+          ws.var("y")->setVal(yVal);
+          values.push_back(ws.pdf("sim")->getVal(obs));
+        }
+      }
+    }
+    return values;
+  };
+
+  std::vector<double> refValues;
+  {
+    RooWorkspace w("w");
+    w.factory("Gaussian::px(x[0,-10,10], mx[0.5,-5,5], sx[1,0.1,10])");
+    w.factory("Gaussian::py(y[0,-10,10], x, sy[2,0.1,10])");
+    w.factory("PROD::prodA(px, py|x)");
+    w.factory("Gaussian::gB(x, mB[-1,-5,5], sx)");
+    w.factory("Uniform::uy(y)");
+    w.factory("PROD::prodB(gB, uy)");
+    w.factory("SIMUL::sim(channel[A,B], A=prodA, B=prodB)");
+    refValues = evaluate(w);
+
+    ASSERT_FALSE(w.writeIndexedToFile(filename));
+  }
+
+  std::unique_ptr<RooWorkspace> w(RooWorkspace::openIndexed(filename, "w"));
+  ASSERT_NE(w, nullptr);
+
+  RooAbsPdf* prodA = w->pdf("prodA");
+  ASSERT_NE(prodA, nullptr);
+  EXPECT_FALSE(prodA->hasClients());
+
+  const std::vector<double> values = evaluate(*w);
+  ASSERT_EQ(values.size(), refValues.size());
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    EXPECT_DOUBLE_EQ(values[i], refValues[i]) << "point " << i;
+  }
+  EXPECT_TRUE(prodA->hasClients());
+
+  // Parameters shared by the channels are read only once
+  EXPECT_EQ(w->pdf("gB")->findServer("sx"), w->pdf("px")->findServer("sx"));
+  w->var("sx")->setVal(2.);
+  const std::vector<double> changed = evaluate(*w);
+  EXPECT_NE(changed[0], refValues[0]);
+  EXPECT_NE(changed[4], refValues[4]);
+
+  w.reset();
+  gSystem->Unlink(filename);
+}
@@ -234,6 +234,11 @@ class ToyMCSampler: public TestStatSampler {
       // calling with argument or NULL deactivates proof
       void SetProofConfig(ProofConfig *pc = NULL) { fProofConfig = pc; }
 
+      // Generate and evaluate the toys in nCPU forked worker processes when no ProofConfig is given.
+      // Each worker runs with its own random seed, drawn from RooRandom::randomGenerator().
+      void SetNumCPU(Int_t nCPU = 1) { fNumCPU = nCPU; }
+      Int_t GetNumCPU() const { return fNumCPU; }
+
       void SetProtoData(const RooDataSet* d) { fProtoData = d; }
 
    protected:
@@ -243,6 +248,9 @@ class ToyMCSampler: public TestStatSampler {
       // helper for GenerateToyData
       RooAbsData* Generate(RooAbsPdf &pdf, RooArgSet &observables, const RooDataSet *protoData=NULL, int forceEvents=0) const;
 
+      // run GetSamplingDistributionsSingleWorker in fNumCPU forked processes and merge the results
+      RooDataSet* GetSamplingDistributionsMultiProcess(RooArgSet& paramPoint);
+
       // helper method for clearing  the cache
       virtual void ClearCache();
 
@@ -279,6 +287,7 @@ class ToyMCSampler: public TestStatSampler {
       const RooDataSet *fProtoData; // in dev
 
       ProofConfig *fProofConfig;   //!
+      Int_t fNumCPU; // number of worker processes for parallel runs without PROOF
 
       mutable NuisanceParametersSampler *fNuisanceParametersSampler; //!
 
@@ -296,7 +305,7 @@ class ToyMCSampler: public TestStatSampler {
       Bool_t fUseMultiGen ; // Use PrepareMultiGen?
 
    protected:
-   ClassDef(ToyMCSampler,3) // A simple implementation of the TestStatSampler interface
+   ClassDef(ToyMCSampler,4) // A simple implementation of the TestStatSampler interface
 };
 }
 
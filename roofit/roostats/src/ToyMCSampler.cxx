@@ -27,6 +27,18 @@ TestStatistic.
 For parallel runs, ToyMCSampler can be given an instance of ProofConfig
 and then run in parallel using proof or proof-lite. Internally, it uses
 ToyMCStudy with the RooStudyManager.
+
+Without PROOF, the toys can be distributed over several forked worker processes
+with SetNumCPU(). Each worker generates and evaluates its share of the toys with
+its own random seed, which is drawn from RooRandom::randomGenerator() before the
+workers are started. Results are therefore reproducible for a given seed and
+number of workers. The sampling distributions of all workers are merged in the
+order of the workers. Calculators using the ToyMCSampler, like the
+FrequentistCalculator or the HypoTestInverter, use the parallel mode transparently:
+~~~ {.cpp}
+ToyMCSampler *sampler = (ToyMCSampler*)calculator.GetTestStatSampler();
+sampler->SetNumCPU(8);
+~~~
 */
 
 #include "RooStats/ToyMCSampler.h"
@@ -50,6 +62,13 @@ ToyMCStudy with the RooStudyManager.
 
 #include "TMath.h"
 
+#ifndef _MSC_VER
+#include "ROOT/TProcessExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#endif
+
+#include <algorithm>
+
 
 using namespace RooFit;
 using namespace std;
@@ -175,6 +194,7 @@ ToyMCSampler::ToyMCSampler() : fSamplingDistName("SD"), fNToys(1)
    fProtoData = NULL;
 
    fProofConfig = NULL;
+   fNumCPU = 1;
    fNuisanceParametersSampler = NULL;
 
    _allVars = NULL ;
@@ -215,6 +235,7 @@ ToyMCSampler::ToyMCSampler(TestStatistic &ts, Int_t ntoys) : fSamplingDistName(t
    fProtoData = NULL;
 
    fProofConfig = NULL;
+   fNumCPU = 1;
    fNuisanceParametersSampler = NULL;
 
    _allVars = NULL ;
@@ -326,8 +347,11 @@ RooDataSet* ToyMCSampler::GetSamplingDistributions(RooArgSet& paramPointIn)
 {
 
    // ======= S I N G L E   R U N ? =======
-   if(!fProofConfig)
+   if(!fProofConfig) {
+      if (fNumCPU > 1)
+         return GetSamplingDistributionsMultiProcess(paramPointIn);
       return GetSamplingDistributionsSingleWorker(paramPointIn);
+   }
 
    // ======= P A R A L L E L   R U N =======
    if (!CheckConfig()){
@@ -369,6 +393,82 @@ RooDataSet* ToyMCSampler::GetSamplingDistributions(RooArgSet& paramPointIn)
    return output;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Distribute the toys over fNumCPU forked worker processes. Each worker runs
+/// GetSamplingDistributionsSingleWorker() for its share of the toys with a
+/// random seed that was drawn here, and the resulting data sets are merged in
+/// the order of the workers. For adaptive sampling, the requested number of
+/// toys in the tails and the maximum number of toys are divided between the workers.
+
+RooDataSet* ToyMCSampler::GetSamplingDistributionsMultiProcess(RooArgSet& paramPointIn)
+{
+#ifdef _MSC_VER
+   oocoutW((TObject*)NULL, InputArguments)
+      << "ToyMCSampler: parallel toys without PROOF are not supported on this platform. Running serially."
+      << endl;
+   return GetSamplingDistributionsSingleWorker(paramPointIn);
+#else
+   if (!CheckConfig()){
+      oocoutE((TObject*)NULL, InputArguments)
+         << "Bad COnfiguration in ToyMCSampler "
+         << endl;
+      return nullptr;
+   }
+
+   const unsigned int nWorkers = fNumCPU;
+   const Int_t nToys = fNToys;
+   const Double_t toysInTails = fToysInTails;
+   const Double_t maxToys = fMaxToys;
+   std::vector<UInt_t> seeds(nWorkers);
+   for (auto& seed : seeds)
+      seed = RooRandom::randomGenerator()->Integer(TMath::Limits<unsigned int>::Max());
+
+   oocoutP((TObject*)NULL, Generation) << "ToyMCSampler: generating " << fNToys << " toys in "
+      << nWorkers << " worker processes" << endl;
+
+   // Runs in the forked worker process, so the sampler can be reconfigured freely
+   auto work = [&](unsigned int i) {
+      RooRandom::randomGenerator()->SetSeed(seeds[i]);
+
+      fNToys = nToys / nWorkers + (i < nToys % nWorkers ? 1 : 0);
+      fToysInTails = ceil(toysInTails / nWorkers);
+      fMaxToys = ceil(maxToys / nWorkers);
+
+      // nuisance parameter points are drawn with the seed of this worker
+      delete fNuisanceParametersSampler;
+      fNuisanceParametersSampler = NULL;
+
+      RooDataSet* result = GetSamplingDistributionsSingleWorker(paramPointIn);
+      if (result) result->SetUniqueID(i);
+      return result;
+   };
+
+   ROOT::TProcessExecutor workers(nWorkers);
+   std::vector<RooDataSet*> results = workers.Map(work, ROOT::TSeqU(nWorkers));
+
+   // results arrive in the order in which the workers finished
+   results.erase(std::remove(results.begin(), results.end(), nullptr), results.end());
+   std::sort(results.begin(), results.end(), [](const RooDataSet* a, const RooDataSet* b){
+      return a->GetUniqueID() < b->GetUniqueID();
+   });
+
+   if (results.size() != nWorkers) {
+      oocoutW((TObject*)NULL, Generation) << "ToyMCSampler: only " << results.size() << " out of "
+         << nWorkers << " workers returned a sampling distribution" << endl;
+   }
+   if (results.empty()) return nullptr;
+
+   RooDataSet* output = results.front();
+   output->SetUniqueID(0);
+   for (std::size_t i = 1; i < results.size(); ++i) {
+      output->append(*results[i]);
+      delete results[i];
+   }
+
+   return output;
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// This is the main function for serial runs. It is called automatically
 /// from inside GetSamplingDistribution when no ProofConfig is given.
@@ -0,0 +1,67 @@
+// Tests for the ToyMCSampler
+
+#include "RooStats/ToyMCSampler.h"
+#include "RooStats/MaxLikelihoodEstimateTestStat.h"
+#include "RooStats/SamplingDistribution.h"
+
+#include "RooRealVar.h"
+#include "RooGaussian.h"
+#include "RooRandom.h"
+#include "RooHelpers.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+
+namespace {
+
+std::unique_ptr<RooDataSet> runToys(RooStats::ToyMCSampler &sampler, RooArgSet &poi, int nCPU)
+{
+   RooRandom::randomGenerator()->SetSeed(1234);
+   sampler.SetNumCPU(nCPU);
+   std::unique_ptr<RooArgSet> point{poi.snapshot()};
+   return std::unique_ptr<RooDataSet>{sampler.GetSamplingDistributions(*point)};
+}
+
+}
+
+// Toys distributed over several worker processes: all toys need to be there, and
+// the results need to be reproducible for a given seed.
+TEST(ToyMCSampler, MultiProcess)
+{
+   RooHelpers::LocalChangeMsgLevel changeMsgLvl(RooFit::WARNING);
+
+   RooRealVar x("x", "x", -10., 10.);
+   RooRealVar mu("mu", "mu", 0., -5., 5.);
+   RooRealVar sigma("sigma", "sigma", 1.);
+   RooGaussian gauss("gauss", "gauss", x, mu, sigma);
+
+   RooStats::MaxLikelihoodEstimateTestStat testStat(gauss, mu);
+   RooStats::ToyMCSampler sampler(testStat, 21);
+   sampler.SetPdf(gauss);
+   sampler.SetObservables(RooArgSet(x));
+   sampler.SetParametersForTestStat(RooArgSet(mu));
+   sampler.SetNEventsPerToy(20);
+
+   RooArgSet poi(mu);
+   auto serial = runToys(sampler, poi, 1);
+   auto parallel = runToys(sampler, poi, 4);
+   auto parallelAgain = runToys(sampler, poi, 4);
+
+   ASSERT_NE(serial, nullptr);
+   ASSERT_NE(parallel, nullptr);
+   ASSERT_NE(parallelAgain, nullptr);
+   EXPECT_EQ(serial->numEntries(), 21);
+   EXPECT_EQ(parallel->numEntries(), 21);
+   ASSERT_EQ(parallelAgain->numEntries(), 21);
+   EXPECT_EQ(sampler.GetNToys(), 21);
+
+   RooStats::SamplingDistribution samplingDist("dist", "dist", *parallel);
+   EXPECT_NEAR(samplingDist.InverseCDF(0.5), 0., 0.2);
+
+   for (int i = 0; i < parallel->numEntries(); ++i) {
+      const double value = static_cast<RooRealVar *>(parallel->get(i)->first())->getVal();
+      const double valueAgain = static_cast<RooRealVar *>(parallelAgain->get(i)->first())->getVal();
+      EXPECT_EQ(value, valueAgain) << "toy " << i;
+   }
+}